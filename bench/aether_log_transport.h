@@ -0,0 +1,87 @@
+#pragma once
+
+#include "transport.h"
+#include "bench_common.h"
+
+#include "aether/subscribe.h"
+#include "aether/publish.h"
+#include "aether/consume.h"
+
+#include <csignal>
+#include <sys/wait.h>
+
+// ---------------------------------------------------------------------------
+// AetherLogTransport — BenchTransport adapter for the term-log layout
+//
+// Same lifecycle as AetherTransport, but the topic is created as a term log
+// (subscribe_log) and the subscriber tracks a byte position, not a sequence.
+// ---------------------------------------------------------------------------
+
+class AetherLogTransport {
+public:
+    explicit AetherLogTransport(const char* topic, uint32_t topic_len,
+                             aether::IdleStrategy idle = aether::IdleStrategy::busy_spin(),
+                             const char* daemon_config = nullptr)
+        : topic_(topic), topic_len_(topic_len), idle_(idle), daemon_config_(daemon_config) {}
+
+    void setup() {
+        daemon_pid_ = start_daemon(daemon_config_);
+        sub_        = aether::subscribe_log(topic_, topic_len_);
+        position_   = 0;
+    }
+
+    bool publish(const void* data, size_t len) {
+        return aether::publish(sub_.hdr, data, static_cast<uint32_t>(len)) == aether::PublishResult::Ok;
+    }
+
+    ConsumeStatus consume(void* buf, size_t& len) {
+        uint32_t buf_len = static_cast<uint32_t>(len);
+        const auto result = aether::consume(sub_.hdr, buf, buf_len, position_);
+        len = buf_len;  // write back actual bytes received
+        switch (result) {
+            case aether::ConsumeResult::Ok:     return ConsumeStatus::Ok;
+            case aether::ConsumeResult::Empty:  return ConsumeStatus::Empty;
+            case aether::ConsumeResult::Lapped: return ConsumeStatus::Lapped;
+            case aether::ConsumeResult::Torn:   return ConsumeStatus::Lapped;
+            case aether::ConsumeResult::TooLarge:    // harness buffers hold every message
+            case aether::ConsumeResult::Superseded: break;
+        }
+        __builtin_unreachable();
+    }
+
+    // The term log has no batch API — loop over consume().
+    PollStatus poll(size_t max_messages) {
+        PollStatus st{};
+        uint8_t buf[aether::log_max_payload(aether::LOG_DEFAULT_TERM_LENGTH)];
+        while (st.received < max_messages) {
+            uint32_t buf_len = sizeof(buf);
+            const auto result = aether::consume(sub_.hdr, buf, buf_len, position_);
+            if (result == aether::ConsumeResult::Ok)          ++st.received;
+            else if (result == aether::ConsumeResult::Lapped) ++st.lapped;
+            else break;
+        }
+        return st;
+    }
+
+    void idle(size_t work_count) {
+        idle_.idle(static_cast<uint32_t>(work_count), sub_.hdr, position_);
+    }
+
+    void teardown() {
+        aether::unsubscribe(sub_);
+        kill(daemon_pid_, SIGTERM);
+        waitpid(daemon_pid_, nullptr, 0);
+    }
+
+private:
+    const char*             topic_;
+    uint32_t                topic_len_;
+    aether::LogSubscription sub_{};
+    uint64_t                position_ = 0;
+    aether::IdleStrategy    idle_;
+    const char*             daemon_config_;
+    pid_t                   daemon_pid_ = -1;
+};
+
+static_assert(BenchTransport<AetherLogTransport>,
+    "AetherLogTransport does not satisfy BenchTransport concept");
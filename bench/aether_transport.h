@@ -6,8 +6,10 @@
 #include "aether/subscribe.h"
 #include "aether/publish.h"
 #include "aether/consume.h"
+#include "aether/hot_path.h"
 
 #include <csignal>
+#include <cstring>  // memcpy
 #include <sys/wait.h>
 
 // ---------------------------------------------------------------------------
@@ -15,35 +17,59 @@
 //
 // Wraps aether::subscribe / publish / consume behind the harness interface.
 // Owns the daemon lifecycle: setup() starts aetherd, teardown() kills it.
+// With Inline = true the data path goes through the header-only
+// aether::hot functions instead of libaether (see AetherInlineTransport).
 // ---------------------------------------------------------------------------
 
-class AetherTransport {
+template <bool Inline>
+class BasicAetherTransport {
 public:
-    explicit AetherTransport(const char* topic, uint32_t topic_len)
-        : topic_(topic), topic_len_(topic_len) {}
+    explicit BasicAetherTransport(const char* topic, uint32_t topic_len,
+                          aether::IdleStrategy idle = aether::IdleStrategy::busy_spin(),
+                          const char* daemon_config = nullptr)
+        : topic_(topic), topic_len_(topic_len), idle_(idle), daemon_config_(daemon_config) {}
 
     void setup() {
-        daemon_pid_ = start_daemon();
+        daemon_pid_ = start_daemon(daemon_config_);
         sub_        = aether::subscribe(topic_, topic_len_);
         read_seq_   = 1;
     }
 
     bool publish(const void* data, size_t len) {
-        return aether::publish(sub_.hdr, data, static_cast<uint32_t>(len));
+        const auto n = static_cast<uint32_t>(len);
+        const auto result = Inline ? aether::hot::publish(sub_.hdr, data, n)
+                                   : aether::publish(sub_.hdr, data, n);
+        return result == aether::PublishResult::Ok;
     }
 
     ConsumeStatus consume(void* buf, size_t& len) {
         uint32_t buf_len = static_cast<uint32_t>(len);
-        const auto result = aether::consume(sub_.hdr, buf, buf_len, read_seq_);
+        const auto result = Inline ? aether::hot::consume(sub_.hdr, buf, buf_len, read_seq_)
+                                   : aether::consume(sub_.hdr, buf, buf_len, read_seq_);
         len = buf_len;  // write back actual bytes received
         switch (result) {
             case aether::ConsumeResult::Ok:     return ConsumeStatus::Ok;
             case aether::ConsumeResult::Empty:  return ConsumeStatus::Empty;
             case aether::ConsumeResult::Lapped: return ConsumeStatus::Lapped;
+            case aether::ConsumeResult::Torn:   return ConsumeStatus::Lapped;
+            case aether::ConsumeResult::TooLarge:    // harness messages fit one slot
+            case aether::ConsumeResult::Superseded: break;  // the harness never resizes
         }
         __builtin_unreachable();
     }
 
+    PollStatus poll(size_t max_messages) {
+        auto ignore = [](const aether::MessageView&) {};
+        const auto max = static_cast<uint32_t>(max_messages);
+        const auto r = Inline ? aether::hot::poll(sub_.hdr, read_seq_, ignore, max)
+                              : aether::poll(sub_.hdr, read_seq_, ignore, max);
+        return PollStatus{r.delivered, r.lapped};
+    }
+
+    void idle(size_t work_count) {
+        idle_.idle(static_cast<uint32_t>(work_count), sub_.hdr, read_seq_);
+    }
+
     void teardown() {
         aether::unsubscribe(sub_);
         kill(daemon_pid_, SIGTERM);
@@ -55,8 +81,90 @@ private:
     uint32_t           topic_len_;
     aether::Subscription sub_{};
     uint64_t           read_seq_ = 1;
+    aether::IdleStrategy idle_;
+    const char*        daemon_config_;
     pid_t              daemon_pid_ = -1;
 };
 
+// Data path through libaether.so — what an application linking the library gets.
+using AetherTransport = BasicAetherTransport<false>;
+
+// Data path compiled in from aether/hot_path.h.
+using AetherInlineTransport = BasicAetherTransport<true>;
+
+// ---------------------------------------------------------------------------
+// AetherPackedTransport — the header-only data path with packed slots
+//
+// The publisher packs each message into a PackedPublication and the
+// subscriber polls through a PackedReader, so `received` counts records and
+// a slot handoff is paid once per slot's worth of small messages instead of
+// once per message. The last open slot is flushed at teardown, after the
+// subscriber stopped counting — at most one slot of records goes unreceived.
+// ---------------------------------------------------------------------------
+
+class AetherPackedTransport {
+public:
+    explicit AetherPackedTransport(const char* topic, uint32_t topic_len,
+                                   aether::IdleStrategy idle = aether::IdleStrategy::busy_spin(),
+                                   const char* daemon_config = nullptr)
+        : topic_(topic), topic_len_(topic_len), idle_(idle), daemon_config_(daemon_config) {}
+
+    void setup() {
+        daemon_pid_ = start_daemon(daemon_config_);
+        sub_        = aether::subscribe(topic_, topic_len_);
+        pub_        = aether::packed_publication(sub_.hdr, std::chrono::microseconds(50));
+        read_seq_   = 1;
+    }
+
+    bool publish(const void* data, size_t len) {
+        return aether::hot::pack(pub_, data, static_cast<uint32_t>(len)) == aether::PublishResult::Ok;
+    }
+
+    ConsumeStatus consume(void* buf, size_t& len) {
+        // Record by record through poll(): consume() would hand back whole slots.
+        bool got = false;
+        const auto r = aether::hot::poll(sub_.hdr, read_seq_, reader_, [&](const aether::MessageView& v) {
+            len = v.payload.size();
+            memcpy(buf, v.payload.data(), len);
+            got = true;
+        }, 1);
+        if (r.lapped > 0) return ConsumeStatus::Lapped;
+        return got ? ConsumeStatus::Ok : ConsumeStatus::Empty;
+    }
+
+    PollStatus poll(size_t max_messages) {
+        auto ignore = [](const aether::MessageView&) {};
+        const auto r = aether::hot::poll(sub_.hdr, read_seq_, reader_, ignore,
+                                         static_cast<uint32_t>(max_messages));
+        return PollStatus{r.delivered, r.lapped};
+    }
+
+    void idle(size_t work_count) {
+        idle_.idle(static_cast<uint32_t>(work_count), sub_.hdr, read_seq_);
+    }
+
+    void teardown() {
+        aether::hot::flush(pub_);
+        aether::unsubscribe(sub_);
+        kill(daemon_pid_, SIGTERM);
+        waitpid(daemon_pid_, nullptr, 0);
+    }
+
+private:
+    const char*               topic_;
+    uint32_t                  topic_len_;
+    aether::Subscription      sub_{};
+    aether::PackedPublication pub_{};
+    aether::PackedReader      reader_{};
+    uint64_t                  read_seq_ = 1;
+    aether::IdleStrategy      idle_;
+    const char*               daemon_config_;
+    pid_t                     daemon_pid_ = -1;
+};
+
 static_assert(BenchTransport<AetherTransport>,
     "AetherTransport does not satisfy BenchTransport concept");
+static_assert(BenchTransport<AetherInlineTransport>,
+    "AetherInlineTransport does not satisfy BenchTransport concept");
+static_assert(BenchTransport<AetherPackedTransport>,
+    "AetherPackedTransport does not satisfy BenchTransport concept");
@@ -4,6 +4,8 @@
 // Provides daemon lifecycle, timing, and command-line argument parsing.
 
 #include "aether/control.h"
+#include "aether/idle.h"
+#include "aether/shm.h"
 
 #include <sys/stat.h>
 #include <time.h>
@@ -31,7 +33,8 @@ static inline uint64_t now_ns() {
 // Daemon lifecycle
 // ---------------------------------------------------------------------------
 
-static inline pid_t start_daemon() {
+// `config`: optional aetherd config file, passed with -c.
+static inline pid_t start_daemon(const char* config = nullptr) {
     unlink(aether::DAEMON_SOCKET_PATH);
     pid_t pid = fork();
     if (pid < 0) { perror("fork daemon"); std::abort(); }
@@ -39,7 +42,11 @@ static inline pid_t start_daemon() {
         int devnull = open("/dev/null", O_WRONLY);
         dup2(devnull, STDERR_FILENO);
         close(devnull);
-        execl(AETHERD_PATH, "aetherd", nullptr);
+        if (config != nullptr) {
+            execl(AETHERD_PATH, "aetherd", "-c", config, nullptr);
+        } else {
+            execl(AETHERD_PATH, "aetherd", nullptr);
+        }
         _exit(1);
     }
     for (int i = 0; i < 50; ++i) {
@@ -57,16 +64,52 @@ static inline pid_t start_daemon() {
 
 struct BenchArgs {
     bool record = false;  // write to official CSV in addition to scratch
+    bool log    = false;  // --log: run against a term-log topic instead of slots
+    // --idle <mode>: what the subscriber does on an empty poll. Busy-spin
+    // by default — the numbers measure the transport, not the wake-up.
+    aether::IdleStrategy idle = aether::IdleStrategy::busy_spin();
+    // --huge-pages / --prefault / --mlock / --split-slots: how the daemon
+    // backs and lays out the topic.
+    aether::SegmentOptions topic;
 };
 
 static inline BenchArgs parse_bench_args(int argc, char* argv[]) {
     BenchArgs args;
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--record") == 0) args.record = true;
+        if (strcmp(argv[i], "--log")    == 0) args.log    = true;
+        if (strcmp(argv[i], "--huge-pages") == 0) args.topic.huge_pages = true;
+        if (strcmp(argv[i], "--prefault")   == 0) args.topic.prefault   = true;
+        if (strcmp(argv[i], "--mlock")      == 0) args.topic.lock       = true;
+        if (strcmp(argv[i], "--split-slots") == 0) args.topic.slot_layout = aether::SlotLayout::Split;
+        if (strcmp(argv[i], "--idle")   == 0 &&
+            (i + 1 >= argc || !aether::parse_idle_mode(argv[++i], args.idle.mode))) {
+            fprintf(stderr, "--idle takes busy-spin, yield, backoff or park\n");
+            exit(1);
+        }
     }
     return args;
 }
 
+// Writes the topic settings in `args` to an aetherd config file and returns
+// its path, or nullptr when they are all defaults and the daemon runs bare.
+static inline const char* bench_daemon_config(const BenchArgs& args) {
+    const bool split = args.topic.slot_layout == aether::SlotLayout::Split;
+    if (!args.topic.huge_pages && args.topic.residency() == 0 && !split) return nullptr;
+
+    static char path[64];
+    snprintf(path, sizeof(path), "/tmp/aether-bench-%d.conf", getpid());
+    FILE* f = fopen(path, "w");
+    if (!f) { perror("bench config"); std::abort(); }
+    fprintf(f, "huge_pages = %s\nprefault = %s\nmlock = %s\nslot_layout = %s\n",
+            args.topic.huge_pages ? "on" : "off",
+            args.topic.prefault   ? "on" : "off",
+            args.topic.lock       ? "on" : "off",
+            split                 ? "split" : "interleaved");
+    fclose(f);
+    return path;
+}
+
 // ---------------------------------------------------------------------------
 // Benchmark result types
 // ---------------------------------------------------------------------------
@@ -99,3 +142,40 @@ struct ThroughputResults {
     double   sub_elapsed_s;
     double   sub_rate_mmps;
 };
+
+// Publish-path microbenchmark: one publisher, no subscriber, ns per message
+struct PublishPathResults {
+    uint64_t messages;
+    double   shared_ns_per_msg;
+    double   exclusive_ns_per_msg;
+    double   view_ns_per_msg;            // RingView, compile-time geometry
+    double   roundtrip_ns_per_msg;       // publish + consume, generic
+    double   view_roundtrip_ns_per_msg;  // publish + consume, RingView
+};
+
+// One point of the multi-producer contention curve
+struct ContentionResults {
+    uint32_t producers;
+    uint64_t msgs_per_producer;
+    double   per_producer_mmps;   // mean of each producer's own rate
+    double   aggregate_mmps;      // all messages over wall-clock time
+    double   slowest_producer_s;
+};
+
+// One backing of the page-size benchmark: many topics, touched round-robin
+struct TlbResults {
+    uint32_t page_size;           // what the segments actually got
+    uint32_t topics;
+    uint64_t messages;
+    double   ns_per_msg;          // one publish + one consume
+    int64_t  dtlb_misses;         // loads + stores; -1 if the PMU is unavailable
+};
+
+// Control-plane benchmark: topics created one request at a time
+struct TopicCreateResults {
+    uint32_t topics;
+    double   creates_per_s;
+    uint64_t p50_ns;              // one SubscribeRequest that creates a topic
+    uint64_t p99_ns;
+    uint64_t max_ns;
+};
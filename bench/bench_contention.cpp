@@ -0,0 +1,122 @@
+#include "bench_common.h"
+#include "report.h"
+
+#include "aether/shm.h"
+#include "aether/publish.h"
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdio>
+
+// ---------------------------------------------------------------------------
+// Multi-producer contention benchmark
+//
+// N publisher processes hammer one slot ring with no subscriber, for
+// N = 1, 2, 4, 8, 16. Every producer writes 10x the ring's capacity per
+// round, so the ring wraps continuously and producers meet each other on
+// reused slots. Reports the per-producer and aggregate publish rate for each
+// N — the throughput curve of the shared write_seq and per-slot claim.
+// ---------------------------------------------------------------------------
+
+static constexpr const char* BENCH_SHM_NAME   = "/aether-bench-contention";
+static constexpr uint32_t    BENCH_CAPACITY   = 1024;
+static constexpr uint32_t    BENCH_ROUNDS     = 100;
+static constexpr uint64_t    MSGS_PER_PRODUCER = 10ULL * BENCH_CAPACITY * BENCH_ROUNDS;
+static constexpr int         PRODUCER_COUNTS[] = {1, 2, 4, 8, 16};
+
+struct ContentionMsg {
+    uint64_t seq;
+    uint64_t producer;
+};
+
+// Forks `producers` publishers, releases them together, and returns the
+// results for that point of the curve.
+static ContentionResults run_point(int producers) {
+    int ready_pipe[2], go_pipe[2], results_pipe[2];
+    if (pipe(ready_pipe) != 0 || pipe(go_pipe) != 0 || pipe(results_pipe) != 0) {
+        perror("pipe");
+        std::abort();
+    }
+
+    for (int p = 0; p < producers; ++p) {
+        pid_t pid = fork();
+        if (pid < 0) { perror("fork producer"); std::abort(); }
+        if (pid == 0) {
+            close(go_pipe[1]);  // only the parent may hold the write end open
+
+            aether::RingHeader* hdr = aether::shm_attach(BENCH_SHM_NAME);
+            if (hdr == nullptr) _exit(1);
+
+            char c = 1;
+            write(ready_pipe[1], &c, 1);
+            read(go_pipe[0], &c, 1);  // blocks until the parent closes go_pipe
+
+            const uint64_t t0 = now_ns();
+            for (uint64_t i = 0; i < MSGS_PER_PRODUCER; ++i) {
+                const ContentionMsg msg{i, static_cast<uint64_t>(p)};
+                aether::publish(hdr, &msg, sizeof(msg));
+            }
+            const double elapsed_s = static_cast<double>(now_ns() - t0) / 1e9;
+
+            write(results_pipe[1], &elapsed_s, sizeof(elapsed_s));
+            aether::shm_detach(hdr);
+            _exit(0);
+        }
+    }
+
+    for (int p = 0; p < producers; ++p) {
+        char c = 0;
+        read(ready_pipe[0], &c, 1);
+    }
+    const uint64_t t0 = now_ns();
+    close(go_pipe[1]);  // EOF releases every producer at once
+    close(go_pipe[0]);
+
+    double slowest_s = 0;
+    double rate_sum  = 0;
+    for (int p = 0; p < producers; ++p) {
+        double elapsed_s = 0;
+        read(results_pipe[0], &elapsed_s, sizeof(elapsed_s));
+        rate_sum += static_cast<double>(MSGS_PER_PRODUCER) / elapsed_s / 1e6;
+        if (elapsed_s > slowest_s) slowest_s = elapsed_s;
+    }
+    const double wall_s = static_cast<double>(now_ns() - t0) / 1e9;
+
+    for (int p = 0; p < producers; ++p) wait(nullptr);
+    close(ready_pipe[0]); close(ready_pipe[1]);
+    close(results_pipe[0]); close(results_pipe[1]);
+
+    ContentionResults res{};
+    res.producers          = static_cast<uint32_t>(producers);
+    res.msgs_per_producer  = MSGS_PER_PRODUCER;
+    res.per_producer_mmps  = rate_sum / producers;
+    res.aggregate_mmps     = static_cast<double>(MSGS_PER_PRODUCER) * producers / wall_s / 1e6;
+    res.slowest_producer_s = slowest_s;
+    return res;
+}
+
+int main(int argc, char* argv[]) {
+    BenchArgs args = parse_bench_args(argc, argv);
+    args.log = false;  // slot rings only — this measures the per-slot claim
+
+    shm_unlink(BENCH_SHM_NAME);
+    aether::RingHeader* hdr = aether::shm_create(BENCH_SHM_NAME, BENCH_CAPACITY);
+    if (hdr == nullptr) { perror("shm_create"); return 1; }
+
+    printf("--- bench_contention  (%llu msgs per producer, capacity %u, no subscriber) ---\n",
+           (unsigned long long)MSGS_PER_PRODUCER, BENCH_CAPACITY);
+    printf("producers   per-producer   aggregate\n");
+
+    for (int producers : PRODUCER_COUNTS) {
+        const ContentionResults res = run_point(producers);
+        printf("%9u   %7.2f M/s    %7.2f M/s\n",
+               res.producers, res.per_producer_mmps, res.aggregate_mmps);
+        write_contention_report(args, res);
+    }
+
+    aether::shm_detach(hdr);
+    aether::shm_destroy(BENCH_SHM_NAME);
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "aether_transport.h"
+#include "harness_throughput.h"
+#include "report.h"
+
+#include <cstdio>
+
+// ---------------------------------------------------------------------------
+// Library vs header-only data path
+//
+// Runs the throughput harness twice on the same kind of topic: once with
+// publish() / poll() called through libaether.so, once with the aether::hot
+// versions from hot_path.h compiled into this binary. Same protocol, same
+// shm layout — the difference is the PLT call per message and what the
+// compiler can inline around it. A third run packs the same 8-byte messages
+// many to a slot (PackedPublication / PackedReader), paying one slot handoff
+// per slot's worth of messages.
+// ---------------------------------------------------------------------------
+
+static void print_run(const char* label, const ThroughputResults& res) {
+    printf("%-8s pub %.2f M msgs/s   sub %.2f M msgs/s   (%llu sent, %llu received, %llu lapped)\n",
+           label, res.pub_rate_mmps, res.sub_rate_mmps,
+           (unsigned long long)res.pub_sent,
+           (unsigned long long)res.sub_received,
+           (unsigned long long)res.sub_lapped);
+}
+
+int main(int argc, char* argv[]) {
+    BenchArgs args = parse_bench_args(argc, argv);
+    args.log = false;  // slot rings only — the term log has no inline path
+    const char* daemon_config = bench_daemon_config(args);
+
+    AetherTransport library("bench", 5, args.idle, daemon_config);
+    const ThroughputResults lib_res = run_throughput_bench(library);
+
+    AetherInlineTransport header_only("bench", 5, args.idle, daemon_config);
+    const ThroughputResults inline_res = run_throughput_bench(header_only);
+
+    AetherPackedTransport packed("bench", 5, args.idle, daemon_config);
+    const ThroughputResults packed_res = run_throughput_bench(packed);
+
+    if (daemon_config != nullptr) unlink(daemon_config);
+
+    printf("--- bench_inline  (5 s window per run, 1 pub, 1 sub, same machine) ---\n");
+    print_run("library", lib_res);
+    print_run("inline", inline_res);
+    print_run("packed", packed_res);
+
+    write_throughput_report(args, lib_res, "bench_inline_library");
+    write_throughput_report(args, inline_res, "bench_inline_header");
+    write_throughput_report(args, packed_res, "bench_inline_packed");
+
+    return 0;
+}
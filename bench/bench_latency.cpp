@@ -1,4 +1,5 @@
 #include "aether_transport.h"
+#include "aether_log_transport.h"
 #include "harness_latency.h"
 #include "report.h"
 
@@ -6,11 +7,20 @@
 
 int main(int argc, char* argv[]) {
     const BenchArgs args = parse_bench_args(argc, argv);
+    const char* daemon_config = bench_daemon_config(args);
 
-    AetherTransport transport("bench", 5);
-    const LatencyResults res = run_latency_bench(transport);
+    LatencyResults res{};
+    if (args.log) {
+        AetherLogTransport transport("bench", 5, args.idle, daemon_config);
+        res = run_latency_bench(transport);
+    } else {
+        AetherTransport transport("bench", 5, args.idle, daemon_config);
+        res = run_latency_bench(transport);
+    }
+    if (daemon_config != nullptr) unlink(daemon_config);
 
-    printf("--- bench_latency  (%d published, 1 pub, 1 sub, same machine) ---\n", LATENCY_N_MESSAGES);
+    printf("--- bench_latency  (%d published, 1 pub, 1 sub, same machine, %s) ---\n",
+           LATENCY_N_MESSAGES, args.log ? "term log" : "slots");
     printf("samples  : %llu\n",    (unsigned long long)res.samples);
     printf("min      : %llu ns\n", (unsigned long long)res.min_ns);
     printf("p50      : %llu ns\n", (unsigned long long)res.p50_ns);
@@ -0,0 +1,106 @@
+#include "bench_common.h"
+#include "report.h"
+
+#include "aether/shm.h"
+#include "aether/publish.h"
+#include "aether/consume.h"
+#include "aether/ring_view.h"
+
+#include <sys/mman.h>
+
+#include <cstdio>
+
+// ---------------------------------------------------------------------------
+// Publish-path microbenchmark — shared publish() vs ExclusivePublication
+// vs a compile-time RingView
+//
+// One process, one ring, no daemon and no subscriber: this isolates the cost
+// of the write side itself. The shared path pays a locked fetch_add on
+// write_seq per message; the exclusive path a plain store. The view runs the
+// shared protocol inline with constant geometry instead of through the
+// library. A last pair of runs publishes and consumes each message in turn,
+// generic functions against the view's typed overloads.
+// ---------------------------------------------------------------------------
+
+static constexpr const char* BENCH_SHM_NAME = "/aether-bench-publish";
+static constexpr uint32_t    BENCH_CAPACITY = 1024;
+static constexpr uint64_t    BENCH_MESSAGES = 20'000'000;
+
+struct PublishMsg {
+    uint64_t seq;
+};
+
+using BenchView = aether::RingView<BENCH_CAPACITY, aether::SLOT_DATA_SIZE>;
+
+template<typename PublishFn>
+static double ns_per_msg(PublishFn&& publish_one) {
+    const uint64_t t0 = now_ns();
+    for (uint64_t i = 0; i < BENCH_MESSAGES; ++i) {
+        const PublishMsg msg{i};
+        publish_one(msg);
+    }
+    return static_cast<double>(now_ns() - t0) / static_cast<double>(BENCH_MESSAGES);
+}
+
+int main(int argc, char* argv[]) {
+    BenchArgs args = parse_bench_args(argc, argv);
+    args.log = false;  // slot rings only — the term log has no exclusive mode
+
+    shm_unlink(BENCH_SHM_NAME);
+    aether::RingHeader* hdr = aether::shm_create(BENCH_SHM_NAME, BENCH_CAPACITY);
+    if (hdr == nullptr) { perror("shm_create"); return 1; }
+
+    PublishPathResults res{};
+    res.messages = BENCH_MESSAGES;
+
+    res.shared_ns_per_msg = ns_per_msg([&](const PublishMsg& m) {
+        aether::publish(hdr, &m, sizeof(m));
+    });
+
+    aether::ExclusivePublication pub{};
+    if (!aether::acquire_exclusive(hdr, pub)) {
+        fprintf(stderr, "acquire_exclusive failed\n");
+        return 1;
+    }
+    res.exclusive_ns_per_msg = ns_per_msg([&](const PublishMsg& m) {
+        aether::publish(pub, &m, sizeof(m));
+    });
+    aether::release_exclusive(pub);
+
+    BenchView view;
+    if (!aether::attach_view(hdr, view)) {
+        fprintf(stderr, "attach_view failed\n");
+        return 1;
+    }
+    res.view_ns_per_msg = ns_per_msg([&](const PublishMsg& m) {
+        aether::publish(view, m);
+    });
+
+    uint64_t read_seq = hdr->write_seq.load();
+    res.roundtrip_ns_per_msg = ns_per_msg([&](const PublishMsg& m) {
+        PublishMsg out;
+        uint32_t out_len = sizeof(out);
+        aether::publish(hdr, &m, sizeof(m));
+        aether::consume(hdr, &out, out_len, read_seq);
+    });
+    res.view_roundtrip_ns_per_msg = ns_per_msg([&](const PublishMsg& m) {
+        PublishMsg out;
+        aether::publish(view, m);
+        aether::consume(view, out, read_seq);
+    });
+
+    aether::shm_detach(hdr);
+    aether::shm_destroy(BENCH_SHM_NAME);
+
+    printf("--- bench_publish  (%llu msgs, 1 publisher, no subscriber) ---\n",
+           (unsigned long long)res.messages);
+    printf("shared    : %.2f ns/msg\n", res.shared_ns_per_msg);
+    printf("exclusive : %.2f ns/msg\n", res.exclusive_ns_per_msg);
+    printf("view      : %.2f ns/msg\n", res.view_ns_per_msg);
+    printf("publish + consume, generic : %.2f ns/msg\n", res.roundtrip_ns_per_msg);
+    printf("publish + consume, view    : %.2f ns/msg\n", res.view_roundtrip_ns_per_msg);
+
+    write_publish_report(args, res);
+
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "aether_transport.h"
+#include "aether_log_transport.h"
 #include "harness_throughput.h"
 #include "report.h"
 
@@ -6,11 +7,20 @@
 
 int main(int argc, char* argv[]) {
     const BenchArgs args = parse_bench_args(argc, argv);
+    const char* daemon_config = bench_daemon_config(args);
 
-    AetherTransport transport("bench", 5);
-    const ThroughputResults res = run_throughput_bench(transport);
+    ThroughputResults res{};
+    if (args.log) {
+        AetherLogTransport transport("bench", 5, args.idle, daemon_config);
+        res = run_throughput_bench(transport);
+    } else {
+        AetherTransport transport("bench", 5, args.idle, daemon_config);
+        res = run_throughput_bench(transport);
+    }
+    if (daemon_config != nullptr) unlink(daemon_config);
 
-    printf("--- bench_throughput  (5 s window, 1 pub, 1 sub, same machine) ---\n");
+    printf("--- bench_throughput  (5 s window, 1 pub, 1 sub, same machine, %s) ---\n",
+           args.log ? "term log" : "slots");
     printf("pub sent     : %llu msgs\n",     (unsigned long long)res.pub_sent);
     printf("pub elapsed  : %.3f s\n",        res.pub_elapsed_s);
     printf("pub rate     : %.2f M msgs/s\n", res.pub_rate_mmps);
@@ -0,0 +1,133 @@
+#include "bench_common.h"
+#include "perf_counter.h"
+#include "report.h"
+
+#include "aether/shm.h"
+#include "aether/publish.h"
+#include "aether/consume.h"
+
+#include <cstdio>
+
+// ---------------------------------------------------------------------------
+// Page-size benchmark — dTLB pressure of many topics, 4 KB vs huge pages
+//
+// One process, no daemon. BENCH_TOPICS rings the size of a default daemon
+// topic (~4 MB each) are created once on ordinary pages and once with
+// SegmentOptions::huge_pages. The loop then publishes one message to each
+// topic in turn and consumes it again. Each 4160-byte slot touches new 4 KB
+// pages, so the ordinary-page working set is far beyond what the dTLB can
+// map; with 2 MB pages the whole set fits. Reports ns per publish+consume and
+// dTLB misses (loads + stores) for both runs.
+//
+// Huge pages need a hugetlbfs mount at aether::HUGETLBFS_PATH and a pool
+// large enough for every topic:
+//
+//   mount -t hugetlbfs none /dev/hugepages
+//   sysctl vm.nr_hugepages=128
+// ---------------------------------------------------------------------------
+
+static constexpr uint32_t BENCH_TOPICS   = 32;
+static constexpr uint32_t BENCH_CAPACITY = 1024;
+static constexpr uint32_t BENCH_ROUNDS   = 100;  // passes over every slot of every topic
+static constexpr uint64_t BENCH_MESSAGES = static_cast<uint64_t>(BENCH_TOPICS) * BENCH_CAPACITY * BENCH_ROUNDS;
+
+struct TlbMsg {
+    uint64_t seq;
+};
+
+static void topic_shm_name(uint32_t topic, char (&name)[32]) {
+    snprintf(name, sizeof(name), "/aether-bench-tlb-%u", topic);
+}
+
+static TlbResults run_backing(const aether::SegmentOptions& options) {
+    aether::RingHeader* hdrs[BENCH_TOPICS]{};
+    uint64_t read_seqs[BENCH_TOPICS];
+    for (uint32_t t = 0; t < BENCH_TOPICS; ++t) {
+        char name[32];
+        topic_shm_name(t, name);
+        aether::shm_destroy(name);
+        hdrs[t] = aether::shm_create(name, BENCH_CAPACITY, aether::OverflowPolicy::Overwrite, options);
+        if (hdrs[t] == nullptr) { perror("shm_create"); std::abort(); }
+        read_seqs[t] = 1;
+    }
+
+    // One untimed pass faults every page in, so the measured rounds see
+    // TLB misses rather than page faults.
+    uint8_t buf[aether::SLOT_DATA_SIZE];
+    uint64_t seq = 0;
+    auto publish_and_consume_all = [&] {
+        for (uint32_t t = 0; t < BENCH_TOPICS; ++t) {
+            const TlbMsg msg{seq++};
+            aether::publish(hdrs[t], &msg, sizeof(msg));
+            uint32_t buf_len = sizeof(buf);
+            aether::consume(hdrs[t], buf, buf_len, read_seqs[t]);
+        }
+    };
+    for (uint32_t i = 0; i < BENCH_CAPACITY; ++i) publish_and_consume_all();
+
+    PerfCounter load_misses  = PerfCounter::dtlb_misses(PERF_COUNT_HW_CACHE_OP_READ);
+    PerfCounter store_misses = PerfCounter::dtlb_misses(PERF_COUNT_HW_CACHE_OP_WRITE);
+
+    load_misses.start();
+    store_misses.start();
+    const uint64_t t0 = now_ns();
+    for (uint64_t i = 0; i < BENCH_CAPACITY * BENCH_ROUNDS; ++i) publish_and_consume_all();
+    const uint64_t elapsed_ns = now_ns() - t0;
+    load_misses.stop();
+    store_misses.stop();
+
+    TlbResults res{};
+    res.page_size  = hdrs[0]->page_size;
+    res.topics     = BENCH_TOPICS;
+    res.messages   = BENCH_MESSAGES;
+    res.ns_per_msg = static_cast<double>(elapsed_ns) / static_cast<double>(BENCH_MESSAGES);
+    const int64_t loads  = load_misses.value();
+    const int64_t stores = store_misses.value();
+    res.dtlb_misses = loads < 0 || stores < 0 ? -1 : loads + stores;
+
+    for (uint32_t t = 0; t < BENCH_TOPICS; ++t) {
+        char name[32];
+        topic_shm_name(t, name);
+        aether::shm_detach(hdrs[t]);
+        aether::shm_destroy(name);
+    }
+    return res;
+}
+
+static void print_result(const TlbResults& res) {
+    printf("%7u KB pages : %6.2f ns/msg   dTLB misses ", res.page_size / 1024, res.ns_per_msg);
+    if (res.dtlb_misses < 0) {
+        printf("n/a\n");
+    } else {
+        printf("%lld (%.3f/msg)\n", (long long)res.dtlb_misses,
+               static_cast<double>(res.dtlb_misses) / static_cast<double>(res.messages));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchArgs args = parse_bench_args(argc, argv);
+    args.log = false;  // slot rings only
+
+    printf("--- bench_tlb  (%u topics x %u slots, %llu msgs, publish + consume round-robin) ---\n",
+           BENCH_TOPICS, BENCH_CAPACITY, (unsigned long long)BENCH_MESSAGES);
+
+    const TlbResults small = run_backing(aether::SegmentOptions{});
+    print_result(small);
+    write_tlb_report(args, small);
+
+    aether::SegmentOptions huge_options;
+    huge_options.huge_pages = true;
+    const TlbResults huge = run_backing(huge_options);
+    print_result(huge);
+    write_tlb_report(args, huge);
+
+    if (huge.page_size == small.page_size) {
+        printf("huge pages unavailable: mount hugetlbfs at %s and reserve vm.nr_hugepages\n",
+               aether::HUGETLBFS_PATH);
+    } else if (small.dtlb_misses > 0 && huge.dtlb_misses >= 0) {
+        printf("dTLB misses with huge pages: %.1f%% of 4 KB pages, time %.1f%%\n",
+               100.0 * static_cast<double>(huge.dtlb_misses) / static_cast<double>(small.dtlb_misses),
+               100.0 * huge.ns_per_msg / small.ns_per_msg);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "bench_common.h"
+#include "report.h"
+
+#include "aether/control.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <csignal>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+// ---------------------------------------------------------------------------
+// Control-plane benchmark — topic creations per second
+//
+// Starts aetherd and asks it for BENCH_TOPICS new slot topics of the default
+// geometry (1024 x 4 KB slots), one SubscribeRequest at a time over the
+// daemon's Unix socket. Nothing is mapped on the client side: each request
+// times the daemon creating the segment, initialising the ring and answering,
+// with its registry lock held — the wait every other subscribe and TCP publish
+// sees behind a creation. Reports creations per second and the per-creation
+// latency distribution.
+// ---------------------------------------------------------------------------
+
+static constexpr uint32_t BENCH_TOPICS = 256;
+
+// One SubscribeRequest for topic `name`, answered by the daemon.
+static aether::ControlStatus request_topic(const char* name) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { perror("socket"); std::abort(); }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, aether::DAEMON_SOCKET_PATH, sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        perror("connect"); std::abort();
+    }
+
+    aether::SubscribeRequest req{};
+    req.topic_len = static_cast<uint32_t>(strlen(name));
+    req.layout    = aether::RingLayout::Slots;
+    req.policy    = aether::OverflowPolicy::Overwrite;
+    memcpy(req.topic, name, req.topic_len);
+    write(fd, &req, sizeof(req));
+
+    aether::SubscribeResponse resp{};
+    const ssize_t n = recv(fd, &resp, sizeof(resp), MSG_WAITALL);
+    close(fd);
+    return n == static_cast<ssize_t>(sizeof(resp)) ? resp.status : aether::ControlStatus::InternalError;
+}
+
+int main(int argc, char* argv[]) {
+    BenchArgs args = parse_bench_args(argc, argv);
+    const char* daemon_config = bench_daemon_config(args);
+    const pid_t daemon = start_daemon(daemon_config);
+
+    std::vector<uint64_t> latencies;
+    latencies.reserve(BENCH_TOPICS);
+    const uint64_t t0 = now_ns();
+    for (uint32_t i = 0; i < BENCH_TOPICS; ++i) {
+        char name[32];
+        snprintf(name, sizeof(name), "bench-topic-%u", i);
+        const uint64_t start = now_ns();
+        if (request_topic(name) != aether::ControlStatus::Ok) {
+            fprintf(stderr, "creating topic %s failed\n", name);
+            std::abort();
+        }
+        latencies.push_back(now_ns() - start);
+    }
+    const uint64_t elapsed_ns = now_ns() - t0;
+
+    kill(daemon, SIGTERM);
+    waitpid(daemon, nullptr, 0);
+    if (daemon_config != nullptr) unlink(daemon_config);
+
+    std::sort(latencies.begin(), latencies.end());
+    TopicCreateResults res{};
+    res.topics         = BENCH_TOPICS;
+    res.creates_per_s  = static_cast<double>(BENCH_TOPICS) * 1e9 / static_cast<double>(elapsed_ns);
+    res.p50_ns         = latencies[latencies.size() / 2];
+    res.p99_ns         = latencies[latencies.size() * 99 / 100];
+    res.max_ns         = latencies.back();
+
+    printf("--- bench_topics  (%u slot topics of 1024 x %zu B, one request at a time) ---\n",
+           BENCH_TOPICS, aether::SLOT_DATA_SIZE);
+    printf("%.0f creations/s   p50 %.1f us   p99 %.1f us   max %.1f us\n", res.creates_per_s,
+           res.p50_ns / 1e3, res.p99_ns / 1e3, res.max_ns / 1e3);
+
+    write_topic_create_report(args, res);
+    return 0;
+}
@@ -80,6 +80,7 @@ LatencyResults run_latency_bench(T& transport) {
                 }
             }
             // On Lapped: internal state already advanced, just continue
+            transport.idle(result == ConsumeStatus::Empty ? 0 : 1);
         }
 
         close(done_pipe[0]);
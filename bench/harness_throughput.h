@@ -24,6 +24,9 @@ struct ThroughputMsg {
     uint64_t seq;
 };
 
+// Messages the subscriber drains per poll() call.
+static constexpr size_t THROUGHPUT_POLL_BATCH = 256;
+
 template<BenchTransport T>
 ThroughputResults run_throughput_bench(T& transport) {
     transport.setup();
@@ -58,29 +61,25 @@ ThroughputResults run_throughput_bench(T& transport) {
         bool running      = true;
 
         while (running) {
-            ThroughputMsg buf{};
-            size_t buf_len = sizeof(buf);
-            const auto result = transport.consume(&buf, buf_len);
-
-            if (result == ConsumeStatus::Ok) {
-                if (received == 0) t_start = now_ns();
-                ++received;
-            } else if (result == ConsumeStatus::Lapped) {
-                ++lapped;
-            } else {
+            const PollStatus st = transport.poll(THROUGHPUT_POLL_BATCH);
+
+            if (st.received > 0 && received == 0) t_start = now_ns();
+            received += st.received;
+            lapped   += st.lapped;
+
+            if (st.received == 0 && st.lapped == 0) {
                 char done_byte = 0;
                 if (read(done_pipe[0], &done_byte, 1) == 1) running = false;
             }
+            transport.idle(st.received + st.lapped);
         }
 
         // Drain remaining messages written before the done signal
         while (true) {
-            ThroughputMsg buf{};
-            size_t buf_len = sizeof(buf);
-            const auto result = transport.consume(&buf, buf_len);
-            if      (result == ConsumeStatus::Ok)     { ++received; }
-            else if (result == ConsumeStatus::Lapped) { ++lapped;   }
-            else break;
+            const PollStatus st = transport.poll(THROUGHPUT_POLL_BATCH);
+            received += st.received;
+            lapped   += st.lapped;
+            if (st.received == 0 && st.lapped == 0) break;
         }
 
         const uint64_t t_end = now_ns();
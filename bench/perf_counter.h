@@ -0,0 +1,65 @@
+#pragma once
+
+// Hardware event counting for the benchmarks, via perf_event_open(2).
+// Counts this process only, user space only. Counting is often unavailable
+// (no PMU in the VM, perf_event_paranoid, seccomp): the counter then reports
+// -1 and benchmarks print "n/a" instead of failing.
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+class PerfCounter {
+public:
+    PerfCounter(uint32_t type, uint64_t config) {
+        perf_event_attr attr{};
+        attr.size           = sizeof(attr);
+        attr.type           = type;
+        attr.config         = config;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    // dTLB misses for `op` — PERF_COUNT_HW_CACHE_OP_READ or _WRITE.
+    static PerfCounter dtlb_misses(uint32_t op) {
+        return PerfCounter(PERF_TYPE_HW_CACHE,
+                           PERF_COUNT_HW_CACHE_DTLB | (op << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+    }
+
+    PerfCounter(PerfCounter&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+    PerfCounter(const PerfCounter&)            = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+    PerfCounter& operator=(PerfCounter&&)      = delete;
+
+    ~PerfCounter() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    void start() {
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    void stop() {
+        if (fd_ >= 0) ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+    }
+
+    // Events counted between start() and stop(), or -1 if unavailable.
+    int64_t value() const {
+        uint64_t count = 0;
+        if (fd_ < 0 || read(fd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+            return -1;
+        }
+        return static_cast<int64_t>(count);
+    }
+
+private:
+    int fd_ = -1;
+};
@@ -7,6 +7,7 @@
 #include "bench_common.h"
 #include "aether/version.h"
 #include "aether/ring.h"
+#include "aether/term_log.h"
 
 #include <sys/stat.h>
 #include <time.h>
@@ -64,15 +65,29 @@ static inline FILE* open_report_csv(const char* dir, const char* filename, const
 // Internal: write a pre-formatted data row to the appropriate CSV files.
 // Prepends timestamp, aether_version, ring_version automatically.
 // All CSV routing (scratch vs official, filenames, dirs) lives here.
+// Term-log runs (--log) go to "<name>_log.csv" and record LOG_VERSION in the
+// ring_version column, so the two layouts never share a file.
+// Runs with a non-default --idle strategy likewise get "_<mode>" appended,
+// and runs with --huge-pages / --prefault / --mlock / --split-slots "_huge" /
+// "_prefault" / "_mlock" / "_split".
 // ---------------------------------------------------------------------------
 
-static inline void write_csv_row(const BenchArgs& args, const char* filename,
+static inline void write_csv_row(const BenchArgs& args, const char* name,
                                   const char* header, const char* data) {
+    const bool default_idle = args.idle.mode == aether::IdleMode::BusySpin;
+    char filename[128];
+    snprintf(filename, sizeof(filename), "%s%s%s%s%s%s%s%s.csv", name, args.log ? "_log" : "",
+             default_idle ? "" : "_", default_idle ? "" : aether::idle_mode_name(args.idle.mode),
+             args.topic.huge_pages ? "_huge" : "", args.topic.prefault ? "_prefault" : "",
+             args.topic.lock ? "_mlock" : "",
+             args.topic.slot_layout == aether::SlotLayout::Split ? "_split" : "");
+    const uint32_t layout_version = args.log ? aether::LOG_VERSION : aether::RING_VERSION;
+
     auto do_write = [&](FILE* f) {
         if (!f) return;
         char ts[32];
         fill_timestamp(ts, sizeof(ts));
-        fprintf(f, "%s,%s,%u,%s\n", ts, AETHER_VERSION_STRING, aether::RING_VERSION, data);
+        fprintf(f, "%s,%s,%u,%s\n", ts, AETHER_VERSION_STRING, layout_version, data);
         fclose(f);
     };
 
@@ -100,10 +115,13 @@ static inline void write_latency_report(const BenchArgs& args, const LatencyResu
              (unsigned long long)res.p99_99_ns,
              (unsigned long long)res.max_ns);
 
-    write_csv_row(args, "bench_latency.csv", HEADER, data);
+    write_csv_row(args, "bench_latency", HEADER, data);
 }
 
-static inline void write_throughput_report(const BenchArgs& args, const ThroughputResults& res) {
+// `name` lets benchmarks that run the throughput harness more than once
+// (bench_inline) keep each run in its own CSV.
+static inline void write_throughput_report(const BenchArgs& args, const ThroughputResults& res,
+                                           const char* name = "bench_throughput") {
     static constexpr const char* HEADER =
         "timestamp,aether_version,ring_version,"
         "pub_sent,pub_elapsed_s,pub_rate_mmps,"
@@ -117,5 +135,62 @@ static inline void write_throughput_report(const BenchArgs& args, const Throughp
              (unsigned long long)res.sub_lapped,
              res.sub_elapsed_s, res.sub_rate_mmps);
 
-    write_csv_row(args, "bench_throughput.csv", HEADER, data);
+    write_csv_row(args, name, HEADER, data);
+}
+
+static inline void write_publish_report(const BenchArgs& args, const PublishPathResults& res) {
+    static constexpr const char* HEADER =
+        "timestamp,aether_version,ring_version,messages,"
+        "shared_ns_per_msg,exclusive_ns_per_msg,view_ns_per_msg,"
+        "roundtrip_ns_per_msg,view_roundtrip_ns_per_msg";
+
+    char data[160];
+    snprintf(data, sizeof(data), "%llu,%.2f,%.2f,%.2f,%.2f,%.2f",
+             (unsigned long long)res.messages,
+             res.shared_ns_per_msg, res.exclusive_ns_per_msg, res.view_ns_per_msg,
+             res.roundtrip_ns_per_msg, res.view_roundtrip_ns_per_msg);
+
+    write_csv_row(args, "bench_publish", HEADER, data);
+}
+
+static inline void write_contention_report(const BenchArgs& args, const ContentionResults& res) {
+    static constexpr const char* HEADER =
+        "timestamp,aether_version,ring_version,producers,msgs_per_producer,"
+        "per_producer_mmps,aggregate_mmps,slowest_producer_s";
+
+    char data[160];
+    snprintf(data, sizeof(data), "%u,%llu,%.2f,%.2f,%.3f",
+             res.producers,
+             (unsigned long long)res.msgs_per_producer,
+             res.per_producer_mmps, res.aggregate_mmps, res.slowest_producer_s);
+
+    write_csv_row(args, "bench_contention", HEADER, data);
+}
+
+static inline void write_tlb_report(const BenchArgs& args, const TlbResults& res) {
+    static constexpr const char* HEADER =
+        "timestamp,aether_version,ring_version,page_size,topics,messages,"
+        "ns_per_msg,dtlb_misses";
+
+    char data[160];
+    snprintf(data, sizeof(data), "%u,%u,%llu,%.2f,%lld",
+             res.page_size, res.topics,
+             (unsigned long long)res.messages,
+             res.ns_per_msg, (long long)res.dtlb_misses);
+
+    write_csv_row(args, "bench_tlb", HEADER, data);
+}
+
+static inline void write_topic_create_report(const BenchArgs& args, const TopicCreateResults& res) {
+    static constexpr const char* HEADER =
+        "timestamp,aether_version,ring_version,topics,creates_per_s,p50_ns,p99_ns,max_ns";
+
+    char data[128];
+    snprintf(data, sizeof(data), "%u,%.0f,%llu,%llu,%llu",
+             res.topics, res.creates_per_s,
+             (unsigned long long)res.p50_ns,
+             (unsigned long long)res.p99_ns,
+             (unsigned long long)res.max_ns);
+
+    write_csv_row(args, "bench_topics", HEADER, data);
 }
@@ -29,9 +29,15 @@ enum class ConsumeStatus {
     Lapped, // consumer fell behind, message(s) lost; internal state advanced
 };
 
-// A type T satisfies BenchTransport if it provides these four operations.
+// Result of a batched poll(): messages drained and lap events seen.
+struct PollStatus {
+    size_t received;
+    size_t lapped;
+};
+
+// A type T satisfies BenchTransport if it provides these six operations.
 template<typename T>
-concept BenchTransport = requires(T t, const void* data, void* buf, size_t len) {
+concept BenchTransport = requires(T t, const void* data, void* buf, size_t len, size_t max_messages) {
     // Prepare both endpoints in shared memory. Must be called before fork().
     { t.setup()            } -> std::same_as<void>;
 
@@ -42,6 +48,15 @@ concept BenchTransport = requires(T t, const void* data, void* buf, size_t len)
     // bytes written on Ok. Transport owns its read position internally.
     { t.consume(buf, len)  } -> std::same_as<ConsumeStatus>;
 
+    // Drain up to max_messages without handing payloads back. Used where the
+    // harness only counts messages; transports with a native batch API use
+    // it, others may loop over consume().
+    { t.poll(max_messages) } -> std::same_as<PollStatus>;
+
+    // Called by the subscriber loop after every consume()/poll() with the
+    // number of messages and laps it returned; idles when that is 0.
+    { t.idle(max_messages) } -> std::same_as<void>;
+
     // Release all resources acquired in setup().
     { t.teardown()         } -> std::same_as<void>;
 };
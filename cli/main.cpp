@@ -2,7 +2,10 @@
 #include "aether/subscribe.h"
 #include "aether/publish.h"
 #include "aether/consume.h"
+#include "aether/idle.h"
 
+#include <chrono>
+#include <cstdint>
 #include <csignal>
 #include <cstdio>
 #include <cstdlib>
@@ -17,7 +20,8 @@ static void usage() {
     fprintf(stderr,
         "Usage:\n"
         "  aether-cli pub <topic> <message>\n"
-        "  aether-cli sub <topic>\n"
+        "  aether-cli sub <topic> [--idle busy-spin|yield|backoff|park]\n"
+        "  aether-cli resize <topic> <capacity>\n"
         "  aether-cli stats\n"
         "  aether-cli shutdown\n");
 }
@@ -48,9 +52,20 @@ static int cmd_pub(const char* topic, const char* message) {
     const auto topic_len = static_cast<uint32_t>(strlen(topic));
     aether::Subscription sub = aether::subscribe(topic, topic_len);
 
+    // "channel/name" topics share the channel's ring — tag the slot.
+    aether::MessageMeta meta{};
+    meta.topic_id = sub.topic_id;
+
     const auto msg_len = static_cast<uint32_t>(strlen(message));
-    if (!aether::publish(sub.hdr, message, msg_len)) {
-        fprintf(stderr, "error: publish failed (message too large?)\n");
+    aether::PublishResult result = aether::publish(sub.hdr, meta, message, msg_len);
+    while (result == aether::PublishResult::Superseded && aether::migrate(sub)) {
+        result = aether::publish(sub.hdr, meta, message, msg_len);  // resized meanwhile
+    }
+    if (result != aether::PublishResult::Ok) {
+        fprintf(stderr, "error: publish failed (%s)\n",
+                result == aether::PublishResult::TooLarge      ? "message too large"
+                : result == aether::PublishResult::BackPressured ? "back-pressured by a slow subscriber"
+                                                                 : "topic held by an exclusive publisher");
         aether::unsubscribe(sub);
         return 1;
     }
@@ -60,38 +75,87 @@ static int cmd_pub(const char* topic, const char* message) {
     return 0;
 }
 
-static int cmd_sub(const char* topic) {
+static int cmd_sub(const char* topic, aether::IdleStrategy idle) {
     const auto topic_len = static_cast<uint32_t>(strlen(topic));
     aether::Subscription sub = aether::subscribe(topic, topic_len);
 
-    uint64_t read_seq = sub.hdr->write_seq.load(std::memory_order_relaxed);
-    char buf[aether::SLOT_DATA_SIZE];
-    uint32_t buf_len;
+    uint64_t read_seq = aether::ring_head(sub.hdr);
+
+    // On a BackPressure topic, hold publishers back rather than miss messages.
+    aether::SubscriberCursor* cursor = aether::attach_cursor(sub.hdr, read_seq);
 
     printf("subscribed to '%s', waiting for messages... (Ctrl-C to stop)\n", topic);
 
-    while (true) {
-        buf_len = sizeof(buf);
-        aether::ConsumeResult r = aether::consume(sub.hdr, buf, buf_len, read_seq);
+    // Fragmented messages are printed whole, packed ones one record per line.
+    aether::FragmentAssembler assembler;
 
-        if (r == aether::ConsumeResult::Ok) {
-            // Print the payload. Not null-terminated, so use fwrite.
-            fwrite(buf, 1, buf_len, stdout);
+    // Print straight from the slot. Not null-terminated, so use fwrite.
+    auto print = [](const aether::MessageView& v) {
+        if (!(v.flags & aether::SLOT_FLAG_PACKED)) {
+            fwrite(v.payload.data(), 1, v.payload.size(), stdout);
             putchar('\n');
+            return;
+        }
+        for (std::span<const uint8_t> record : aether::packed_records(v.payload)) {
+            fwrite(record.data(), 1, record.size(), stdout);
+            putchar('\n');
+        }
+    };
+
+    while (true) {
+        // A multiplexed topic sees only its own slots of the shared ring.
+        const aether::PollResult r = sub.topic_id != 0
+            ? aether::poll(sub.hdr, read_seq, sub.topic_id, assembler, print, 64)
+            : aether::poll(sub.hdr, read_seq, assembler, print, 64);
+
+        if (r.delivered > 0) {
             fflush(stdout);
-        } else if (r == aether::ConsumeResult::Lapped) {
-            fprintf(stderr, "[lapped — skipped to seq %llu]\n",
+        }
+        // Stepped-over slots of other topics move read_seq too.
+        aether::update_cursor(cursor, read_seq);
+        if (r.lapped > 0) {
+            fprintf(stderr, "[lapped%s — lost %llu messages, skipped to seq %llu]\n",
+                    r.torn ? ", last message torn" : "",
+                    static_cast<unsigned long long>(r.lost),
                     static_cast<unsigned long long>(read_seq));
-        } else {
-            usleep(1000); // 1ms — avoid busy spin
         }
+        // Topic resized: carry on in its new ring — or idle and try again
+        // if it is not there yet.
+        if (r.superseded && aether::migrate(sub, cursor)) {
+            continue;
+        }
+        idle.idle(r.delivered + r.lapped, sub.hdr, read_seq);
     }
 
     // unreachable, but clean up if we ever add signal handling
+    aether::detach_cursor(cursor);
     aether::unsubscribe(sub);
     return 0;
 }
 
+static int cmd_resize(const char* topic, const char* capacity_arg) {
+    char* end = nullptr;
+    const unsigned long capacity = strtoul(capacity_arg, &end, 10);
+    if (*capacity_arg == '\0' || *end != '\0' || capacity > UINT32_MAX) {
+        fprintf(stderr, "error: invalid capacity '%s'\n", capacity_arg);
+        return 1;
+    }
+
+    const aether::ControlStatus status =
+        aether::resize_topic(topic, static_cast<uint32_t>(strlen(topic)), static_cast<uint32_t>(capacity));
+    if (status != aether::ControlStatus::Ok) {
+        fprintf(stderr, "error: resize failed (%s)\n",
+                status == aether::ControlStatus::TopicNotFound     ? "no such topic"
+                : status == aether::ControlStatus::LayoutMismatch  ? "term-log topics cannot be resized"
+                : status == aether::ControlStatus::InvalidGeometry ? "capacity must be a power of two above the current one"
+                : status == aether::ControlStatus::Busy            ? "topic held by an exclusive publisher"
+                                                                   : "daemon error, see its log");
+        return 1;
+    }
+    printf("resized '%s' to %lu slots\n", topic, capacity);
+    return 0;
+}
+
 static int cmd_stats() {
     pid_t pid = read_daemon_pid();
     if (pid < 0) return 1;
@@ -137,11 +201,22 @@ int main(int argc, char* argv[]) {
     }
 
     if (strcmp(cmd, "sub") == 0) {
-        if (argc != 3) {
-            fprintf(stderr, "Usage: aether-cli sub <topic>\n");
+        // Park by default: an interactive subscriber should not burn a core.
+        aether::IdleStrategy idle = aether::IdleStrategy::park(std::chrono::seconds(1));
+        const bool idle_given = argc == 5 && strcmp(argv[3], "--idle") == 0;
+        if ((argc != 3 && !idle_given) || (idle_given && !aether::parse_idle_mode(argv[4], idle.mode))) {
+            fprintf(stderr, "Usage: aether-cli sub <topic> [--idle busy-spin|yield|backoff|park]\n");
+            return 1;
+        }
+        return cmd_sub(argv[2], idle);
+    }
+
+    if (strcmp(cmd, "resize") == 0) {
+        if (argc != 4) {
+            fprintf(stderr, "Usage: aether-cli resize <topic> <capacity>\n");
             return 1;
         }
-        return cmd_sub(argv[2]);
+        return cmd_resize(argv[2], argv[3]);
     }
 
     if (strcmp(cmd, "stats") == 0) {
@@ -1,6 +1,8 @@
 #include "acceptor.h"
 #include "topic_registry.h"
+#include "config.h"
 #include "aether/control.h"
+#include "aether/ring.h"
 
 #include <sys/socket.h>  // socket, bind, listen, accept
 #include <sys/un.h>      // sockaddr_un
@@ -18,6 +20,18 @@ static std::thread g_acceptor_thread;
 // Handle a single client connection
 // ---------------------------------------------------------------------------
 
+// Describe `topic` to the client that asked for it.
+static void fill_response(aether::SubscribeResponse& resp, const TopicInfo& topic) {
+    resp.status   = aether::ControlStatus::Ok;
+    resp.layout   = topic.layout;
+    resp.policy   = topic.hdr != nullptr ? topic.hdr->policy : aether::OverflowPolicy::Overwrite;
+    resp.capacity = topic.log != nullptr ? topic.log->term_length : topic.hdr->capacity;
+    resp.slot_size = topic.hdr != nullptr ? topic.hdr->slot_size : 0;
+    resp.topic_id  = topic.topic_id;
+    resp.arena_offset = topic.arena_offset;
+    std::strncpy(resp.shm_name, topic.shm_name, aether::MAX_SHM_NAME_LEN - 1);
+}
+
 static void handle_client(int client_fd) {
     aether::SubscribeRequest req{};
     ssize_t n = read(client_fd, &req, sizeof(req));
@@ -27,13 +41,54 @@ static void handle_client(int client_fd) {
     }
 
     aether::SubscribeResponse resp{};
-    const TopicInfo* topic = get_or_create_topic(req.topic, req.topic_len);
-    if (topic == nullptr) {
+    if (req.op == aether::ControlOp::Resize) {
+        const std::optional<TopicInfo> topic = resize_topic(req.topic, req.topic_len, req.capacity,
+                                                            resp.status);
+        if (topic) {
+            fill_response(resp, *topic);
+        }
+        write(client_fd, &resp, sizeof(resp));
+        close(client_fd);
+        return;
+    }
+    if (req.op != aether::ControlOp::Subscribe) {
+        resp.status = aether::ControlStatus::InternalError;
+        write(client_fd, &resp, sizeof(resp));
+        close(client_fd);
+        return;
+    }
+
+    const bool layout_ok = req.layout == aether::RingLayout::Slots ||
+                           req.layout == aether::RingLayout::TermLog;
+    const bool policy_ok = req.policy == aether::OverflowPolicy::Overwrite ||
+                           (req.policy == aether::OverflowPolicy::BackPressure &&
+                            req.layout == aether::RingLayout::Slots);
+    if (!layout_ok || !policy_ok) {
+        resp.status = aether::ControlStatus::InternalError;
+        write(client_fd, &resp, sizeof(resp));
+        close(client_fd);
+        return;
+    }
+
+    // 0 leaves the choice to the daemon config.
+    const bool geometry_ok = (req.capacity & (req.capacity - 1)) == 0 &&
+                             req.slot_size <= aether::MAX_SLOT_DATA_SIZE;
+    if (!geometry_ok) {
+        resp.status = aether::ControlStatus::InvalidGeometry;
+        write(client_fd, &resp, sizeof(resp));
+        close(client_fd);
+        return;
+    }
+
+    const std::optional<TopicInfo> topic = get_or_create_topic(req.topic, req.topic_len, req.layout,
+                                                               req.policy, req.capacity, req.slot_size);
+    if (!topic) {
         resp.status = aether::ControlStatus::InternalError;
+    } else if (topic->layout != req.layout) {
+        resp.status = aether::ControlStatus::LayoutMismatch;
+        resp.layout = topic->layout;
     } else {
-        resp.status   = aether::ControlStatus::Ok;
-        resp.capacity = topic->hdr->capacity;
-        std::strncpy(resp.shm_name, topic->shm_name, aether::MAX_SHM_NAME_LEN - 1);
+        fill_response(resp, *topic);
     }
 
     write(client_fd, &resp, sizeof(resp));
@@ -44,7 +99,8 @@ static void handle_client(int client_fd) {
 // Acceptor loop — runs on dedicated thread
 // ---------------------------------------------------------------------------
 
-static void acceptor_loop() {
+static void acceptor_loop(CpuAffinity cpus) {
+    pin_current_thread(cpus, "acceptor");
     fprintf(stderr, "[aetherd] acceptor listening on %s\n", aether::DAEMON_SOCKET_PATH);
 
     while (true) {
@@ -63,7 +119,7 @@ static void acceptor_loop() {
 // Public API
 // ---------------------------------------------------------------------------
 
-void start_acceptor() {
+void start_acceptor(const DaemonConfig& cfg) {
     unlink(aether::DAEMON_SOCKET_PATH); // remove stale socket from previous run
 
     g_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
@@ -86,7 +142,7 @@ void start_acceptor() {
         std::abort();
     }
 
-    g_acceptor_thread = std::thread(acceptor_loop);
+    g_acceptor_thread = std::thread(acceptor_loop, cfg.acceptor_cpus);
 }
 
 void stop_acceptor() {
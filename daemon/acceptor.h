@@ -1,8 +1,11 @@
 #pragma once
 
-// Start the Unix domain socket acceptor on a dedicated thread.
-// Binds to DAEMON_SOCKET_PATH and handles SubscribeRequest / SubscribeResponse.
-void start_acceptor();
+struct DaemonConfig;
+
+// Start the Unix domain socket acceptor on a dedicated thread, pinned to
+// `cfg.acceptor_cpus`. Binds to DAEMON_SOCKET_PATH and handles
+// SubscribeRequest / SubscribeResponse.
+void start_acceptor(const DaemonConfig& cfg);
 
 // Stop the acceptor thread and clean up the socket file.
 void stop_acceptor();
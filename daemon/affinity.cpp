@@ -0,0 +1,82 @@
+#include "affinity.h"
+
+#include <pthread.h>  // pthread_setaffinity_np
+
+#include <cstdio>
+#include <cstring>
+
+// Parses one CPU number at the front of `text` and consumes it.
+static bool take_cpu(std::string_view& text, int& cpu) {
+    size_t digits = 0;
+    int value = 0;
+    while (digits < text.size() && text[digits] >= '0' && text[digits] <= '9') {
+        value = value * 10 + (text[digits] - '0');
+        if (value >= CPU_SETSIZE) return false;
+        ++digits;
+    }
+    if (digits == 0) return false;
+    text.remove_prefix(digits);
+    cpu = value;
+    return true;
+}
+
+bool parse_cpu_list(std::string_view text, CpuAffinity& out) {
+    CpuAffinity parsed;
+    if (text == "any") {
+        out = parsed;
+        return true;
+    }
+    while (true) {
+        int first = 0;
+        if (!take_cpu(text, first)) return false;
+        int last = first;
+        if (!text.empty() && text.front() == '-') {
+            text.remove_prefix(1);
+            if (!take_cpu(text, last) || last < first) return false;
+        }
+        for (int cpu = first; cpu <= last; ++cpu) CPU_SET(cpu, &parsed.cpus);
+
+        if (text.empty()) break;
+        if (text.front() != ',') return false;
+        text.remove_prefix(1);
+    }
+    parsed.count = CPU_COUNT(&parsed.cpus);
+    out = parsed;
+    return true;
+}
+
+void format_cpu_list(const CpuAffinity& affinity, char (&buf)[64]) {
+    if (affinity.count == 0) {
+        snprintf(buf, sizeof(buf), "any");
+        return;
+    }
+
+    size_t len = 0;
+    buf[0] = '\0';
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+        if (!CPU_ISSET(cpu, &affinity.cpus)) continue;
+        int last = cpu;
+        while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, &affinity.cpus)) ++last;
+
+        char range[24];
+        if (last == cpu) snprintf(range, sizeof(range), "%s%d", len ? "," : "", cpu);
+        else             snprintf(range, sizeof(range), "%s%d-%d", len ? "," : "", cpu, last);
+        if (len + strlen(range) + 1 > sizeof(buf)) {
+            snprintf(buf + len, sizeof(buf) - len, "...");
+            return;
+        }
+        len += static_cast<size_t>(snprintf(buf + len, sizeof(buf) - len, "%s", range));
+        cpu = last;
+    }
+}
+
+void pin_current_thread(const CpuAffinity& affinity, const char* role) {
+    if (affinity.count == 0) return;
+
+    const int rc = pthread_setaffinity_np(pthread_self(), sizeof(affinity.cpus), &affinity.cpus);
+    if (rc != 0) {
+        char cpus[64];
+        format_cpu_list(affinity, cpus);
+        fprintf(stderr, "[aetherd] cannot pin %s thread to CPUs %s: %s\n", role, cpus, strerror(rc));
+    }
+}
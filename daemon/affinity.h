@@ -0,0 +1,26 @@
+#pragma once
+
+#include <sched.h>  // cpu_set_t
+
+#include <string_view>
+
+// CPUs a daemon thread may run on. An empty set leaves the thread wherever
+// the scheduler puts it (it inherits the daemon's own affinity).
+struct CpuAffinity {
+    cpu_set_t cpus;
+    int       count = 0;  // CPUs in `cpus`; 0 = not pinned
+
+    CpuAffinity() { CPU_ZERO(&cpus); }
+};
+
+// Parse a CPU list as in taskset / cpuset: "3", "0-3", "0-3,8,10-11", or
+// "any" for no pinning. Returns false, leaving `out` alone, for anything malformed or out of range.
+bool parse_cpu_list(std::string_view text, CpuAffinity& out);
+
+// Format `affinity` back into a CPU list, or "any" if it is empty.
+void format_cpu_list(const CpuAffinity& affinity, char (&buf)[64]);
+
+// Pin the calling thread to `affinity` (a no-op when empty). `role` names
+// the thread in the warning printed if the kernel refuses, e.g. because
+// every listed CPU is offline; the thread then keeps running unpinned.
+void pin_current_thread(const CpuAffinity& affinity, const char* role);
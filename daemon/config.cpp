@@ -0,0 +1,281 @@
+#include "config.h"
+#include "aether/control.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+
+// ---------------------------------------------------------------------------
+// Value parsing
+// ---------------------------------------------------------------------------
+
+static std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\n' ||
+                          s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// Whole-string unsigned integer; rejects signs, junk and overflow.
+static bool parse_u64(std::string_view s, uint64_t& out) {
+    if (s.empty() || s.size() > 20) return false;
+    char buf[24];
+    std::memcpy(buf, s.data(), s.size());
+    buf[s.size()] = '\0';
+    if (buf[0] < '0' || buf[0] > '9') return false;
+
+    char* end = nullptr;
+    errno = 0;
+    const unsigned long long v = std::strtoull(buf, &end, 10);
+    if (errno != 0 || *end != '\0') return false;
+    out = v;
+    return true;
+}
+
+static bool parse_u32(std::string_view s, uint32_t& out) {
+    uint64_t v = 0;
+    if (!parse_u64(s, v) || v > UINT32_MAX) return false;
+    out = static_cast<uint32_t>(v);
+    return true;
+}
+
+static bool parse_bool(std::string_view s, bool& out) {
+    if (s == "on"  || s == "true"  || s == "yes" || s == "1") { out = true;  return true; }
+    if (s == "off" || s == "false" || s == "no"  || s == "0") { out = false; return true; }
+    return false;
+}
+
+// "any" → -1, otherwise a node number.
+static bool parse_numa_node(std::string_view s, int32_t& out) {
+    if (s == "any") { out = -1; return true; }
+    uint32_t node = 0;
+    if (!parse_u32(s, node) || node > INT32_MAX) return false;
+    out = static_cast<int32_t>(node);
+    return true;
+}
+
+static bool parse_slot_layout(std::string_view s, aether::SlotLayout& out) {
+    if (s == "interleaved") { out = aether::SlotLayout::Interleaved; return true; }
+    if (s == "split")       { out = aether::SlotLayout::Split;       return true; }
+    return false;
+}
+
+static bool parse_message_headers(std::string_view s, aether::MessageHeaders& out) {
+    if (s == "none")      { out = aether::MessageHeaders::None;      return true; }
+    if (s == "monotonic") { out = aether::MessageHeaders::Monotonic; return true; }
+    if (s == "tsc")       { out = aether::MessageHeaders::Tsc;       return true; }
+    return false;
+}
+
+static bool parse_capacity(std::string_view s, uint32_t& out) {
+    uint32_t capacity = 0;
+    if (!parse_u32(s, capacity) || capacity == 0 || (capacity & (capacity - 1)) != 0) return false;
+    out = capacity;
+    return true;
+}
+
+static bool parse_slot_size(std::string_view s, uint32_t& out) {
+    uint32_t slot_size = 0;
+    if (!parse_u32(s, slot_size) || slot_size == 0 || slot_size > aether::MAX_SLOT_DATA_SIZE) return false;
+    out = slot_size;
+    return true;
+}
+
+// Megabytes, stored as bytes.
+static bool parse_mb(std::string_view s, uint64_t& out) {
+    uint64_t mb = 0;
+    if (!parse_u64(s, mb) || mb > (UINT64_MAX >> 20)) return false;
+    out = mb << 20;
+    return true;
+}
+
+static bool parse_us(std::string_view s, std::chrono::nanoseconds& out) {
+    uint64_t us = 0;
+    if (!parse_u64(s, us)) return false;
+    out = std::chrono::microseconds(us);
+    return true;
+}
+
+// `param` is what follows "<role>_idle": empty for the mode itself.
+static bool apply_idle_key(std::string_view param, std::string_view value, aether::IdleStrategy& s) {
+    if (param.empty())                return aether::parse_idle_mode(value, s.mode);
+    if (param == "_spins")            return parse_u32(value, s.max_spins);
+    if (param == "_yields")           return parse_u32(value, s.max_yields);
+    if (param == "_min_sleep_us")     return parse_us(value, s.min_sleep);
+    if (param == "_max_sleep_us")     return parse_us(value, s.max_sleep);
+    if (param == "_park_timeout_us")  return parse_us(value, s.park_timeout) && s.park_timeout.count() > 0;
+    return false;
+}
+
+// Keys that may also appear inside a `[topic <name>]` section.
+static bool apply_topic_key(std::string_view key, std::string_view value, TopicConfig& topic) {
+    if (key == "huge_pages") return parse_bool(value, topic.segment.huge_pages);
+    if (key == "prefault")   return parse_bool(value, topic.segment.prefault);
+    if (key == "mlock")      return parse_bool(value, topic.segment.lock);
+    if (key == "dontfork")   return parse_bool(value, topic.segment.dont_fork);
+    if (key == "numa_node")  return parse_numa_node(value, topic.segment.numa_node);
+    if (key == "forwarder_cpus") return parse_cpu_list(value, topic.forwarder_cpus);
+    if (key == "slot_layout")    return parse_slot_layout(value, topic.segment.slot_layout);
+    if (key == "capacity")       return parse_capacity(value, topic.capacity);
+    if (key == "slot_size")      return parse_slot_size(value, topic.segment.slot_size);
+    if (key == "message_headers") return parse_message_headers(value, topic.segment.message_headers);
+    if (key == "arena")          return parse_bool(value, topic.arena);
+    return false;
+}
+
+// Applies one top-level `key = value`. Returns false for an unknown key or bad value.
+static bool apply_key(std::string_view key, std::string_view value, DaemonConfig& cfg) {
+    if (key == "acceptor_cpus")   return parse_cpu_list(value, cfg.acceptor_cpus);
+    if (key == "tcp_server_cpus") return parse_cpu_list(value, cfg.tcp_server_cpus);
+    if (key == "publisher_cpus")  return parse_cpu_list(value, cfg.publisher_cpus);
+    if (key == "arena_size_mb")    return parse_mb(value, cfg.arena_size);
+    if (key == "arena_huge_pages") return parse_bool(value, cfg.arena.huge_pages);
+    if (key == "arena_numa_node")  return parse_numa_node(value, cfg.arena.numa_node);
+    if (key == "warm_restart")     return parse_bool(value, cfg.warm_restart);
+    if (key == "warm_restart_state") {
+        if (!value.starts_with('/')) return false;  // absolute: not relative to where aetherd started
+        cfg.warm_restart_state = std::string(value);
+        return true;
+    }
+
+    struct Role { std::string_view prefix; aether::IdleStrategy* idle; };
+    const Role roles[] = {
+        {"forwarder_idle", &cfg.forwarder_idle},
+        {"publisher_idle", &cfg.publisher_idle},
+    };
+    for (const Role& role : roles) {
+        if (key.starts_with(role.prefix)) {
+            return apply_idle_key(key.substr(role.prefix.size()), value, *role.idle);
+        }
+    }
+    return apply_topic_key(key, value, cfg.topic_defaults);
+}
+
+// `[topic <name>]` → <name>. Empty if `header` is not a well-formed topic section.
+static std::string_view section_topic(std::string_view header) {
+    if (header.size() < 2 || header.front() != '[' || header.back() != ']') return {};
+    header = trim(header.substr(1, header.size() - 2));
+    if (!header.starts_with("topic ")) return {};
+    const std::string_view name = trim(header.substr(6));
+    if (name.size() > aether::MAX_TOPIC_LEN) return {};
+    return name;
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+const TopicConfig& DaemonConfig::topic(std::string_view name) const {
+    for (const auto& [topic_name, topic_cfg] : topics) {
+        if (topic_name == name) return topic_cfg;
+    }
+    return topic_defaults;
+}
+
+bool load_daemon_config(const char* path, DaemonConfig& cfg) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "[aetherd] cannot open config %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    bool ok = true;
+    TopicConfig* section = nullptr;  // inside `[topic <name>]`
+    char line[512];
+    for (int lineno = 1; fgets(line, sizeof(line), f) != nullptr; ++lineno) {
+        std::string_view text(line);
+        if (const size_t hash = text.find('#'); hash != std::string_view::npos) {
+            text = text.substr(0, hash);
+        }
+        text = trim(text);
+        if (text.empty()) continue;
+
+        if (text.front() == '[') {
+            const std::string_view name = section_topic(text);
+            bool duplicate = false;
+            for (const auto& entry : cfg.topics) duplicate |= entry.first == name;
+            if (name.empty() || duplicate) {
+                fprintf(stderr, "[aetherd] %s:%d: %s section '%.*s'\n", path, lineno,
+                        duplicate ? "duplicate" : "invalid",
+                        static_cast<int>(text.size()), text.data());
+                ok = false;
+                section = nullptr;
+                continue;
+            }
+            section = &cfg.topics.emplace_back(std::string(name), cfg.topic_defaults).second;
+            continue;
+        }
+
+        const size_t eq = text.find('=');
+        if (eq == std::string_view::npos) {
+            fprintf(stderr, "[aetherd] %s:%d: expected key = value\n", path, lineno);
+            ok = false;
+            continue;
+        }
+        const std::string_view key   = trim(text.substr(0, eq));
+        const std::string_view value = trim(text.substr(eq + 1));
+        if (section != nullptr ? !apply_topic_key(key, value, *section)
+                               : !apply_key(key, value, cfg)) {
+            fprintf(stderr, "[aetherd] %s:%d: invalid setting '%.*s = %.*s'\n", path, lineno,
+                    static_cast<int>(key.size()), key.data(),
+                    static_cast<int>(value.size()), value.data());
+            ok = false;
+        }
+    }
+
+    fclose(f);
+    return ok;
+}
+
+// One line describing a topic's settings, after `prefix`.
+static void log_topic_config(const char* prefix, const TopicConfig& topic) {
+    char residency[32];
+    aether::format_residency(topic.segment.residency(), residency);
+    char cpus[64];
+    format_cpu_list(topic.forwarder_cpus, cpus);
+    char node[16] = "any";
+    if (topic.segment.numa_node >= 0) snprintf(node, sizeof(node), "%d", topic.segment.numa_node);
+    fprintf(stderr, "%s huge_pages=%s residency=%s numa_node=%s forwarder_cpus=%s slot_layout=%s"
+                    " capacity=%u slot_size=%u message_headers=%s arena=%s\n",
+            prefix, topic.segment.huge_pages ? "on" : "off", residency, node, cpus,
+            topic.segment.slot_layout == aether::SlotLayout::Split ? "split" : "interleaved",
+            topic.capacity, topic.segment.slot_size,
+            aether::message_headers_name(topic.segment.message_headers),
+            topic.arena ? "on" : "off");
+}
+
+void log_daemon_config(const DaemonConfig& cfg) {
+    fprintf(stderr, "[aetherd] idle: forwarder=%s publisher=%s\n",
+            aether::idle_mode_name(cfg.forwarder_idle.mode),
+            aether::idle_mode_name(cfg.publisher_idle.mode));
+
+    char acceptor[64], tcp_server[64], publisher[64];
+    format_cpu_list(cfg.acceptor_cpus, acceptor);
+    format_cpu_list(cfg.tcp_server_cpus, tcp_server);
+    format_cpu_list(cfg.publisher_cpus, publisher);
+    fprintf(stderr, "[aetherd] cpus: acceptor=%s tcp_server=%s publisher=%s\n",
+            acceptor, tcp_server, publisher);
+
+    if (cfg.arena_size != 0) {
+        char node[16] = "any";
+        if (cfg.arena.numa_node >= 0) snprintf(node, sizeof(node), "%d", cfg.arena.numa_node);
+        fprintf(stderr, "[aetherd] arena: %llu MB huge_pages=%s numa_node=%s\n",
+                static_cast<unsigned long long>(cfg.arena_size >> 20),
+                cfg.arena.huge_pages ? "on" : "off", node);
+    }
+
+    if (cfg.warm_restart) {
+        fprintf(stderr, "[aetherd] warm restart: on (topics survive restarts, state in %s)\n",
+                cfg.warm_restart_state.c_str());
+    }
+
+    log_topic_config("[aetherd] topics:", cfg.topic_defaults);
+    for (const auto& [name, topic] : cfg.topics) {
+        char prefix[96];
+        snprintf(prefix, sizeof(prefix), "[aetherd] topic '%s':", name.c_str());
+        log_topic_config(prefix, topic);
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "affinity.h"
+#include "aether/idle.h"
+#include "aether/shm.h"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Per-topic settings: how the daemon creates the topic's segment, and where
+// the threads forwarding it to TCP subscribers run.
+struct TopicConfig {
+    aether::SegmentOptions segment;   // segment.slot_size: payload bytes per slot
+    uint32_t               capacity = 1024;  // slots in a slot ring
+    CpuAffinity            forwarder_cpus;
+    bool                   arena = true;     // slot ring in the daemon's arena, if it has one
+};
+
+// aetherd settings, read from the file passed with `aetherd -c <path>`.
+// Without a file every field keeps the default below.
+//
+// One `key = value` per line; `#` starts a comment. Idle strategies are set
+// per daemon thread role with `<role>_idle`, and tuned with
+// `<role>_idle_<param>`. The acceptor, TCP server and TCP publisher threads
+// are pinned with `<role>_cpus` (taskset-style CPU lists; default: unpinned):
+//
+//   forwarder_idle                 = park      # busy-spin | yield | backoff | park
+//   forwarder_idle_park_timeout_us = 50000
+//   publisher_idle                 = backoff
+//   publisher_idle_spins           = 100       # backoff: cpu_relax() iterations
+//   publisher_idle_yields          = 10        # backoff: sched_yield() calls
+//   publisher_idle_min_sleep_us    = 1         # backoff: first sleep
+//   publisher_idle_max_sleep_us    = 1000      # backoff: longest sleep
+//   acceptor_cpus                  = 0         # local subscribe handshakes
+//   tcp_server_cpus                = 0         # TCP accept loop
+//   publisher_cpus                 = 1-3       # TCP publisher connections
+//
+// With `arena_size_mb` set, slot topics are carved out of one arena segment
+// (arena.h) instead of getting a segment each, and clients map it once:
+//
+//   arena_size_mb    = 0                       # 0: a segment per topic
+//   arena_huge_pages = off                     # back the arena with huge pages
+//   arena_numa_node  = any                     # bind the arena's memory
+//
+// A topic in the arena takes its backing from these keys rather than its
+// own huge_pages and numa_node. Term-log topics, topics with `arena = off`,
+// and topics created once the arena is full get a segment of their own.
+//
+// With `warm_restart` on, topics outlive the daemon: it leaves their
+// segments (and the arena) in place when it exits, and takes over the ones
+// it finds when it starts, so clients keep publishing and consuming through
+// their mappings while it restarts or is upgraded:
+//
+//   warm_restart     = off                     # on: keep topics across restarts
+//   warm_restart_state = /tmp/aetherd.topics   # ids of multiplexed topics
+//
+// The state file must be owned by the daemon's user and writable by no one
+// else, or it is ignored; point it at a private directory on shared hosts.
+//
+// Topic keys above any section apply to every topic; a `[topic <name>]`
+// section starts from those and overrides them for one topic:
+//
+//   huge_pages = off                           # on | off: back segments with huge pages
+//   prefault   = off                           # populate page tables when mapped
+//   mlock      = off                           # lock mappings in RAM
+//   dontfork   = off                           # MADV_DONTFORK on mappings
+//   numa_node  = any                           # any | <node>: bind the segment's memory
+//   forwarder_cpus = any                       # TCP forwarders of the topic
+//   slot_layout = interleaved                  # interleaved | split (slot topics)
+//   capacity   = 1024                          # slots, a power of two (slot topics)
+//   slot_size  = 4096                          # payload bytes per slot, up to 1 MiB
+//   message_headers = none                     # none | monotonic | tsc: per-message header clock
+//   arena      = on                            # on | off: slot ring in the daemon's arena
+//
+//   [topic prices]
+//   huge_pages = on
+//   prefault   = on
+//   numa_node  = 1
+//   forwarder_cpus = 16-23                     # CPUs of node 1
+//   slot_layout = split
+//   capacity   = 65536
+//   slot_size  = 64
+//   message_headers = tsc
+//
+// A subscriber that creates a topic may ask for its own capacity and slot
+// size (SubscribeRequest); the values here fill in whatever it leaves at 0.
+//
+// The residency keys (prefault, mlock, dontfork) are recorded in the segment
+// and applied by the daemon and by every subscribe() of the topic.
+struct DaemonConfig {
+    // TCP subscriber connections: what a forwarder does while its topic is idle.
+    aether::IdleStrategy forwarder_idle = aether::IdleStrategy::park(std::chrono::milliseconds(50));
+
+    // TCP publisher connections: how a publisher waits while its BackPressure
+    // topic is full. Park has no topic event to wait for and sleeps instead.
+    aether::IdleStrategy publisher_idle = aether::IdleStrategy::backoff();
+
+    CpuAffinity acceptor_cpus;
+    CpuAffinity tcp_server_cpus;
+    CpuAffinity publisher_cpus;
+
+    // Bytes of the arena slot topics are created in; 0 for none. Only
+    // `arena.huge_pages` and `arena.numa_node` are used.
+    uint64_t               arena_size = 0;
+    aether::SegmentOptions arena;
+
+    // Re-register surviving topics at start, keep them at exit.
+    bool warm_restart = false;
+
+    // Where a warm-restart daemon keeps the ids of multiplexed topics.
+    std::string warm_restart_state = "/tmp/aetherd.topics";
+
+    // Topics without a section of their own.
+    TopicConfig topic_defaults;
+
+    // `[topic <name>]` sections, in file order.
+    std::vector<std::pair<std::string, TopicConfig>> topics;
+
+    // Settings for topic `name`: its section, or the defaults.
+    const TopicConfig& topic(std::string_view name) const;
+};
+
+// Read `path` into `cfg`, on top of whatever it already holds.
+// Unknown keys and malformed values are errors: reported on stderr with the
+// line number, and false is returned.
+bool load_daemon_config(const char* path, DaemonConfig& cfg);
+
+// Print the effective settings to stderr at startup.
+void log_daemon_config(const DaemonConfig& cfg);
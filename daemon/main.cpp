@@ -1,4 +1,5 @@
 #include "acceptor.h"
+#include "config.h"
 #include "tcp_server.h"
 #include "topic_registry.h"
 #include "aether/control.h"
@@ -6,6 +7,7 @@
 #include <csignal>   // sigaction, sig_atomic_t
 #include <cstdio>    // fprintf, fopen, fclose
 #include <cstdlib>   // EXIT_FAILURE
+#include <cstring>   // strcmp
 #include <unistd.h>  // sleep, getpid, unlink
 
 // ---------------------------------------------------------------------------
@@ -46,9 +48,26 @@ static bool install_signal_handlers() {
 // Entry point
 // ---------------------------------------------------------------------------
 
-int main() {
+static void usage() {
+    fprintf(stderr, "Usage: aetherd [-c <config file>]\n");
+}
+
+int main(int argc, char* argv[]) {
     fprintf(stderr, "[aetherd] starting\n");
 
+    DaemonConfig config;
+    for (int i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "-c") == 0 || strcmp(argv[i], "--config") == 0) && i + 1 < argc) {
+            if (!load_daemon_config(argv[++i], config)) {
+                return EXIT_FAILURE;
+            }
+        } else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    log_daemon_config(config);
+
     if (!install_signal_handlers()) {
         fprintf(stderr, "[aetherd] failed to install signal handlers\n");
         return EXIT_FAILURE;
@@ -63,8 +82,9 @@ int main() {
 
     fprintf(stderr, "[aetherd] ready (pid %d)\n", getpid());
 
-    start_acceptor();
-    start_tcp_server();
+    configure_topic_registry(config);
+    start_acceptor(config);
+    start_tcp_server(config);
 
     // ---------------------------------------------------------------------------
     // Main loop — runs until SIGTERM is received
@@ -75,6 +95,8 @@ int main() {
             dump_all_topic_stats();
         }
 
+        reap_dead_cursors();
+
         sleep(1); // placeholder — threads will replace this when we add them
     }
 
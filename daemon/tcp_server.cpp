@@ -1,9 +1,12 @@
 #include "tcp_server.h"
 #include "topic_registry.h"
+#include "config.h"
 #include "aether/wire.h"
 #include "aether/ring.h"
 #include "aether/publish.h"
 #include "aether/consume.h"
+#include "aether/packed.h"
+#include "aether/idle.h"
 
 #include <arpa/inet.h>    // htonl, ntohl
 #include <netinet/in.h>   // sockaddr_in
@@ -13,6 +16,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <vector>
 #include <mutex>
@@ -27,27 +33,125 @@ static std::atomic<bool>       g_running{false};
 static std::vector<std::thread> g_client_threads;
 static std::mutex              g_clients_mutex;
 
+// The daemon config, copied at start. Each connection thread works on its
+// own copy of its role's idle strategy — a strategy carries its backoff progress.
+static DaemonConfig            g_config;
+
 // ---------------------------------------------------------------------------
 // Handle a subscribed client: poll the ring and forward messages over TCP
 // ---------------------------------------------------------------------------
 
-static void forward_messages(int fd, aether::RingHeader* hdr) {
-    uint64_t read_seq = hdr->write_seq.load(std::memory_order_relaxed);
-    uint8_t buf[aether::SLOT_DATA_SIZE];
+// Messages forwarded per poll() batch — and per write() to the socket.
+static constexpr uint32_t FORWARD_BATCH = 16;
+
+// Largest Subscribe / Publish body: topic length, topic, and a payload as big
+// as the largest slot any topic may have.
+static constexpr size_t MAX_BODY = aether::MAX_SLOT_DATA_SIZE + aether::MAX_TOPIC_LEN + 4;
+
+// Slot topics: drain a batch with poll() and stage it as wire frames, then
+// send the whole batch in one write(). The staging buffer is sized for a
+// batch of the topic's largest messages. Pieces of a fragmented message are
+// forwarded as they are, one MessageFragment frame each, and reassembled by
+// the client — the forwarder never needs more than a slot per frame. A packed
+// slot is unpacked into one Message frame per record, which the client reads
+// like any other message. The view is copied into the staging
+// buffer (as consume() would copy it), and only the prefix poll() confirmed
+// intact is sent — a torn view never reaches the client.
+// On a BackPressure topic the forwarder holds a cursor for its client and
+// advances it once the batch is written to the socket, so a slow TCP client
+// back-pressures publishers instead of losing messages. A multiplexed topic
+// (`topic_id` non-zero) forwards only the slots tagged with its id. Once a
+// resized topic's old ring is drained, forwarding carries on from the same
+// sequence in its successor.
+static void forward_ring_messages(int fd, aether::RingHeader* hdr, uint16_t topic_id) {
+    uint64_t read_seq = aether::ring_head(hdr);
+    aether::SubscriberCursor* cursor = aether::attach_cursor(hdr, read_seq);
+    if (cursor == nullptr && hdr->policy == aether::OverflowPolicy::BackPressure) {
+        fprintf(stderr, "[aetherd] tcp subscriber: cursor table full, forwarding without back-pressure\n");
+    }
+
+    // A packed record of n bytes takes at least 4 + n in the slot and
+    // 5 + n on the wire, so unpacking grows a slot by at most a quarter.
+    // Resizing keeps the slot size, so the staging buffer fits every ring.
+    const size_t frame_max = sizeof(aether::WireHeader) + 1 + hdr->slot_size +
+                             hdr->slot_size / aether::PACKED_RECORD_ALIGN;
+    std::vector<uint8_t> staging(FORWARD_BATCH * frame_max);
+    size_t frame_end[FORWARD_BATCH];
+    aether::IdleStrategy idle = g_config.forwarder_idle;
+
+    while (g_running.load(std::memory_order_relaxed)) {
+        uint32_t staged = 0;
+        size_t   used   = 0;
+        auto stage = [&](const aether::MessageView& v) {
+            if (v.flags & aether::SLOT_FLAG_PACKED) {
+                for (std::span<const uint8_t> record : aether::packed_records(v.payload)) {
+                    aether::WireHeader whdr{};
+                    whdr.msg_type = aether::MsgType::Message;
+                    whdr.body_len = static_cast<uint32_t>(record.size());
+                    std::memcpy(staging.data() + used, &whdr, sizeof(whdr));
+                    used += sizeof(whdr);
+                    std::memcpy(staging.data() + used, record.data(), record.size());
+                    used += record.size();
+                }
+                frame_end[staged++] = used;
+                return;
+            }
+            const bool fragment = v.flags & aether::SLOT_FLAG_FRAGMENT;
+            aether::WireHeader whdr{};
+            whdr.msg_type = fragment ? aether::MsgType::MessageFragment : aether::MsgType::Message;
+            whdr.body_len = static_cast<uint32_t>(v.payload.size()) + (fragment ? 1 : 0);
+            std::memcpy(staging.data() + used, &whdr, sizeof(whdr));
+            used += sizeof(whdr);
+            if (fragment) {
+                staging[used++] = ((v.flags & aether::SLOT_FLAG_BEGIN) ? aether::WIRE_FRAGMENT_BEGIN : 0) |
+                                  ((v.flags & aether::SLOT_FLAG_END) ? aether::WIRE_FRAGMENT_END : 0);
+            }
+            std::memcpy(staging.data() + used, v.payload.data(), v.payload.size());
+            used += v.payload.size();
+            frame_end[staged++] = used;
+        };
+        const aether::PollResult r = topic_id != 0
+            ? aether::poll(hdr, read_seq, topic_id, stage, FORWARD_BATCH)
+            : aether::poll(hdr, read_seq, stage, FORWARD_BATCH);
+
+        if (r.delivered > 0) {
+            if (!write_exact(fd, staging.data(), frame_end[r.delivered - 1]))
+                break; // client disconnected
+        }
+        // On lapped: poll() already skipped ahead, go again immediately
+        aether::update_cursor(cursor, read_seq);
+        if (r.superseded) {
+            aether::RingHeader* next = successor_ring(hdr);
+            if (next == nullptr) break;
+            cursor = aether::move_cursor(next, hdr, cursor);
+            hdr = next;
+            continue;
+        }
+        idle.idle(r.delivered + r.lapped, hdr, read_seq);
+    }
+
+    aether::detach_cursor(cursor);
+}
+
+// Term-log topics have no batch API — forward one frame per consume().
+// `max_payload` sizes the copy buffer: a log frame can be larger than a slot.
+static void forward_log_messages(int fd, aether::LogHeader* log) {
+    uint64_t position = log->tail_position.load(std::memory_order_relaxed);
+    const uint32_t max_payload = aether::log_max_payload(log->term_length);
+    std::vector<uint8_t> buf(max_payload);
     uint32_t buf_len;
+    aether::IdleStrategy idle = g_config.forwarder_idle;
 
     while (g_running.load(std::memory_order_relaxed)) {
-        buf_len = sizeof(buf);
-        aether::ConsumeResult r = aether::consume(hdr, buf, buf_len, read_seq);
+        buf_len = max_payload;
+        aether::ConsumeResult r = aether::consume(log, buf.data(), buf_len, position);
 
         if (r == aether::ConsumeResult::Ok) {
-            if (!send_msg(fd, aether::MsgType::Message, buf, buf_len))
+            if (!send_msg(fd, aether::MsgType::Message, buf.data(), buf_len))
                 return; // client disconnected
-        } else if (r == aether::ConsumeResult::Lapped) {
-            // skip ahead, try again immediately
-        } else {
-            usleep(100); // 100us — avoid busy spin
         }
+        // On Lapped: skip ahead, try again immediately
+        idle.idle(r == aether::ConsumeResult::Empty ? 0 : 1, log, position);
     }
 }
 
@@ -66,50 +170,264 @@ static bool read_wire_msg(int fd, aether::WireHeader& whdr, uint8_t* body, size_
     return true;
 }
 
-static void handle_publish(const uint8_t* body, uint32_t body_len) {
-    if (body_len < 4) return;
-    uint32_t topic_len;
+// Split a Publish body into topic and payload. Returns false if malformed.
+static bool parse_publish(const uint8_t* body, uint32_t body_len,
+                          const char*& topic_name, uint32_t& topic_len,
+                          const uint8_t*& payload, uint32_t& payload_len) {
+    if (body_len < 4) return false;
     std::memcpy(&topic_len, body, 4);
-    if (4 + topic_len > body_len) return;
+    if (topic_len > body_len - 4) return false;
 
-    const char* topic_name = reinterpret_cast<const char*>(body + 4);
-    const uint8_t* payload = body + 4 + topic_len;
-    const uint32_t payload_len = body_len - 4 - topic_len;
+    topic_name  = reinterpret_cast<const char*>(body + 4);
+    payload     = body + 4 + topic_len;
+    payload_len = body_len - 4 - topic_len;
+    return true;
+}
+
+// Consecutive Publish frames for one topic, published together.
+// Payloads point into the connection's receive buffer.
+static constexpr uint32_t PUBLISH_BATCH = 64;
+
+struct PublishRun {
+    const char*        topic_name = nullptr;
+    uint32_t           topic_len  = 0;
+    uint32_t           count      = 0;
+    aether::PublishVec msgs[PUBLISH_BATCH];
+    aether::IdleStrategy idle = g_config.publisher_idle;  // waiting out back-pressure
+};
+
+// Call `publish_once` on the topic's ring until the topic stops
+// back-pressuring it. The connection stops being read meanwhile, so the
+// back-pressure reaches the remote publisher through TCP flow control.
+// A ring superseded by a resize is swapped for the topic's current one
+// in `topic`, and the publish retried there.
+template <typename Publish>
+static void publish_retrying(aether::IdleStrategy& idle, std::string_view name, TopicInfo& topic,
+                             Publish&& publish_once) {
+    while (g_running.load(std::memory_order_relaxed)) {
+        const aether::PublishResult r = publish_once(topic.hdr);
+        if (r == aether::PublishResult::Superseded) {
+            const std::optional<TopicInfo> current =
+                get_or_create_topic(name.data(), static_cast<uint32_t>(name.size()));
+            if (!current) break;
+            topic = *current;
+            continue;
+        }
+        if (r != aether::PublishResult::BackPressured) break;
+        idle.idle(0); // wait for the slowest subscriber
+    }
+    idle.reset();
+}
 
-    const TopicInfo* topic = get_or_create_topic(topic_name, topic_len);
-    if (topic) {
-        aether::publish(topic->hdr, payload, payload_len);
+// Slot topics take the run with one publish_batch() — one fetch_add on
+// write_seq per burst. A payload larger than the topic's slots splits the
+// batch and is published on its own, so publish() can fragment it.
+// Term-log topics append frame by frame. A multiplexed topic's slots are
+// tagged with its id.
+static void flush_publish_run(PublishRun& run) {
+    if (run.count == 0) return;
+
+    const std::string_view name(run.topic_name, run.topic_len);
+    std::optional<TopicInfo> topic = get_or_create_topic(run.topic_name, run.topic_len);
+    if (topic && topic->log != nullptr) {
+        for (uint32_t i = 0; i < run.count; ++i)
+            aether::publish(topic->log, run.msgs[i].data, run.msgs[i].len);
+    } else if (topic) {
+        aether::MessageMeta meta{};
+        meta.topic_id = topic->topic_id;
+        uint32_t start = 0;
+        for (uint32_t i = 0; i <= run.count; ++i) {
+            if (i < run.count && run.msgs[i].len <= topic->hdr->slot_size) continue;
+
+            const std::span<const aether::PublishVec> msgs(run.msgs + start, i - start);
+            publish_retrying(run.idle, name, *topic, [&](aether::RingHeader* hdr) {
+                return aether::publish_batch(hdr, meta, msgs);
+            });
+            if (i < run.count) {
+                const aether::PublishVec& large = run.msgs[i];
+                publish_retrying(run.idle, name, *topic, [&](aether::RingHeader* hdr) {
+                    return aether::publish(hdr, meta, large.data, large.len);
+                });
+            }
+            start = i + 1;
+        }
+    }
+    run.count = 0;
+}
+
+static void add_to_publish_run(PublishRun& run, const uint8_t* body, uint32_t body_len) {
+    const char* topic_name;
+    uint32_t topic_len;
+    const uint8_t* payload;
+    uint32_t payload_len;
+    if (!parse_publish(body, body_len, topic_name, topic_len, payload, payload_len)) return;
+
+    const bool same_topic = run.count > 0 && run.topic_len == topic_len &&
+                            std::memcmp(run.topic_name, topic_name, topic_len) == 0;
+    if (!same_topic || run.count == PUBLISH_BATCH) {
+        flush_publish_run(run);
+        run.topic_name = topic_name;
+        run.topic_len  = topic_len;
+    }
+    run.msgs[run.count++] = aether::PublishVec{payload, payload_len};
+}
+
+// A message arriving as PublishFragment frames, collected until its END
+// piece and then published whole.
+struct PendingMessage {
+    std::string          topic;
+    std::vector<uint8_t> data;
+    bool                 active = false;
+};
+
+static void add_fragment(PendingMessage& pending, PublishRun& run,
+                         const uint8_t* body, uint32_t body_len) {
+    const char* topic_name;
+    uint32_t topic_len;
+    const uint8_t* payload;
+    uint32_t payload_len;
+    if (!parse_publish(body, body_len, topic_name, topic_len, payload, payload_len) ||
+        payload_len < 1) {
+        return;
+    }
+    const uint8_t flags = payload[0];
+    ++payload;
+    --payload_len;
+
+    if (flags & aether::WIRE_FRAGMENT_BEGIN) {
+        pending.topic.assign(topic_name, topic_len);
+        pending.data.clear();
+        pending.active = true;
+    }
+    // A piece without its beginning, for another topic, or past the largest
+    // message is dropped — and with it the message it belongs to.
+    if (!pending.active || pending.topic != std::string_view(topic_name, topic_len) ||
+        pending.data.size() + payload_len > aether::MAX_MESSAGE_SIZE) {
+        pending.active = false;
+        return;
+    }
+    pending.data.insert(pending.data.end(), payload, payload + payload_len);
+    if (!(flags & aether::WIRE_FRAGMENT_END)) return;
+
+    pending.active = false;
+    std::optional<TopicInfo> topic = get_or_create_topic(pending.topic.data(),
+                                                         static_cast<uint32_t>(pending.topic.size()));
+    if (!topic) return;
+    const auto len = static_cast<uint32_t>(pending.data.size());
+    if (topic->log != nullptr) {
+        aether::publish(topic->log, pending.data.data(), len);
+    } else {
+        aether::MessageMeta meta{};
+        meta.topic_id = topic->topic_id;
+        publish_retrying(run.idle, pending.topic, *topic, [&](aether::RingHeader* hdr) {
+            return aether::publish(hdr, meta, pending.data.data(), len);
+        });
+    }
+}
+
+// Publish or PublishFragment frame: add it to the run, or to the message
+// being reassembled. The run is flushed first, so messages stay in order.
+static void add_publish_frame(PendingMessage& pending, PublishRun& run, aether::MsgType type,
+                              const uint8_t* body, uint32_t body_len) {
+    if (type == aether::MsgType::Publish) {
+        add_to_publish_run(run, body, body_len);
+    } else {
+        flush_publish_run(run);
+        add_fragment(pending, run, body, body_len);
+    }
+}
+
+// Publisher connection: read whatever the socket has buffered, then publish
+// every complete Publish frame in it, grouped into runs per topic. A client
+// streaming messages therefore costs one read() and one publish_batch() per
+// burst rather than two reads and one publish() per message.
+// The receive buffer holds a burst of default-sized messages, and grows when
+// a frame for a topic with larger slots does not fit.
+// Fragment frames are reassembled in a buffer of their own.
+// Returns when the client disconnects or sends anything but Publish or
+// PublishFragment.
+static void handle_publisher(int fd, aether::MsgType first_type,
+                             const uint8_t* first_body, uint32_t first_len) {
+    constexpr size_t RECV_SIZE = 16 * (sizeof(aether::WireHeader) + aether::SLOT_DATA_SIZE +
+                                       aether::MAX_TOPIC_LEN + 4);
+
+    pin_current_thread(g_config.publisher_cpus, "publisher");
+
+    PublishRun run;
+    PendingMessage pending;
+    add_publish_frame(pending, run, first_type, first_body, first_len);
+    flush_publish_run(run);
+
+    std::vector<uint8_t> buf(RECV_SIZE);
+    size_t have = 0;
+
+    while (g_running.load(std::memory_order_relaxed)) {
+        ssize_t n = read(fd, buf.data() + have, buf.size() - have);
+        if (n <= 0) return; // client disconnected
+        have += static_cast<size_t>(n);
+
+        size_t off  = 0;
+        size_t need = 0;  // size of a frame too large for buf
+        bool   done = false;
+        while (have - off >= sizeof(aether::WireHeader)) {
+            aether::WireHeader whdr{};
+            std::memcpy(&whdr, buf.data() + off, sizeof(whdr));
+            if ((whdr.msg_type != aether::MsgType::Publish &&
+                 whdr.msg_type != aether::MsgType::PublishFragment) ||
+                whdr.body_len > MAX_BODY) {
+                done = true;
+                break;
+            }
+            if (have - off < sizeof(whdr) + whdr.body_len) { // partial frame
+                need = sizeof(whdr) + whdr.body_len;
+                break;
+            }
+
+            add_publish_frame(pending, run, whdr.msg_type, buf.data() + off + sizeof(whdr), whdr.body_len);
+            off += sizeof(whdr) + whdr.body_len;
+        }
+
+        // The run points into buf — publish it before compacting.
+        flush_publish_run(run);
+        if (done) return;
+
+        std::memmove(buf.data(), buf.data() + off, have - off);
+        have -= off;
+        if (need > buf.size()) buf.resize(need);
     }
 }
 
 static void handle_subscribe(int fd, const uint8_t* body, uint32_t body_len) {
-    const TopicInfo* topic = get_or_create_topic(
-        reinterpret_cast<const char*>(body), body_len);
+    const char* name = reinterpret_cast<const char*>(body);
+    const std::optional<TopicInfo> topic = get_or_create_topic(name, body_len);
     if (!topic) return;
-    forward_messages(fd, topic->hdr);
+
+    // Forward from CPUs near the topic's memory, if the config says where that is.
+    pin_current_thread(g_config.topic(std::string_view(name, body_len)).forwarder_cpus, "forwarder");
+    if (topic->log != nullptr) {
+        forward_log_messages(fd, topic->log);
+    } else {
+        forward_ring_messages(fd, topic->hdr, topic->topic_id);
+    }
 }
 
 static void handle_tcp_client(int fd) {
-    constexpr size_t MAX_BODY = aether::SLOT_DATA_SIZE + aether::MAX_TOPIC_LEN + 4;
-    uint8_t body[MAX_BODY];
+    std::vector<uint8_t> body(MAX_BODY);  // too large for a thread stack
     aether::WireHeader whdr{};
 
     // Read first message to determine client type
-    if (!read_wire_msg(fd, whdr, body, MAX_BODY)) {
+    if (!read_wire_msg(fd, whdr, body.data(), body.size())) {
         close(fd);
         return;
     }
 
     if (whdr.msg_type == aether::MsgType::Subscribe) {
         // Subscriber: forward ring messages until disconnect
-        handle_subscribe(fd, body, whdr.body_len);
-    } else if (whdr.msg_type == aether::MsgType::Publish) {
+        handle_subscribe(fd, body.data(), whdr.body_len);
+    } else if (whdr.msg_type == aether::MsgType::Publish ||
+               whdr.msg_type == aether::MsgType::PublishFragment) {
         // Publisher: handle messages until disconnect
-        do {
-            handle_publish(body, whdr.body_len);
-            if (!g_running.load(std::memory_order_relaxed)) break;
-            if (!read_wire_msg(fd, whdr, body, MAX_BODY)) break;
-        } while (whdr.msg_type == aether::MsgType::Publish);
+        handle_publisher(fd, whdr.msg_type, body.data(), whdr.body_len);
     }
 
     close(fd);
@@ -120,6 +438,7 @@ static void handle_tcp_client(int fd) {
 // ---------------------------------------------------------------------------
 
 static void server_loop() {
+    pin_current_thread(g_config.tcp_server_cpus, "tcp server");
     fprintf(stderr, "[aetherd] tcp server listening on port %u\n", aether::DEFAULT_TCP_PORT);
 
     while (g_running.load(std::memory_order_relaxed)) {
@@ -145,7 +464,9 @@ static void server_loop() {
 // Public API
 // ---------------------------------------------------------------------------
 
-void start_tcp_server() {
+void start_tcp_server(const DaemonConfig& cfg) {
+    g_config = cfg;
+
     g_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
     if (g_listen_fd < 0) {
         perror("tcp socket");
@@ -4,5 +4,9 @@
 // Runs on a dedicated thread, spawns a thread per client connection.
 // Each client thread bridges the remote client to a local shm ring buffer.
 
-void start_tcp_server();
+struct DaemonConfig;
+
+// Starts accepting connections. Connection threads use the idle strategies
+// and CPU affinities in `cfg`.
+void start_tcp_server(const DaemonConfig& cfg);
 void stop_tcp_server();
@@ -1,26 +1,410 @@
 #include "topic_registry.h"
+#include "config.h"
 #include "aether/shm.h"
+#include "aether/slot_protocol.h"  // ring_sealed, ring_exclusive
 
-#include <sys/mman.h> // shm_unlink
+#include <cerrno>    // errno, ESRCH, EBUSY
+#include <csignal>   // kill
 #include <cstdio>    // fprintf, snprintf
-#include <cstring>   // (transitively needed)
+#include <cstring>   // strerror
+#include <fcntl.h>   // open, O_NOFOLLOW
+#include <sys/stat.h>  // fstat, fchmod
+#include <unistd.h>  // sysconf, geteuid
+#include <algorithm>
+#include <charconv>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
-
-static constexpr uint32_t DEFAULT_TOPIC_CAPACITY = 1024;
+#include <vector>
 
 static std::mutex                               g_mutex;
 static std::unordered_map<std::string, TopicInfo> g_topics;
+static const DaemonConfig*                        g_config = nullptr;
+static aether::ArenaHeader*                       g_arena  = nullptr;
 
-const TopicInfo* get_or_create_topic(const char* name, uint32_t name_len) {
-    std::string key(name, name_len);
+// Rings resize_topic() superseded. Clients may still be draining them or
+// following their forwarding pointers, so they live until shutdown.
+static std::vector<TopicInfo>                     g_superseded;
+
+// With warm_restart, the ids of logical topics — which live only in the
+// registry — are kept in the file DaemonConfig::warm_restart_state names,
+// one "<channel/name> <id>" line per topic, so a restarted daemon hands out
+// the same ids. Rings are found by their names.
+
+// "4K", "2M", "1G" — for logs.
+static void format_page_size(uint32_t page_size, char (&buf)[16]) {
+    if (page_size >= (1u << 30))      snprintf(buf, sizeof(buf), "%uG", page_size >> 30);
+    else if (page_size >= (1u << 20)) snprintf(buf, sizeof(buf), "%uM", page_size >> 20);
+    else                              snprintf(buf, sizeof(buf), "%uK", page_size >> 10);
+}
+
+// "0" / "any" for the node a topic asked for, then "(on 1)" when the kernel
+// reports where its header page actually lives — for logs.
+static void format_numa(int32_t requested, const void* segment, char (&buf)[32]) {
+    const int actual = aether::numa_node_of(segment);
+    char wanted[12] = "any";
+    if (requested >= 0) snprintf(wanted, sizeof(wanted), "%d", requested);
+    if (actual >= 0) snprintf(buf, sizeof(buf), "%s (on %d)", wanted, actual);
+    else             snprintf(buf, sizeof(buf), "%s", wanted);
+}
+
+// ---------------------------------------------------------------------------
+// Warm restart
+// ---------------------------------------------------------------------------
+
+// A ring left behind by the previous daemon: "<key>" for the topic's first
+// ring, "<key>@<epoch>" for the successors resize_topic() created.
+struct SurvivingRing {
+    std::string key;
+    uint32_t    epoch;
+    TopicInfo   info;
+};
+
+// Split a ring name into topic key and epoch. False if it is not one the
+// daemon creates.
+static bool parse_ring_name(std::string_view name, std::string& key, uint32_t& epoch) {
+    epoch = 0;
+    const size_t at = name.find('@');
+    if (at != std::string_view::npos) {
+        const std::string_view digits = name.substr(at + 1);
+        const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), epoch);
+        if (ec != std::errc{} || end != digits.data() + digits.size() || epoch == 0) {
+            return false;
+        }
+        name = name.substr(0, at);
+    }
+    if (name.empty() || name.size() > aether::MAX_TOPIC_LEN) {
+        return false;
+    }
+    key.assign(name);
+    return true;
+}
+
+static void discard_segment(const char* shm_name, const char* why) {
+    fprintf(stderr, "[topic_registry] discarding segment %s: %s\n", shm_name, why);
+    aether::shm_destroy(shm_name);
+}
+
+// Release a surviving ring that is not taken over. A ring in the arena
+// cannot be freed and just stays unused.
+static void discard_ring(const SurvivingRing& ring, const char* why) {
+    if (ring.info.arena_offset != 0) {
+        fprintf(stderr, "[topic_registry] ignoring ring '%s@%u' in arena %s: %s\n",
+                ring.key.c_str(), ring.epoch, aether::DAEMON_ARENA_NAME, why);
+        return;
+    }
+    aether::shm_detach(ring.info.hdr);
+    discard_segment(ring.info.shm_name, why);
+}
+
+// Take over one topic's rings: starting from its first ring, follow the
+// forwarding pointers of superseded rings — each to the ring of the next
+// epoch — to the current one, which must not be sealed. Rings off that
+// chain, such as the successor of a resize that never completed, are
+// dropped. g_mutex must be held.
+static void restore_ring_topic(const std::string& key, const std::vector<SurvivingRing>& rings) {
+    std::vector<const SurvivingRing*> chain;
+    const char* broken = nullptr;
+    for (const SurvivingRing& ring : rings) {
+        if (ring.epoch != 0) continue;
+        if (!chain.empty()) broken = "more than one first ring";
+        chain.push_back(&ring);
+    }
+    if (chain.empty()) broken = "no first ring";
+
+    while (broken == nullptr) {
+        const aether::RingHeader* hdr = chain.back()->info.hdr;
+        if (hdr->successor_seq.load(std::memory_order_acquire) == 0) {
+            if (aether::ring_sealed(hdr)) broken = "sealed by a resize that did not complete";
+            break;
+        }
+        const SurvivingRing* next = nullptr;
+        for (const SurvivingRing& ring : rings) {
+            if (ring.epoch == chain.back()->epoch + 1 && ring.info.arena_offset == hdr->successor_offset &&
+                strncmp(ring.info.shm_name, hdr->successor_name, aether::MAX_SHM_NAME_LEN) == 0) {
+                next = &ring;
+            }
+        }
+        if (next == nullptr) {
+            broken = "successor missing";
+            break;
+        }
+        chain.push_back(next);
+    }
+
+    for (const SurvivingRing& ring : rings) {
+        if (broken != nullptr) {
+            discard_ring(ring, broken);
+        } else if (std::find(chain.begin(), chain.end(), &ring) == chain.end()) {
+            discard_ring(ring, "not on the topic's chain of rings");
+        }
+    }
+    if (broken != nullptr) {
+        return;
+    }
+
+    for (size_t i = 0; i + 1 < chain.size(); ++i) {
+        g_superseded.push_back(chain[i]->info);
+    }
+    TopicInfo info = chain.back()->info;
+    info.layout        = aether::RingLayout::Slots;
+    info.residency     = aether::apply_residency(info.hdr);
+    info.next_topic_id = 1;
+    fprintf(stderr, "[topic_registry] reattached topic '%s' -> %s (%u x %u B slots, epoch %u, "
+                    "at sequence %llu)\n",
+            key.c_str(), info.arena_offset != 0 ? aether::DAEMON_ARENA_NAME : info.shm_name,
+            info.hdr->capacity, info.hdr->slot_size, info.hdr->epoch,
+            static_cast<unsigned long long>(aether::ring_head(info.hdr)));
+    g_topics.emplace(key, info);
+}
+
+// Highest topic id tagged on a slot of `hdr`: the ids a previous daemon
+// handed out on the channel that still have messages in it.
+static uint32_t highest_tagged_id(aether::RingHeader* hdr) {
+    const aether::SlotGeometry slots = aether::slot_geometry(hdr);
+    uint32_t highest = 0;
+    for (uint32_t i = 0; i < hdr->capacity; ++i) {
+        highest = std::max<uint32_t>(highest, aether::slot_topic_id(slots.descriptor(i).flags));
+    }
+    return highest;
+}
+
+// The state file, opened for reading only if it is a regular file that this
+// user owns and nobody else may write — anyone could have planted ids in a
+// shared directory otherwise. nullptr if it is missing or not trusted.
+static FILE* open_logical_topics(const char* path) {
+    const int fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid() ||
+        (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+        fprintf(stderr, "[topic_registry] ignoring %s: not a private file of this user\n", path);
+        close(fd);
+        return nullptr;
+    }
+    FILE* f = fdopen(fd, "r");
+    if (f == nullptr) close(fd);
+    return f;
+}
+
+// The state file opened for writing — rewritten, or appended to — and kept
+// private to this user. nullptr, with errno set, if it cannot be, or
+// belongs to someone else.
+static FILE* write_logical_topics(const char* path, bool append) {
+    const int fd = open(path, O_WRONLY | O_CREAT | O_NOFOLLOW | O_CLOEXEC | (append ? O_APPEND : O_TRUNC),
+                        0600);
+    if (fd == -1) {
+        return nullptr;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid() ||
+        fchmod(fd, 0600) != 0) {
+        close(fd);
+        errno = EPERM;
+        return nullptr;
+    }
+    FILE* f = fdopen(fd, append ? "a" : "w");
+    if (f == nullptr) close(fd);
+    return f;
+}
+
+// Give the logical topics in the state file their ids back on the channels
+// that were reattached, then rewrite the file with just those. An id is
+// reused only for a name on a reattached slot ring that is not multiplexed
+// itself, and only once per channel; ids still tagged on the ring's slots
+// are never handed to a new topic. g_mutex must be held.
+static void restore_logical_topics() {
+    const char* path = g_config->warm_restart_state.c_str();
+
+    for (auto& [key, channel] : g_topics) {
+        if (channel.hdr != nullptr && channel.topic_id == 0) {
+            channel.next_topic_id = std::max(channel.next_topic_id, highest_tagged_id(channel.hdr) + 1);
+        }
+    }
+
+    if (FILE* f = open_logical_topics(path)) {
+        std::map<std::string, std::vector<uint32_t>> taken;  // ids restored, by channel
+        char name[aether::MAX_TOPIC_LEN + 1];
+        unsigned id = 0;
+        while (fscanf(f, "%64s %u", name, &id) == 2) {
+            const std::string key(name);
+            const size_t slash = key.find('/');
+            if (slash == std::string::npos || id == 0 || id > aether::MAX_TOPIC_ID ||
+                g_topics.count(key) != 0) {
+                continue;
+            }
+            const std::string channel_key = key.substr(0, slash);
+            auto channel = g_topics.find(channel_key);
+            if (channel == g_topics.end() || channel->second.hdr == nullptr ||
+                channel->second.topic_id != 0) {
+                continue;
+            }
+            std::vector<uint32_t>& ids = taken[channel_key];
+            if (std::find(ids.begin(), ids.end(), id) != ids.end()) {
+                fprintf(stderr, "[topic_registry] not restoring '%s': topic id %u on '%s' is "
+                                "already taken\n", key.c_str(), id, channel_key.c_str());
+                continue;
+            }
+            ids.push_back(id);
+
+            TopicInfo info = channel->second;
+            info.topic_id      = static_cast<uint16_t>(id);
+            info.next_topic_id = 0;
+            channel->second.next_topic_id = std::max(channel->second.next_topic_id, id + 1);
+            g_topics.emplace(key, info);
+            fprintf(stderr, "[topic_registry] reattached topic '%s' (multiplexed, topic id %u)\n",
+                    key.c_str(), id);
+        }
+        fclose(f);
+    }
+
+    FILE* f = write_logical_topics(path, false);
+    if (f == nullptr) {
+        fprintf(stderr, "[topic_registry] cannot write %s: %s — multiplexed topic ids will not "
+                        "survive a restart\n", path, strerror(errno));
+        return;
+    }
+    for (const auto& [name, info] : g_topics) {
+        if (info.topic_id != 0) fprintf(f, "%s %u\n", name.c_str(), info.topic_id);
+    }
+    fclose(f);
+}
+
+// Find the segments and arena rings a previous daemon left behind, validate
+// them (magic, version, epoch chain) and register them as topics. Whatever
+// does not validate is destroyed, so a topic of that name starts afresh.
+// g_mutex must be held.
+static void restore_topics() {
+    std::map<std::string, std::vector<SurvivingRing>> rings;
+
+    g_arena = aether::shm_attach_arena(aether::DAEMON_ARENA_NAME);
+    if (g_arena != nullptr) {
+        fprintf(stderr, "[topic_registry] reattached arena %s (%llu MB)\n", aether::DAEMON_ARENA_NAME,
+                static_cast<unsigned long long>(g_arena->size >> 20));
+        const uint32_t count = g_arena->ring_count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; ++i) {
+            const aether::ArenaEntry& entry = g_arena->directory[i];
+            SurvivingRing ring{};
+            if (!parse_ring_name(std::string_view(entry.name, entry.name_len), ring.key, ring.epoch)) {
+                continue;
+            }
+            ring.info.hdr = reinterpret_cast<aether::RingHeader*>(
+                reinterpret_cast<uint8_t*>(g_arena) + entry.offset);
+            ring.info.arena_offset = entry.offset;
+            snprintf(ring.info.shm_name, aether::MAX_SHM_NAME_LEN, "%s", aether::DAEMON_ARENA_NAME);
+            if (ring.info.hdr->epoch != ring.epoch) {
+                discard_ring(ring, "epoch does not match its name");
+                continue;
+            }
+            rings[ring.key].push_back(ring);
+        }
+    }
+
+    for (const std::string& shm_name : aether::shm_list("/aether_")) {
+        const char* name = shm_name.c_str();
+        SurvivingRing ring{};
+        if (!parse_ring_name(std::string_view(shm_name).substr(strlen("/aether_")), ring.key, ring.epoch)) {
+            discard_segment(name, "not a topic name");
+            continue;
+        }
+        snprintf(ring.info.shm_name, aether::MAX_SHM_NAME_LEN, "%s", name);
+
+        ring.info.hdr = aether::shm_attach(name);
+        if (ring.info.hdr == nullptr) {
+            aether::LogHeader* log = ring.epoch == 0 ? aether::shm_attach_log(name) : nullptr;
+            if (log == nullptr) {
+                discard_segment(name, "bad magic, version or geometry");
+                continue;
+            }
+            TopicInfo info = ring.info;
+            info.layout    = aether::RingLayout::TermLog;
+            info.log       = log;
+            info.residency = aether::apply_residency(log);
+            fprintf(stderr, "[topic_registry] reattached topic '%s' -> %s (term log)\n",
+                    ring.key.c_str(), name);
+            g_topics.emplace(ring.key, info);
+            continue;
+        }
+        if (ring.info.hdr->epoch != ring.epoch) {
+            discard_ring(ring, "epoch does not match its name");
+            continue;
+        }
+        rings[ring.key].push_back(ring);
+    }
+
+    for (auto& [key, chain] : rings) {
+        if (g_topics.count(key) != 0) {  // a term log took the name
+            for (const SurvivingRing& ring : chain) discard_ring(ring, "topic is a term log");
+            continue;
+        }
+        restore_ring_topic(key, chain);
+    }
+    restore_logical_topics();
+}
 
+void configure_topic_registry(const DaemonConfig& cfg) {
     std::lock_guard<std::mutex> lock(g_mutex);
+    g_config = &cfg;
+    if (cfg.warm_restart && g_topics.empty()) {
+        restore_topics();
+    }
+    if (cfg.arena_size == 0 || g_arena != nullptr) {
+        return;
+    }
 
-    auto it = g_topics.find(key);
-    if (it != g_topics.end()) {
-        return &it->second;
+    aether::shm_destroy(aether::DAEMON_ARENA_NAME);  // stale arena from a previous crash
+    g_arena = aether::shm_create_arena(aether::DAEMON_ARENA_NAME, cfg.arena_size, cfg.arena);
+    if (g_arena == nullptr) {
+        fprintf(stderr, "[topic_registry] failed to create arena %s: %s — "
+                        "topics get segments of their own\n",
+                aether::DAEMON_ARENA_NAME, strerror(errno));
+        return;
+    }
+    char pages[16];
+    format_page_size(g_arena->page_size, pages);
+    fprintf(stderr, "[topic_registry] created arena %s (%llu MB, %s pages)\n",
+            aether::DAEMON_ARENA_NAME, static_cast<unsigned long long>(g_arena->size >> 20), pages);
+}
+
+// Create the slot ring of `info`, whose shm_name is set: in the arena as
+// `arena_name` if there is one and the topic may use it, else as segment
+// info.shm_name. Fills hdr, and shm_name and arena_offset for an arena ring.
+// g_mutex must be held.
+static bool create_ring(TopicInfo& info, const char* arena_name, uint32_t arena_name_len,
+                        uint32_t capacity, aether::OverflowPolicy policy, const TopicConfig& topic_cfg) {
+    if (g_arena != nullptr && topic_cfg.arena) {
+        info.hdr = aether::arena_create_ring(g_arena, arena_name, arena_name_len, capacity, policy,
+                                             topic_cfg.segment);
+        if (info.hdr != nullptr) {
+            info.arena_offset = static_cast<uint64_t>(reinterpret_cast<uint8_t*>(info.hdr) -
+                                                      reinterpret_cast<uint8_t*>(g_arena));
+            snprintf(info.shm_name, aether::MAX_SHM_NAME_LEN, "%s", aether::DAEMON_ARENA_NAME);
+            return true;
+        }
+        fprintf(stderr, "[topic_registry] no room in arena for ring '%.*s' (%s) — "
+                        "creating a segment of its own\n",
+                static_cast<int>(arena_name_len), arena_name, strerror(errno));
+    }
+    info.hdr = aether::shm_create(info.shm_name, capacity, policy, topic_cfg.segment);
+    return info.hdr != nullptr;
+}
+
+// Create a topic with a ring or log of its own — in the arena, if there is
+// one and the topic may use it. g_mutex must be held.
+static TopicInfo* create_topic(const std::string& key, aether::RingLayout layout,
+                               aether::OverflowPolicy policy, uint32_t capacity, uint32_t slot_size) {
+    const char*    name     = key.data();
+    const uint32_t name_len = static_cast<uint32_t>(key.size());
+
+    // "/aether_<topic>@<epoch>" names the rings that resize_topic() creates.
+    if (key.find('@') != std::string::npos) {
+        fprintf(stderr, "[topic_registry] topic name may not contain '@': %s\n", key.c_str());
+        return nullptr;
     }
 
     // Construct shm_name = "/aether_<topic>"
@@ -33,47 +417,415 @@ const TopicInfo* get_or_create_topic(const char* name, uint32_t name_len) {
         return nullptr;
     }
 
-    shm_unlink(info.shm_name); // remove any stale segment from a previous crash
-    info.hdr = aether::shm_create(info.shm_name, DEFAULT_TOPIC_CAPACITY);
-    if (info.hdr == nullptr) {
+    TopicConfig topic_cfg = g_config != nullptr ? g_config->topic(key) : TopicConfig{};
+    if (capacity != 0)  topic_cfg.capacity          = capacity;
+    if (slot_size != 0) topic_cfg.segment.slot_size = slot_size;
+
+    aether::shm_destroy(info.shm_name); // remove any stale segment from a previous crash
+    info.layout = layout;
+    if (layout == aether::RingLayout::TermLog) {
+        info.log = aether::shm_create_log(info.shm_name, aether::LOG_DEFAULT_TERM_LENGTH,
+                                          topic_cfg.segment);
+    } else {
+        create_ring(info, name, name_len, topic_cfg.capacity, policy, topic_cfg);
+    }
+    if (info.hdr == nullptr && info.log == nullptr) {
         fprintf(stderr, "[topic_registry] failed to create shm for topic: %.*s\n",
                 static_cast<int>(name_len), name);
         return nullptr;
     }
 
-    fprintf(stderr, "[topic_registry] created topic '%.*s' -> %s\n",
-            static_cast<int>(name_len), name, info.shm_name);
+    // The daemon holds its mapping for the topic's lifetime, so a locked
+    // topic stays resident even while no client has it mapped.
+    info.residency = info.log != nullptr ? aether::apply_residency(info.log)
+                                         : aether::apply_residency(info.hdr);
+    const uint32_t requested = topic_cfg.segment.residency();
+    if (info.residency != requested) {
+        char wanted[32], got[32];
+        aether::format_residency(requested, wanted);
+        aether::format_residency(info.residency, got);
+        fprintf(stderr, "[topic_registry] residency for topic '%.*s': wanted %s, got %s "
+                        "(mlock needs CAP_IPC_LOCK or a larger RLIMIT_MEMLOCK)\n",
+                static_cast<int>(name_len), name, wanted, got);
+    }
+
+    const uint32_t page_size = info.log != nullptr ? info.log->page_size : info.hdr->page_size;
+    char pages[16];
+    format_page_size(page_size, pages);
+    char residency[32];
+    aether::format_residency(info.residency, residency);
+    char numa[32];
+    if (info.log != nullptr) format_numa(info.log->numa_node, info.log, numa);
+    else                     format_numa(info.hdr->numa_node, info.hdr, numa);
+    char kind[96] = "term log";
+    if (info.hdr != nullptr) {
+        snprintf(kind, sizeof(kind), "%u x %u B %sslots%s%s%s",
+                 info.hdr->capacity, info.hdr->slot_size,
+                 info.hdr->slot_layout == aether::SlotLayout::Split ? "split " : "",
+                 policy == aether::OverflowPolicy::BackPressure ? ", back-pressure" : "",
+                 info.hdr->message_headers != aether::MessageHeaders::None ? ", headers " : "",
+                 info.hdr->message_headers != aether::MessageHeaders::None
+                     ? aether::message_headers_name(info.hdr->message_headers) : "");
+    }
+    char where[96];
+    if (info.arena_offset != 0) {
+        snprintf(where, sizeof(where), "%s at offset %llu", info.shm_name,
+                 static_cast<unsigned long long>(info.arena_offset));
+    } else {
+        snprintf(where, sizeof(where), "%s", info.shm_name);
+    }
+    fprintf(stderr, "[topic_registry] created topic '%.*s' -> %s (%s, %s pages, residency %s, "
+                    "numa node %s)\n",
+            static_cast<int>(name_len), name, where, kind, pages, residency, numa);
+    if (topic_cfg.segment.huge_pages && page_size <= static_cast<uint32_t>(sysconf(_SC_PAGESIZE))) {
+        fprintf(stderr, "[topic_registry] huge pages unavailable for topic '%.*s' "
+                        "(no hugetlbfs at %s, or pool exhausted) — using %s pages\n",
+                static_cast<int>(name_len), name, aether::HUGETLBFS_PATH, pages);
+    }
+
+    if (info.hdr != nullptr) {
+        info.next_topic_id = 1;
+    }
+    auto iter = g_topics.emplace(key, info).first;
+    return &iter->second;
+}
+
+// Create logical topic "channel/name": an id on the channel's ring, which is
+// created first if needed. g_mutex must be held.
+static TopicInfo* create_logical_topic(const std::string& key, size_t channel_len,
+                                       aether::OverflowPolicy policy, uint32_t capacity,
+                                       uint32_t slot_size) {
+    if (channel_len == 0 || channel_len + 1 == key.size()) {
+        fprintf(stderr, "[topic_registry] bad multiplexed topic name: %s\n", key.c_str());
+        return nullptr;
+    }
+
+    const std::string channel_key = key.substr(0, channel_len);
+    TopicInfo* channel = nullptr;
+    auto it = g_topics.find(channel_key);
+    if (it != g_topics.end()) {
+        channel = &it->second;
+    } else {
+        channel = create_topic(channel_key, aether::RingLayout::Slots, policy, capacity, slot_size);
+        if (channel == nullptr) {
+            return nullptr;
+        }
+    }
+    if (channel->hdr == nullptr) {
+        fprintf(stderr, "[topic_registry] cannot multiplex '%s': '%s' is not a slot ring\n",
+                key.c_str(), channel_key.c_str());
+        return nullptr;
+    }
+    if (channel->next_topic_id > aether::MAX_TOPIC_ID) {
+        fprintf(stderr, "[topic_registry] cannot multiplex '%s': all %u topic ids on '%s' are taken\n",
+                key.c_str(), aether::MAX_TOPIC_ID, channel_key.c_str());
+        return nullptr;
+    }
+
+    TopicInfo info = *channel;
+    info.topic_id      = static_cast<uint16_t>(channel->next_topic_id++);
+    info.next_topic_id = 0;
+    fprintf(stderr, "[topic_registry] created topic '%s' -> %s (multiplexed, topic id %u)\n",
+            key.c_str(), info.shm_name, info.topic_id);
+    if (g_config != nullptr && g_config->warm_restart) {
+        if (FILE* f = write_logical_topics(g_config->warm_restart_state.c_str(), true)) {
+            fprintf(f, "%s %u\n", key.c_str(), info.topic_id);
+            fclose(f);
+        }
+    }
 
     auto iter = g_topics.emplace(key, info).first;
     return &iter->second;
 }
 
+std::optional<TopicInfo> get_or_create_topic(const char* name, uint32_t name_len,
+                                             aether::RingLayout layout, aether::OverflowPolicy policy,
+                                             uint32_t capacity, uint32_t slot_size) {
+    std::string key(name, name_len);
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    auto it = g_topics.find(key);
+    if (it != g_topics.end()) {
+        return it->second;
+    }
+
+    const TopicInfo* topic = nullptr;
+    const size_t slash = key.find('/');
+    if (slash == std::string::npos) {
+        topic = create_topic(key, layout, policy, capacity, slot_size);
+    } else if (layout != aether::RingLayout::Slots) {
+        fprintf(stderr, "[topic_registry] multiplexed topic '%s' needs a slot ring\n", key.c_str());
+    } else {
+        topic = create_logical_topic(key, slash, policy, capacity, slot_size);
+    }
+    if (topic == nullptr) {
+        return std::nullopt;
+    }
+    return *topic;
+}
+
+std::optional<TopicInfo> resize_topic(const char* name, uint32_t name_len, uint32_t capacity,
+                                      aether::ControlStatus& status) {
+    std::string key(name, name_len);
+    const size_t slash = key.find('/');
+    if (slash != std::string::npos) {
+        key.resize(slash);  // a logical topic's ring is its channel's
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    auto it = g_topics.find(key);
+    if (it == g_topics.end()) {
+        status = aether::ControlStatus::TopicNotFound;
+        return std::nullopt;
+    }
+    TopicInfo& topic = it->second;
+    if (topic.hdr == nullptr) {
+        status = aether::ControlStatus::LayoutMismatch;
+        return std::nullopt;
+    }
+    aether::RingHeader* old = topic.hdr;
+    if (capacity <= old->capacity || (capacity & (capacity - 1)) != 0) {
+        status = aether::ControlStatus::InvalidGeometry;
+        return std::nullopt;
+    }
+    if (aether::ring_exclusive(old)) {
+        status = aether::ControlStatus::Busy;
+        return std::nullopt;
+    }
+
+    // The successor keeps everything but the capacity. Segment and arena
+    // names carry the epoch, so every ring of the chain stays reachable.
+    const uint32_t epoch = old->epoch + 1;
+    TopicInfo next = topic;
+    next.hdr          = nullptr;
+    next.arena_offset = 0;
+    char arena_name[aether::MAX_TOPIC_LEN + 16];
+    const int arena_name_len = snprintf(arena_name, sizeof(arena_name), "%s@%u", key.c_str(), epoch);
+    const int written = snprintf(next.shm_name, aether::MAX_SHM_NAME_LEN, "/aether_%s@%u",
+                                 key.c_str(), epoch);
+    if (written < 0 || written >= static_cast<int>(aether::MAX_SHM_NAME_LEN)) {
+        fprintf(stderr, "[topic_registry] cannot resize '%s': ring name too long\n", key.c_str());
+        status = aether::ControlStatus::InternalError;
+        return std::nullopt;
+    }
+
+    TopicConfig topic_cfg = g_config != nullptr ? g_config->topic(key) : TopicConfig{};
+    topic_cfg.segment.slot_size       = old->slot_size;
+    topic_cfg.segment.slot_layout     = old->slot_layout;
+    topic_cfg.segment.message_headers = old->message_headers;
+    aether::shm_destroy(next.shm_name);  // stale segment from a previous crash
+    // A name too long for the arena's directory gets a segment of its own.
+    if (!create_ring(next, arena_name, static_cast<uint32_t>(arena_name_len), capacity, old->policy,
+                     topic_cfg)) {
+        fprintf(stderr, "[topic_registry] cannot resize '%s': failed to create its successor: %s\n",
+                key.c_str(), strerror(errno));
+        status = aether::ControlStatus::InternalError;
+        return std::nullopt;
+    }
+
+    if (!aether::shm_supersede(old, next.hdr, next.shm_name, next.arena_offset)) {
+        const int err = errno;
+        fprintf(stderr, "[topic_registry] cannot resize '%s': %s\n", key.c_str(), strerror(err));
+        if (next.arena_offset == 0) {  // never published — arena space is not reclaimed
+            aether::shm_detach(next.hdr);
+            aether::shm_destroy(next.shm_name);
+        }
+        status = err == EBUSY ? aether::ControlStatus::Busy : aether::ControlStatus::InternalError;
+        return std::nullopt;
+    }
+    next.residency = aether::apply_residency(next.hdr);
+
+    // Logical topics on the ring move with it.
+    for (auto& [logical, info] : g_topics) {
+        if (info.topic_id == 0 || info.hdr != old) continue;
+        info.hdr          = next.hdr;
+        info.arena_offset = next.arena_offset;
+        info.residency    = next.residency;
+        memcpy(info.shm_name, next.shm_name, sizeof(info.shm_name));
+    }
+    g_superseded.push_back(topic);
+    topic = next;
+
+    char where[96];
+    if (topic.arena_offset != 0) {
+        snprintf(where, sizeof(where), "%s at offset %llu", topic.shm_name,
+                 static_cast<unsigned long long>(topic.arena_offset));
+    } else {
+        snprintf(where, sizeof(where), "%s", topic.shm_name);
+    }
+    fprintf(stderr, "[topic_registry] resized topic '%s' -> %s (%u -> %u slots, epoch %u, "
+                    "from sequence %llu)\n",
+            key.c_str(), where, old->capacity, capacity, epoch,
+            static_cast<unsigned long long>(old->successor_seq.load(std::memory_order_relaxed)));
+
+    status = aether::ControlStatus::Ok;
+    return topic;
+}
+
+aether::RingHeader* successor_ring(const aether::RingHeader* old) {
+    if (old->successor_seq.load(std::memory_order_acquire) == 0) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    // The successor is the current ring or, after another resize, one of
+    // the superseded ones.
+    auto is_successor = [old](const TopicInfo& info) {
+        return info.hdr != nullptr && info.arena_offset == old->successor_offset &&
+               strncmp(info.shm_name, old->successor_name, aether::MAX_SHM_NAME_LEN) == 0;
+    };
+    for (const auto& [name, info] : g_topics) {
+        if (is_successor(info)) return info.hdr;
+    }
+    for (const TopicInfo& info : g_superseded) {
+        if (is_successor(info)) return info.hdr;
+    }
+    return nullptr;
+}
+
 void destroy_all_topics() {
     std::lock_guard<std::mutex> lock(g_mutex);
 
+    // A warm-restart daemon leaves its segments for the next one.
+    const bool keep = g_config != nullptr && g_config->warm_restart;
+    const char* done = keep ? "kept" : "destroyed";
+
     for (auto& [name, info] : g_topics) {
-        aether::shm_detach(info.hdr);
-        aether::shm_destroy(info.shm_name);
-        fprintf(stderr, "[topic_registry] destroyed topic '%s'\n", name.c_str());
+        if (info.topic_id != 0) {
+            continue;  // its channel's segment goes with the channel
+        }
+        if (info.arena_offset != 0) {
+            fprintf(stderr, "[topic_registry] %s topic '%s'\n", done, name.c_str());
+            continue;  // the arena goes as a whole, below
+        }
+        if (info.log != nullptr) {
+            aether::shm_detach(info.log);
+        } else {
+            aether::shm_detach(info.hdr);
+        }
+        if (!keep) aether::shm_destroy(info.shm_name);
+        fprintf(stderr, "[topic_registry] %s topic '%s'\n", done, name.c_str());
     }
 
     g_topics.clear();
+
+    for (TopicInfo& info : g_superseded) {
+        if (info.arena_offset != 0) continue;
+        aether::shm_detach(info.hdr);
+        if (!keep) aether::shm_destroy(info.shm_name);
+    }
+    g_superseded.clear();
+
+    if (g_arena != nullptr) {
+        aether::shm_detach(g_arena);
+        if (!keep) aether::shm_destroy(aether::DAEMON_ARENA_NAME);
+        g_arena = nullptr;
+        fprintf(stderr, "[topic_registry] %s arena %s\n", done, aether::DAEMON_ARENA_NAME);
+    }
 }
 
 void dump_all_topic_stats() {
     std::lock_guard<std::mutex> lock(g_mutex);
 
+    if (g_arena != nullptr) {
+        fprintf(stderr, "[aetherd] stats: arena=%s size=%llu used=%llu rings=%u/%u\n",
+                aether::DAEMON_ARENA_NAME,
+                static_cast<unsigned long long>(g_arena->size),
+                static_cast<unsigned long long>(g_arena->used),
+                g_arena->ring_count.load(std::memory_order_relaxed), aether::ARENA_MAX_RINGS);
+    }
+
     if (g_topics.empty()) {
         fprintf(stderr, "[aetherd] stats: no topics\n");
         return;
     }
 
     for (auto& [name, info] : g_topics) {
-        const uint64_t total =
-            info.hdr->write_seq.load(std::memory_order_relaxed) - 1;
-        fprintf(stderr, "[aetherd] stats: topic='%s' capacity=%u messages_published=%llu\n",
+        if (info.topic_id != 0) {
+            fprintf(stderr, "[aetherd] stats: topic='%s' multiplexed shm=%s topic_id=%u\n",
+                    name.c_str(), info.shm_name, info.topic_id);
+            continue;
+        }
+
+        char pages[16];
+        format_page_size(info.log != nullptr ? info.log->page_size : info.hdr->page_size, pages);
+        char residency[32];
+        aether::format_residency(info.residency, residency);
+        char numa[32];
+        if (info.log != nullptr) format_numa(info.log->numa_node, info.log, numa);
+        else                     format_numa(info.hdr->numa_node, info.hdr, numa);
+
+        if (info.log != nullptr) {
+            fprintf(stderr, "[aetherd] stats: topic='%s' layout=term_log term_length=%u pages=%s "
+                            "residency=%s numa=%s active_term=%llu bytes_appended=%llu\n",
+                    name.c_str(),
+                    info.log->term_length,
+                    pages,
+                    residency,
+                    numa,
+                    static_cast<unsigned long long>(
+                        info.log->active_term_id.load(std::memory_order_relaxed)),
+                    static_cast<unsigned long long>(
+                        info.log->tail_position.load(std::memory_order_relaxed)));
+            continue;
+        }
+
+        const uint64_t write_seq = aether::ring_head(info.hdr);
+        const bool back_pressure = info.hdr->policy == aether::OverflowPolicy::BackPressure;
+        fprintf(stderr, "[aetherd] stats: topic='%s' capacity=%u epoch=%u slot_size=%u slot_layout=%s "
+                        "message_headers=%s pages=%s residency=%s numa=%s policy=%s "
+                        "messages_published=%llu\n",
                 name.c_str(),
                 info.hdr->capacity,
-                static_cast<unsigned long long>(total));
+                info.hdr->epoch,
+                info.hdr->slot_size,
+                info.hdr->slot_layout == aether::SlotLayout::Split ? "split" : "interleaved",
+                aether::message_headers_name(info.hdr->message_headers),
+                pages,
+                residency,
+                numa,
+                back_pressure ? "back_pressure" : "overwrite",
+                static_cast<unsigned long long>(write_seq - 1));
+        if (!back_pressure) continue;
+
+        // Lag = messages published that this subscriber has not consumed yet.
+        // A lag of `capacity` means it is the one holding publishers back.
+        for (const aether::SubscriberCursor& cursor : info.hdr->cursors) {
+            const uint32_t pid = cursor.pid.load(std::memory_order_relaxed);
+            if (pid == 0) continue;
+            const uint64_t read_seq = cursor.read_seq.load(std::memory_order_relaxed);
+            fprintf(stderr, "[aetherd] stats:   subscriber pid=%u read_seq=%llu lag=%llu\n",
+                    pid,
+                    static_cast<unsigned long long>(read_seq),
+                    static_cast<unsigned long long>(write_seq > read_seq ? write_seq - read_seq : 0));
+        }
+    }
+}
+
+uint32_t reap_dead_cursors() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    uint32_t reaped = 0;
+    for (auto& [name, info] : g_topics) {
+        if (info.hdr == nullptr || info.topic_id != 0 ||
+            info.hdr->policy != aether::OverflowPolicy::BackPressure)
+            continue;
+
+        for (aether::SubscriberCursor& cursor : info.hdr->cursors) {
+            uint32_t pid = cursor.pid.load(std::memory_order_relaxed);
+            if (pid == 0 || kill(static_cast<pid_t>(pid), 0) == 0 || errno != ESRCH)
+                continue;
+            // CAS from the dead pid: if the entry was freed and re-taken in the
+            // meantime, leave the new owner alone.
+            if (cursor.pid.compare_exchange_strong(pid, 0, std::memory_order_release)) {
+                fprintf(stderr, "[topic_registry] freed cursor of dead subscriber pid=%u on '%s'\n",
+                        pid, name.c_str());
+                ++reaped;
+            }
+        }
     }
+    return reaped;
 }
@@ -2,19 +2,80 @@
 
 #include "aether/control.h"
 #include "aether/ring.h"
+#include "aether/term_log.h"
 
+#include <optional>
+
+struct DaemonConfig;
+
+// Exactly one of `hdr` / `log` is non-null, depending on `layout`.
+//
+// A logical topic "channel/name" has no segment of its own: it shares the
+// slot ring of topic "channel", whose TopicInfo it copies, and tags its
+// slots with `topic_id` (see "Multiplexed rings" in consume.h).
 struct TopicInfo {
-    char               shm_name[aether::MAX_SHM_NAME_LEN];
+    char                shm_name[aether::MAX_SHM_NAME_LEN];
+    aether::RingLayout  layout;
     aether::RingHeader* hdr;
+    aether::LogHeader*  log;
+    uint32_t            residency;      // RESIDENCY_* bits in effect for the daemon's mapping
+    uint16_t            topic_id;       // logical topics: tag on the channel's ring; 0 otherwise
+    uint32_t            next_topic_id;  // slot rings: id the next logical topic on it gets
+    uint64_t            arena_offset;   // ring in the daemon's arena (shm_name): hdr's offset; else 0
 };
 
+// Per-topic segment settings for topics created from now on. `cfg` must
+// outlive the registry. Without it every topic gets the defaults. Creates
+// the arena if `cfg` asks for one. With `cfg.warm_restart`, first takes
+// over the topics and arena a previous daemon left behind, destroying any
+// segment that does not validate.
+void configure_topic_registry(const DaemonConfig& cfg);
+
+// The registry hands out copies, taken under its lock: resize_topic() moves
+// a topic to another ring, and a copy keeps describing the ring it was taken
+// from. A holder that gets Superseded from that ring looks the topic up again.
+//
 // Returns the TopicInfo for the given topic name, creating the shm segment
-// if it doesn't exist yet. Returns nullptr if creation fails.
+// with `layout` (and, for slot rings, `policy`, `capacity` and `slot_size`)
+// if it doesn't exist yet. A `capacity` or `slot_size` of 0 takes the topic's
+// configured value. An existing topic is returned as-is, whatever its layout,
+// policy or geometry — callers that care must compare them themselves.
+// A name "channel/name" is a logical topic multiplexed on the slot ring of
+// topic "channel", created with the request's settings if it does not exist;
+// it gets the channel's next topic id, up to aether::MAX_TOPIC_ID of them.
+// Returns nullopt if creation fails.
+// Thread-safe.
+std::optional<TopicInfo> get_or_create_topic(const char* name, uint32_t name_len,
+                                             aether::RingLayout layout = aether::RingLayout::Slots,
+                                             aether::OverflowPolicy policy = aether::OverflowPolicy::Overwrite,
+                                             uint32_t capacity = 0, uint32_t slot_size = 0);
+
+// Grow slot topic `name` to `capacity` slots without dropping anyone: create
+// a larger successor ring and supersede the topic's ring with it (see "Ring
+// migration" in shm.h). A logical topic resizes its channel's ring, for
+// every topic on it. The superseded ring is kept until shutdown.
+// Returns the TopicInfo, now describing the successor, or nullopt with
+// `status` set: TopicNotFound, LayoutMismatch for a term log, InvalidGeometry
+// unless `capacity` is a power of two above the current one, Busy while an
+// ExclusivePublication holds the ring, InternalError if the successor cannot
+// be created.
+// Thread-safe.
+std::optional<TopicInfo> resize_topic(const char* name, uint32_t name_len, uint32_t capacity,
+                                      aether::ControlStatus& status);
+
+// The daemon's mapping of the ring that superseded `old`, or nullptr if
+// `old` is not sealed yet or the registry does not know its successor.
 // Thread-safe.
-const TopicInfo* get_or_create_topic(const char* name, uint32_t name_len);
+aether::RingHeader* successor_ring(const aether::RingHeader* old);
 
-// Detach and destroy all topic shm segments. Call once on daemon shutdown.
+// Detach and destroy all topic shm segments — with warm_restart, only
+// detach them, for the next daemon. Call once on daemon shutdown.
 void destroy_all_topics();
 
-// Print stats for all live topics to stderr.
+// Print stats for all live topics to stderr: page size, residency policy,
+// and the lag of every subscriber cursor on BackPressure topics.
 void dump_all_topic_stats();
+
+// Free cursors whose subscriber process no longer exists, so a crashed
+// subscriber cannot back-pressure its topic forever. Returns how many were freed.
+uint32_t reap_dead_cursors();
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "aether/ring.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>  // memcmp
+
+namespace aether {
+
+// ---------------------------------------------------------------------------
+// Arena — one segment hosting many slot rings
+//
+// A topic with a segment of its own costs a shm_open, an ftruncate and an
+// mmap to create, and another open and mmap in every process that follows
+// it — hundreds of mappings for a process following hundreds of topics. An
+// arena is one large segment, optionally huge-page backed, out of which the
+// daemon carves ring after ring. Its header holds a directory of the rings
+// by name and offset, so a client maps the arena once and from then on
+// finds each ring with a lookup in memory:
+//
+//   [ ArenaHeader + directory ][ ring ][ ring ] ...
+//
+// Every ring starts on a page boundary of the arena and takes whole pages,
+// so residency (apply_residency()) works on one ring at a time. A ring in
+// an arena is an ordinary RingHeader and segment layout — publish(),
+// consume() and poll() do not know the difference — but it is not its own
+// mapping: shm_detach() must not be called on it.
+//
+// One process creates rings in an arena (the daemon, under its registry
+// lock); any number read the directory concurrently. Rings are never freed:
+// an arena lives, and grows, until it is destroyed as a whole.
+// ---------------------------------------------------------------------------
+
+constexpr uint32_t ARENA_MAGIC   = 0x41524E41;  // "ARNA"
+constexpr uint32_t ARENA_VERSION = 1;
+
+// Directory entries in an arena, and the longest ring name one holds.
+constexpr uint32_t ARENA_MAX_RINGS    = 1024;
+constexpr uint32_t ARENA_MAX_NAME_LEN = 64;
+
+struct ArenaEntry {
+    uint64_t offset;    // the ring's RingHeader, in bytes from the arena base
+    uint64_t size;      // bytes reserved for the ring, whole pages
+    uint32_t name_len;
+    char     name[ARENA_MAX_NAME_LEN];  // not null-terminated
+};
+
+struct ArenaHeader {
+    uint32_t magic;      // ARENA_MAGIC
+    uint32_t version;    // ARENA_VERSION
+    uint64_t size;       // bytes in the arena, whole pages
+    uint32_t page_size;  // page backing the arena; rings are aligned to it
+    int32_t  numa_node;  // node the arena is bound to, -1 for first touch
+    uint64_t used;       // bytes handed out so far, header included — creator only
+
+    // Directory entries in use. The creator fills entry `ring_count` and then
+    // publishes it with a release store; readers load it with acquire and
+    // only look at the entries below it.
+    std::atomic<uint32_t> ring_count;
+    uint32_t              reserved;
+
+    ArenaEntry directory[ARENA_MAX_RINGS];
+};
+
+// The ring at `offset` in `arena` — the SubscribeResponse::arena_offset the
+// daemon hands out — or nullptr if no ring of the directory starts there.
+inline RingHeader* arena_ring(ArenaHeader* arena, uint64_t offset) {
+    const uint32_t count = arena->ring_count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (arena->directory[i].offset == offset) {
+            return reinterpret_cast<RingHeader*>(reinterpret_cast<uint8_t*>(arena) + offset);
+        }
+    }
+    return nullptr;
+}
+
+// The ring named `name` in `arena`, or nullptr if it has none.
+inline RingHeader* arena_find_ring(ArenaHeader* arena, const char* name, uint32_t name_len) {
+    const uint32_t count = arena->ring_count.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        const ArenaEntry& entry = arena->directory[i];
+        if (entry.name_len == name_len && memcmp(entry.name, name, name_len) == 0) {
+            return reinterpret_cast<RingHeader*>(reinterpret_cast<uint8_t*>(arena) + entry.offset);
+        }
+    }
+    return nullptr;
+}
+
+} // namespace aether
@@ -1,7 +1,13 @@
 #pragma once
 
 #include "aether/ring.h"
+#include "aether/packed.h"
+#include "aether/term_log.h"
+#include <chrono>
 #include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
 
 namespace aether {
 
@@ -12,13 +18,25 @@ enum class ConsumeResult {
     Lapped, // subscriber fell too far behind, messages were overwritten.
             // read_seq has been advanced to the oldest available message.
             // caller decides whether to continue or treat this as an error.
+    Torn,   // consume_view() only: the handler ran, but the slot was overwritten
+            // while it was reading — whatever it saw may be corrupt.
+            // read_seq has been advanced as for Lapped.
+    TooLarge, // consume() only: the next message is longer than buf_len.
+              // Nothing copied, read_seq (or position) unchanged; buf_len set
+              // to the length needed. The typed consume(view, T&) reports a
+              // message that is not sizeof(T) bytes the same way.
+    Superseded, // slot rings only: the topic was resized and read_seq has reached
+                // the end of this ring. read_seq unchanged — it is the next
+                // sequence of the successor; migrate() the subscription (subscribe.h).
 };
 
 // Attempt to read the next message from the ring buffer.
 //
 // `hdr`      — pointer to the mapped RingHeader
 // `buf`      — caller-provided buffer to copy the message into
-// `buf_len`  — in: capacity of buf (bytes). out: actual bytes written on Ok.
+// `buf_len`  — in: capacity of buf (bytes); hdr->slot_size holds any message
+//              that fits one slot.
+//              out: actual bytes written on Ok, bytes needed on TooLarge.
 // `read_seq` — subscriber's position in the ring. Caller owns this value
 //              and must preserve it between calls. Start at 0.
 //
@@ -26,6 +44,338 @@ enum class ConsumeResult {
 // On Empty:  buf and buf_len unchanged, read_seq unchanged.
 // On Lapped: read_seq advanced to oldest available message, buf unchanged.
 //            Call consume() again immediately to read from the new position.
+// On Superseded: as Empty, but nothing more will ever arrive on this ring.
+// On TooLarge: buf unchanged, buf_len set to the message's length, read_seq
+//            unchanged. Call again with a buffer that large.
+//
+// Slots released by abort() carry no message; consume() steps over them.
+//
+// A message publish() split into fragments is reassembled into buf: it is
+// returned once all of its pieces are committed (Empty until then), and
+// read_seq moves past all of them. Such a message may be longer than
+// hdr->slot_size. Pieces of a message whose beginning was lost to a lap are skipped.
 ConsumeResult consume(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq);
 
+// consume() that also copies out the message's MessageHeader (all zero on a
+// ring created without MessageHeaders) — checked like the payload.
+ConsumeResult consume(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq,
+                      MessageHeader& header);
+
+// ---------------------------------------------------------------------------
+// Zero-copy consume
+// ---------------------------------------------------------------------------
+
+// Read-only view of one message, borrowed straight from the mapped slot.
+// Only valid for the duration of the handler call — copy out anything you
+// need to keep.
+struct MessageView {
+    std::span<const uint8_t> payload;  // points into shared memory
+    uint64_t                 seq;      // sequence number of this message
+    uint32_t                 flags;    // SLOT_FLAG_FRAGMENT / BEGIN / END for one piece
+                                       // of a fragmented message, SLOT_FLAG_PACKED for a
+                                       // slot of packed records, 0 for a whole message
+    const MessageHeader*     header;   // the message's header, nullptr on a ring without
+                                       // MessageHeaders; valid as long as the payload
+};
+
+using ViewHandler = void (*)(const MessageView& view, void* ctx);
+
+// Like consume(), but instead of copying the payload out, calls `handler`
+// with a view of the slot and validates the sequence afterwards.
+// The handler only pays for the bytes it touches.
+//
+// Fragmented messages are not reassembled: each piece is one view, marked
+// in its flags. Use poll() with a FragmentAssembler to receive them whole.
+//
+// On Ok:     handler ran on an intact message, read_seq incremented.
+// On Empty:  handler not called, read_seq unchanged.
+// On Lapped: handler not called, read_seq advanced as in consume().
+// On Torn:   handler ran, but a publisher lapped us while it was reading —
+//            discard anything derived from the view. read_seq advanced.
+ConsumeResult consume_view(RingHeader* hdr, uint64_t& read_seq, ViewHandler handler, void* ctx);
+
+// Convenience overload for lambdas and other callables:
+//
+//   aether::consume_view(hdr, read_seq, [&](const aether::MessageView& v) {
+//       price = *reinterpret_cast<const uint64_t*>(v.payload.data());
+//   });
+template <typename Handler>
+ConsumeResult consume_view(RingHeader* hdr, uint64_t& read_seq, Handler&& handler) {
+    using H = std::remove_reference_t<Handler>;
+    return consume_view(hdr, read_seq,
+        [](const MessageView& view, void* ctx) { (*static_cast<H*>(ctx))(view); },
+        const_cast<void*>(static_cast<const void*>(&handler)));
+}
+
+// ---------------------------------------------------------------------------
+// Batched poll
+// ---------------------------------------------------------------------------
+
+// How many slots ahead of the read position poll() prefetches.
+constexpr uint32_t POLL_PREFETCH_DISTANCE = 4;
+
+struct PollResult {
+    uint32_t delivered;  // handler calls on intact messages
+    uint32_t lapped;     // times the subscriber was lapped (including a torn view)
+    uint64_t lost;       // messages skipped because they were overwritten
+    bool     torn;       // the last handler call saw a torn view (see below)
+    bool     superseded; // caught up with the end of a superseded ring — migrate()
+};
+
+// Drain up to `max_messages` ready messages in one call, calling `handler`
+// with a zero-copy view of each (same view contract as consume_view()).
+//
+// Compared to calling consume() in a loop, poll() loads the ring geometry
+// once, walks slot indices without re-reading the header, prefetches the
+// sequence words POLL_PREFETCH_DISTANCE slots ahead, and crosses the shared
+// library boundary once per batch.
+//
+// Lapping does not end the batch: read_seq jumps to the oldest live message,
+// the skipped count is added to `lost`, and draining continues. Each lap
+// uses up one unit of `max_messages`.
+// A torn view does end it: poll() returns immediately with torn = true, the
+// torn message counted in `lost`, and the handler having been called
+// delivered + 1 times — the last call must be discarded.
+// Returns early, with whatever was delivered, as soon as the ring is empty —
+// with superseded = true if it is empty for good (ConsumeResult::Superseded).
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, ViewHandler handler, void* ctx,
+                uint32_t max_messages);
+
+// Convenience overload for lambdas and other callables.
+template <typename Handler>
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, Handler&& handler, uint32_t max_messages) {
+    using H = std::remove_reference_t<Handler>;
+    return poll(hdr, read_seq,
+        [](const MessageView& view, void* ctx) { (*static_cast<H*>(ctx))(view); },
+        const_cast<void*>(static_cast<const void*>(&handler)), max_messages);
+}
+
+// ---------------------------------------------------------------------------
+// Fragment reassembly
+//
+// poll() hands out the pieces of a fragmented message one by one, as they
+// sit in the ring. Polling through a FragmentAssembler instead delivers each
+// message whole, once all of its pieces are committed:
+//
+//   aether::FragmentAssembler assembler;
+//   aether::poll(hdr, read_seq, assembler, [&](const aether::MessageView& v) { ... }, 64);
+//
+// When the pieces lie back to back in memory — split layout, a slot size
+// that is a multiple of SLOT_ALIGN, and a message that does not wrap past the
+// end of the ring — the view spans them in place: zero-copy, validated
+// afterwards exactly like a single slot. Otherwise they are copied into the
+// assembler's buffer and validated before the handler sees them. Whole
+// messages pass through untouched either way.
+// ---------------------------------------------------------------------------
+
+struct FragmentAssembler {
+    std::vector<uint8_t> buffer;  // reassembly space, grown to the longest copied message
+    MessageHeader        header;  // copied message's header, on rings that have them
+};
+
+// poll() delivering whole messages. The same results as poll(), except that
+// `delivered` counts messages, not slots, and a message still missing pieces
+// ends the batch like an empty ring. Views of reassembled messages carry the
+// sequence of their first piece and flags 0.
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, FragmentAssembler& assembler,
+                ViewHandler handler, void* ctx, uint32_t max_messages);
+
+template <typename Handler>
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, FragmentAssembler& assembler,
+                Handler&& handler, uint32_t max_messages) {
+    using H = std::remove_reference_t<Handler>;
+    return poll(hdr, read_seq, assembler,
+        [](const MessageView& view, void* ctx) { (*static_cast<H*>(ctx))(view); },
+        const_cast<void*>(static_cast<const void*>(&handler)), max_messages);
+}
+
+// ---------------------------------------------------------------------------
+// Packed records
+//
+// A slot committed by a PackedPublication (publish.h) holds many messages.
+// poll() hands it out as one view flagged SLOT_FLAG_PACKED, whose records
+// packed_records() walks:
+//
+//   aether::poll(hdr, read_seq, [&](const aether::MessageView& v) {
+//       for (std::span<const uint8_t> record : aether::packed_records(v.payload)) { ... }
+//   }, 64);
+//
+// Polling through a PackedReader instead delivers one view per record, and
+// counts loss in records: packed slots number their records ring-wide (see
+// PackedSlotHeader), so a gap in the numbering is exactly the records lost
+// to laps and torn views. consume() returns a packed slot's payload as is.
+// ---------------------------------------------------------------------------
+
+struct PackedReader {
+    uint64_t next_record;   // number of the record expected next; 0 until the first packed slot
+    uint64_t lost_records;  // records lost since the reader started
+};
+
+// poll() delivering packed slots record by record. `max_slots` bounds slots,
+// as max_messages does for poll(); `delivered` and `lost` count records.
+// Records carry their slot's sequence and MessageHeader, and flags 0; other
+// slots pass through as poll() would deliver them, each one record. A torn
+// view ends the batch as for poll(), the records delivered from that slot
+// not counted and to be discarded; they count as lost once the next packed
+// slot is seen.
+//
+// Loss is exact with one packing publisher per ring. When several pack
+// concurrently, a slot may be committed ahead of one numbered before it; the
+// gap is counted lost until the earlier-numbered slot arrives.
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, PackedReader& reader, ViewHandler handler,
+                void* ctx, uint32_t max_slots);
+
+template <typename Handler>
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, PackedReader& reader, Handler&& handler,
+                uint32_t max_slots) {
+    using H = std::remove_reference_t<Handler>;
+    return poll(hdr, read_seq, reader,
+        [](const MessageView& view, void* ctx) { (*static_cast<H*>(ctx))(view); },
+        const_cast<void*>(static_cast<const void*>(&handler)), max_slots);
+}
+
+// ---------------------------------------------------------------------------
+// Multiplexed rings
+//
+// Many low-rate logical topics can share one ring instead of each holding a
+// mostly idle ring of its own: the registry hands every logical topic
+// "channel/name" an id on the channel's ring (SubscribeResponse::topic_id),
+// publishers tag each slot with it through MessageMeta::topic_id, and a
+// subscriber polls with its id to see only its own messages:
+//
+//   aether::poll(hdr, read_seq, sub.topic_id, [&](const aether::MessageView& v) { ... }, 64);
+//
+// The id sits in the upper bits of the slot's flags (slot_topic_id()), so a
+// slot of another topic is stepped over on the descriptor alone — its payload
+// is never touched. Stepped-over slots do not count as delivered and use up
+// no budget; after a whole ring's worth of them in one call poll() returns,
+// so the caller's idle strategy gets a turn. read_seq still moves through
+// every slot, so laps, loss and cursors work as on any ring: `lost` counts
+// overwritten slots of every topic, not just the caller's. consume() and the
+// unfiltered poll() deliver every topic's slots.
+// ---------------------------------------------------------------------------
+
+// poll() delivering only slots tagged `topic_id`.
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, ViewHandler handler,
+                void* ctx, uint32_t max_messages);
+
+template <typename Handler>
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, Handler&& handler,
+                uint32_t max_messages) {
+    using H = std::remove_reference_t<Handler>;
+    return poll(hdr, read_seq, topic_id,
+        [](const MessageView& view, void* ctx) { (*static_cast<H*>(ctx))(view); },
+        const_cast<void*>(static_cast<const void*>(&handler)), max_messages);
+}
+
+// poll(..., FragmentAssembler&, ...) delivering only messages tagged `topic_id`.
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, FragmentAssembler& assembler,
+                ViewHandler handler, void* ctx, uint32_t max_messages);
+
+template <typename Handler>
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, FragmentAssembler& assembler,
+                Handler&& handler, uint32_t max_messages) {
+    using H = std::remove_reference_t<Handler>;
+    return poll(hdr, read_seq, topic_id, assembler,
+        [](const MessageView& view, void* ctx) { (*static_cast<H*>(ctx))(view); },
+        const_cast<void*>(static_cast<const void*>(&handler)), max_messages);
+}
+
+// ---------------------------------------------------------------------------
+// Subscriber cursors — BackPressure topics
+//
+// On a topic created with OverflowPolicy::BackPressure, a subscriber that
+// must not lose messages attaches a cursor and keeps it up to date with its
+// read_seq. publish() then refuses (BackPressured) to claim any sequence that
+// would overwrite a message the slowest cursor has not moved past.
+//
+//   SubscriberCursor* cursor = aether::attach_cursor(hdr, read_seq);
+//   while (running) {
+//       aether::poll(hdr, read_seq, handler, 64);
+//       aether::update_cursor(cursor, read_seq);  // done with everything before read_seq
+//   }
+//   aether::detach_cursor(cursor);
+//
+// Publishers only see progress when the cursor is updated, so update it after
+// every batch. A subscriber without a cursor still works but is not protected
+// — it sees Lapped like on an Overwrite topic.
+// ---------------------------------------------------------------------------
+
+// Take a free entry in the ring's cursor table, starting at `read_seq`
+// (normally the current write_seq — attaching further back does not bring
+// overwritten messages back).
+// Returns nullptr if the topic is not a BackPressure topic or all
+// RING_MAX_CURSORS entries are taken.
+SubscriberCursor* attach_cursor(RingHeader* hdr, uint64_t read_seq);
+
+// Publish the subscriber's position: every message before read_seq may now
+// be overwritten. No-op for a null cursor, so Overwrite topics can share the
+// same loop.
+inline void update_cursor(SubscriberCursor* cursor, uint64_t read_seq) {
+    if (cursor != nullptr) {
+        cursor->read_seq.store(read_seq, std::memory_order_release);
+    }
+}
+
+// Free the cursor. Publishers stop waiting for this subscriber.
+// No-op for a null cursor.
+void detach_cursor(SubscriberCursor* cursor);
+
+// The cursor's counterpart on `successor`, the ring that superseded `old`
+// (see "Ring migration" in shm.h), kept at the cursor's read position.
+// shm_supersede() copied the cursor table, so it is normally the entry at
+// the same index; a cursor attached after the copy is attached afresh.
+// The old entry is left as it is — nothing publishes to a sealed ring.
+// Returns nullptr for a null cursor, or if attaching fails.
+SubscriberCursor* move_cursor(RingHeader* successor, const RingHeader* old, SubscriberCursor* cursor);
+
+// Attempt to read the next frame from a term log.
+//
+// Same contract as the slot-ring consume(), except the subscriber's position
+// is a byte offset into the log rather than a message sequence number.
+// `buf`      — should hold log_max_payload(hdr->term_length) bytes, enough
+//              for any frame; a longer frame than buf_len is TooLarge.
+// `position` — start at 0 to read from the beginning of the log, or at the
+//              current tail_position to read only new messages. Padding
+//              frames are skipped transparently.
+//
+// A frame is only overwritten once the log has rotated two terms past it, so
+// instead of re-reading a per-message sequence after the copy, consume()
+// checks the rarely-written active_term_id. On Lapped, position is moved to
+// the start of the oldest term that is still intact.
+ConsumeResult consume(LogHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& position);
+
+// ---------------------------------------------------------------------------
+// Blocking wait
+//
+// Instead of sleeping a fixed interval between empty polls, a subscriber can
+// park on a futex in the segment header until a publisher writes something.
+// Publishers only make the FUTEX_WAKE syscall while a subscriber is actually
+// parked, so the publish path of a busy topic pays one extra load.
+//
+//   while (running) {
+//       const PollResult r = aether::poll(hdr, read_seq, handler, 64);
+//       if (r.delivered == 0 && r.lapped == 0) {
+//           aether::wait_for_message(hdr, read_seq, std::chrono::milliseconds(100));
+//       }
+//   }
+//
+// Both calls may return as soon as a publisher has claimed the next message,
+// shortly before it commits it — the next consume() can still see Empty and
+// should simply be retried. A timeout bounds how long a shutdown flag or
+// other state goes unchecked.
+// ---------------------------------------------------------------------------
+
+// Block until a message at or after `read_seq` has been claimed, or `timeout`
+// passes. Returns false on timeout. Returns immediately if one already has.
+bool wait_for_message(RingHeader* hdr, uint64_t read_seq, std::chrono::nanoseconds timeout);
+bool wait_for_message(LogHeader* hdr, uint64_t position, std::chrono::nanoseconds timeout);
+
+// consume() that blocks while the ring is empty: returns as soon as consume()
+// returns anything but Empty, or Empty once `timeout` has passed.
+ConsumeResult consume_wait(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq,
+                           std::chrono::nanoseconds timeout);
+ConsumeResult consume_wait(LogHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& position,
+                           std::chrono::nanoseconds timeout);
+
 } // namespace aether
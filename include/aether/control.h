@@ -1,5 +1,7 @@
 #pragma once
 
+#include "aether/ring.h"
+
 #include <cstdint>
 
 namespace aether {
@@ -7,6 +9,10 @@ namespace aether {
 constexpr char DAEMON_SOCKET_PATH[] = "/tmp/aetherd.sock";
 constexpr char DAEMON_PID_PATH[]   = "/tmp/aetherd.pid";
 
+// The daemon's arena (arena.h), when it is configured with one. Topic
+// segments are "/aether_<topic>", so no topic name can collide with it.
+constexpr char DAEMON_ARENA_NAME[] = "/aether-arena";
+
 constexpr uint32_t MAX_TOPIC_LEN = 64;
 constexpr uint32_t MAX_SHM_NAME_LEN = 64;
 
@@ -14,17 +20,51 @@ enum class ControlStatus : uint8_t {
     Ok           = 0,
     TopicNotFound = 1,
     InternalError = 2,
+    LayoutMismatch = 3,  // topic exists with a different RingLayout
+    InvalidGeometry = 4, // capacity not a power of two, or slot_size above MAX_SLOT_DATA_SIZE
+    Busy          = 5,   // Resize: the ring is held by an ExclusivePublication
+};
+
+// What a SubscribeRequest asks for.
+enum class ControlOp : uint8_t {
+    Subscribe = 0,  // look the topic up, creating it if needed
+    Resize    = 1,  // grow an existing slot topic to `capacity` slots: the daemon
+                    // supersedes its ring with a larger one ("Ring migration" in shm.h)
+};
+
+// Data-plane layout of a topic's shm segment. Chosen by the first client
+// to subscribe; later subscribers must ask for the same layout.
+enum class RingLayout : uint8_t {
+    Slots   = 0,  // fixed-size slots (RingHeader, ring.h) — the default
+    TermLog = 1,  // rotating term buffers, variable-length frames (LogHeader, term_log.h)
 };
 
 struct SubscribeRequest {
-    uint32_t topic_len;
-    char     topic[MAX_TOPIC_LEN];
+    uint32_t       topic_len;
+    char           topic[MAX_TOPIC_LEN];
+    RingLayout     layout;
+    OverflowPolicy policy;  // Slots only, applied when this request creates the topic
+
+    // Slots only, applied when this request creates the topic. 0 takes the
+    // daemon's configured value for the topic.
+    uint32_t       capacity;   // number of slots, a power of two
+    uint32_t       slot_size;  // payload bytes per slot, at most MAX_SLOT_DATA_SIZE
+
+    // Resize: `capacity` is the new size, larger than the current one; the
+    // topic must exist, and layout, policy and slot_size are ignored. The
+    // response describes the successor ring.
+    ControlOp      op;
 };
 
 struct SubscribeResponse {
-    ControlStatus status;
-    uint32_t      capacity;
-    char          shm_name[MAX_SHM_NAME_LEN];
+    ControlStatus  status;
+    RingLayout     layout;
+    OverflowPolicy policy;      // the topic's actual policy — may differ from the request
+    uint32_t       capacity;    // Slots: number of slots. TermLog: term length in bytes.
+    uint32_t       slot_size;   // Slots: payload bytes per slot. TermLog: 0.
+    char           shm_name[MAX_SHM_NAME_LEN];
+    uint16_t       topic_id;    // "channel/name" topics: tag on the shared ring (consume.h). Else 0.
+    uint64_t       arena_offset;  // non-zero: the ring sits at this offset of arena shm_name
 };
 
 } // namespace aether
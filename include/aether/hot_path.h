@@ -0,0 +1,874 @@
+#pragma once
+
+#include "aether/ring.h"
+#include "aether/slot_protocol.h"
+#include "aether/publish.h"
+#include "aether/consume.h"
+#include "aether/packed.h"
+
+#include <cassert>
+#include <cstring>  // memcpy
+#include <span>
+
+// ---------------------------------------------------------------------------
+// Header-only hot path — publish and consume compiled into the caller
+//
+// aether::publish() / consume() / poll() live in libaether.so: every message
+// is a call through the PLT that the compiler cannot see into, so nothing
+// around it is inlined, hoisted or kept in registers across calls. The
+// functions in aether::hot are the same code — libaether's versions are thin
+// wrappers around them — defined inline here, so an application that
+// includes this header compiles the data path straight into its own loops.
+// hot::poll() and hot::consume_view() additionally take the handler as a
+// template parameter, so it is inlined too instead of called through a
+// function pointer.
+//
+// Same results, same ordering and the same shm layout as the library
+// functions; the two can be mixed freely on one ring, from one process or
+// many. Everything else — subscribe(), shm_create() and attach, cursors,
+// exclusive acquire / release, blocking waits — stays in the library.
+//
+//   #include "aether/hot_path.h"
+//   aether::hot::publish(sub.hdr, &tick, sizeof(tick));
+//   aether::hot::poll(sub.hdr, read_seq, [&](const aether::MessageView& v) { ... }, 64);
+// ---------------------------------------------------------------------------
+
+namespace aether::hot {
+
+// publish() of a message longer than one slot. All pieces are claimed with
+// one claim_sequences(), so they are consecutive and no other producer's
+// message can land between them.
+inline PublishResult publish_fragments(RingHeader* hdr, const MessageMeta& meta, const void* data,
+                                       uint32_t len) {
+    const uint32_t slot_size = hdr->slot_size;
+
+    // Fail fast — no silent truncation.
+    if (len > max_message_length(hdr->capacity, slot_size)) {
+        return PublishResult::TooLarge;
+    }
+
+    const uint32_t count = fragment_count(len, slot_size);
+    uint64_t first;
+    if (!claim_sequences(hdr, count, first)) {
+        return claim_refusal(hdr);
+    }
+
+    const SlotGeometry slots = slot_geometry(hdr);
+    const uint64_t mask = hdr->index_mask;
+    const auto* src = static_cast<const uint8_t*>(data);
+    const uint64_t now = header_now(hdr);  // every piece carries the same header
+
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t seq   = first + i;
+        const uint32_t off   = i * slot_size;
+        const uint32_t piece = len - off < slot_size ? len - off : slot_size;
+        SlotDescriptor& slot = slots.descriptor(seq & mask);
+
+        // As in publish_batch(): a lapped piece is dropped. Its slot holds a
+        // newer sequence, so subscribers see the lap and lose the message
+        // as a whole rather than receive it with a hole.
+        if (!begin_write(slot, seq)) {
+            continue;
+        }
+        memcpy(slots.payload(seq & mask), src + off, piece);
+        write_header(slots.header(seq & mask), now, meta);
+        release_slot(slot, seq, piece, fragment_flags(i, count) | slot_topic_flags(meta.topic_id));
+    }
+
+    wake_subscribers(hdr->wakeup);
+    return PublishResult::Ok;
+}
+
+// See publish(RingHeader*, const MessageMeta&, ...) in publish.h.
+inline PublishResult publish(RingHeader* hdr, const MessageMeta& meta, const void* data, uint32_t len) {
+    assert(hdr != nullptr);
+    assert(data != nullptr);
+
+    if (len > hdr->slot_size) {
+        return publish_fragments(hdr, meta, data, len);
+    }
+
+    uint64_t seq;
+    uint8_t* payload;
+    MessageHeader* header;
+    SlotDescriptor* slot = claim_slot(hdr, seq, payload, header);
+    if (slot == nullptr) {
+        return claim_refusal(hdr);
+    }
+    memcpy(payload, data, len);
+    write_header(header, header_now(hdr), meta);
+    release_slot(*slot, seq, len, slot_topic_flags(meta.topic_id));
+    wake_subscribers(hdr->wakeup);
+
+    return PublishResult::Ok;
+}
+
+// See publish(RingHeader*, ...) in publish.h.
+inline PublishResult publish(RingHeader* hdr, const void* data, uint32_t len) {
+    return hot::publish(hdr, MessageMeta{}, data, len);
+}
+
+// See publish_batch(RingHeader*, const MessageMeta&, ...) in publish.h.
+inline PublishResult publish_batch(RingHeader* hdr, const MessageMeta& meta,
+                                   std::span<const PublishVec> msgs) {
+    assert(hdr != nullptr);
+
+    // Validate the whole burst up front — a sequence that is claimed must be
+    // published, so there is no way to back out half-way through.
+    for (const PublishVec& m : msgs) {
+        assert(m.data != nullptr);
+        if (m.len > hdr->slot_size) {
+            return PublishResult::TooLarge;
+        }
+    }
+    if (msgs.empty()) {
+        return PublishResult::Ok;
+    }
+
+    // One RMW on the shared counter for the whole burst.
+    uint64_t first;
+    if (!claim_sequences(hdr, msgs.size(), first)) {
+        return claim_refusal(hdr);
+    }
+
+    const SlotGeometry slots = slot_geometry(hdr);
+    const uint64_t mask = hdr->index_mask;
+    const uint64_t now  = header_now(hdr);
+    const uint32_t tag  = slot_topic_flags(meta.topic_id);
+    uint64_t index = first & mask;
+
+    for (size_t i = 0; i < msgs.size(); ++i) {
+        SlotDescriptor& slot  = slots.descriptor(index);
+        uint8_t* payload      = slots.payload(index);
+        MessageHeader* header = slots.header(index);
+        index = (index + 1) & mask;
+
+        // A burst has one contiguous range, so a lapped sequence cannot be
+        // re-claimed without reordering the burst. The slot already belongs
+        // to a newer lap — exactly what the overwrite-oldest policy would
+        // have done to this message — so it is dropped.
+        if (!begin_write(slot, first + i)) {
+            continue;
+        }
+        memcpy(payload, msgs[i].data, msgs[i].len);
+        write_header(header, now, meta);
+        release_slot(slot, first + i, msgs[i].len, tag);
+    }
+
+    // One wake-up check for the whole burst.
+    wake_subscribers(hdr->wakeup);
+    return PublishResult::Ok;
+}
+
+// See publish_batch() in publish.h.
+inline PublishResult publish_batch(RingHeader* hdr, std::span<const PublishVec> msgs) {
+    return hot::publish_batch(hdr, MessageMeta{}, msgs);
+}
+
+// Write one slot as the sole writer and step the handle past it. The caller
+// advances write_seq once it has written everything it claimed.
+inline void write_exclusive(ExclusivePublication& pub, const void* data, uint32_t len, uint32_t flags,
+                            uint64_t timestamp, const MessageMeta& meta) {
+    const uint64_t seq = pub.next_seq++;
+    SlotDescriptor& slot  = pub.slots.descriptor(pub.index);
+    uint8_t* payload      = pub.slots.payload(pub.index);
+    MessageHeader* header = pub.slots.header(pub.index);
+    pub.index = (pub.index + 1) & pub.mask;
+
+    // Sole writer: acquire_exclusive() waited out every shared claim, so no
+    // other producer can hold or lap the slot, and the WRITING mark is a
+    // plain store rather than begin_write()'s CAS.
+    slot.sequence.store(seq | SLOT_WRITING, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(payload, data, len);
+    write_header(header, timestamp, meta);
+    release_slot(slot, seq, len, flags | slot_topic_flags(meta.topic_id));
+}
+
+// See publish(ExclusivePublication&, const MessageMeta&, ...) in publish.h.
+// The handle itself is still acquired and released through the library.
+inline PublishResult publish(ExclusivePublication& pub, const MessageMeta& meta, const void* data,
+                             uint32_t len) {
+    assert(pub.hdr != nullptr);
+    assert(data != nullptr);
+
+    const uint32_t count = len > pub.slot_size ? fragment_count(len, pub.slot_size) : 1;
+    if (count > 1 && len > max_message_length(pub.mask + 1, pub.slot_size)) {
+        return PublishResult::TooLarge;
+    }
+    if (pub.hdr->policy == OverflowPolicy::BackPressure &&
+        !below_publish_limit(pub.hdr, pub.next_seq + count)) {
+        return PublishResult::BackPressured;
+    }
+
+    const uint64_t now = header_now(pub.hdr);
+    if (count == 1) {
+        write_exclusive(pub, data, len, 0, now, meta);
+    } else {
+        const auto* src = static_cast<const uint8_t*>(data);
+        for (uint32_t i = 0; i < count; ++i) {
+            const uint32_t off = i * pub.slot_size;
+            write_exclusive(pub, src + off, len - off < pub.slot_size ? len - off : pub.slot_size,
+                            fragment_flags(i, count), now, meta);
+        }
+    }
+
+    // Plain store instead of fetch_add: while we hold the ring the only other
+    // writes to write_seq are refused claims, which this drops. It must keep
+    // the ownership bit, must not overtake the slots it counts, and must be
+    // ordered before wake_subscribers() reads the waiter count — a release
+    // store could still sit in the store buffer while that load runs.
+    pub.hdr->write_seq.store(pub.next_seq | RING_EXCLUSIVE, std::memory_order_seq_cst);
+    wake_subscribers(pub.hdr->wakeup);
+    return PublishResult::Ok;
+}
+
+// See publish(ExclusivePublication&, ...) in publish.h.
+inline PublishResult publish(ExclusivePublication& pub, const void* data, uint32_t len) {
+    return hot::publish(pub, MessageMeta{}, data, len);
+}
+
+// See flush(PackedPublication&) in publish.h.
+inline void flush(PackedPublication& pub) {
+    Claim& claim = pub.claim;
+    if (claim.slot == nullptr) {
+        return;
+    }
+
+    // Number the records. Relaxed: the slot's release store below is what
+    // publishes the PackedSlotHeader along with them.
+    const PackedSlotHeader packed{
+        .first_record = pub.hdr->packed_records.fetch_add(pub.records, std::memory_order_relaxed),
+        .record_count = pub.records,
+        .reserved     = 0,
+    };
+    memcpy(claim.buffer.data(), &packed, sizeof(packed));
+    write_header(claim.header, header_now(pub.hdr), MessageMeta{});
+    release_slot(*claim.slot, claim.seq, pub.used, SLOT_FLAG_PACKED);
+    wake_subscribers(pub.hdr->wakeup);
+    claim.slot = nullptr;
+}
+
+// See pack() in publish.h. Claims a slot once per slot's worth of records;
+// in between, packing a message is two memcpys into memory this thread
+// already owns.
+inline PublishResult pack(PackedPublication& pub, const void* data, uint32_t len) {
+    assert(pub.hdr != nullptr);
+    assert(data != nullptr);
+
+    RingHeader* hdr = pub.hdr;
+    if (len > packed_max_record(hdr->slot_size)) {
+        return PublishResult::TooLarge;
+    }
+    const uint32_t size = packed_record_size(len);
+    if (pub.claim.slot != nullptr && pub.used + size > pub.claim.buffer.size()) {
+        hot::flush(pub);
+    }
+
+    if (pub.claim.slot == nullptr) {
+        uint64_t seq;
+        uint8_t* payload;
+        MessageHeader* header;
+        SlotDescriptor* slot = claim_slot(hdr, seq, payload, header);
+        if (slot == nullptr) {
+            return claim_refusal(hdr);
+        }
+        pub.claim     = Claim{slot, seq, std::span<uint8_t>(payload, hdr->slot_size), hdr, header};
+        pub.used      = sizeof(PackedSlotHeader);
+        pub.records   = 0;
+        pub.opened_ns = header_timestamp(MessageHeaders::Monotonic);
+    }
+
+    uint8_t* record = pub.claim.buffer.data() + pub.used;
+    memcpy(record, &len, sizeof(len));
+    memcpy(record + sizeof(len), data, len);
+    pub.used += size;
+    ++pub.records;
+
+    // Not even an empty record fits any more — commit now rather than on
+    // the next pack().
+    if (pub.used + packed_record_size(0) > pub.claim.buffer.size()) {
+        hot::flush(pub);
+    }
+    return PublishResult::Ok;
+}
+
+// consume(): copy slot `index`'s header out under the same re-check as
+// the payload, if the caller asked for it.
+inline void copy_header(const SlotGeometry& slots, uint64_t index, MessageHeader* out) {
+    if (out == nullptr) {
+        return;
+    }
+    const MessageHeader* header = slots.header(index);
+    *out = header != nullptr ? *header : MessageHeader{};
+}
+
+// ---------------------------------------------------------------------------
+// Fragment reassembly helpers — the reader side of publish_fragments()
+// ---------------------------------------------------------------------------
+
+enum class MessageExtent {
+    Complete,    // every piece committed: `count` slots, `len` bytes in all
+    Incomplete,  // a later piece is not committed yet
+    Lapped,      // a piece was overwritten — the message is lost
+};
+
+// Walk the pieces of the fragmented message whose BEGIN piece is at `first`,
+// up to its END piece. The lengths read here are only trusted once
+// fragments_intact() has confirmed that nothing was overwritten meanwhile.
+inline MessageExtent message_extent(const SlotGeometry& slots, uint32_t mask, uint32_t capacity,
+                                    uint64_t first, uint32_t& count, uint32_t& len) {
+    len = 0;
+    for (uint32_t i = 0; i < capacity; ++i) {
+        const uint64_t seq = first + i;
+        SlotDescriptor& slot = slots.descriptor(seq & mask);
+        const uint64_t cur = slot.sequence.load(std::memory_order_acquire);
+        if (cur != seq) {
+            return (cur & ~SLOT_WRITING) <= seq ? MessageExtent::Incomplete : MessageExtent::Lapped;
+        }
+        len += slot.payload_len;
+        if (slot.flags & SLOT_FLAG_END) {
+            count = i + 1;
+            return MessageExtent::Complete;
+        }
+    }
+    return MessageExtent::Lapped;  // no END within one ring: it was overwritten
+}
+
+// Copy `count` pieces starting at `first` into `dst`, which holds `len`
+// bytes. False if the pieces no longer add up to `len` — one was overwritten.
+inline bool copy_fragments(const SlotGeometry& slots, uint32_t mask, uint64_t first,
+                           uint32_t count, uint8_t* dst, uint32_t len) {
+    uint32_t off = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint64_t index = (first + i) & mask;
+        const uint32_t piece = slots.descriptor(index).payload_len;
+        if (piece > len - off) {
+            return false;
+        }
+        memcpy(dst + off, slots.payload(index), piece);
+        off += piece;
+    }
+    return off == len;
+}
+
+// The seqlock re-check for a whole message: every piece still holds the
+// sequence it was read under. The fence keeps the reads before the checks.
+inline bool fragments_intact(const SlotGeometry& slots, uint32_t mask, uint64_t first,
+                             uint32_t count) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (slots.descriptor((first + i) & mask).sequence.load(std::memory_order_relaxed) !=
+            first + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// True if the pieces lie back to back in the payload pool, so one span
+// covers the message: every piece but the last fills its slot exactly and
+// the message does not wrap past the last slot.
+inline bool fragments_contiguous(const SlotGeometry& slots, uint32_t slot_size, uint32_t capacity,
+                                 uint32_t first_index, uint32_t count) {
+    return slots.payload_stride == slot_size && first_index + count <= capacity;
+}
+
+// See consume(RingHeader*, ...) in consume.h. `header`, if not null,
+// receives the message's MessageHeader (zeroed on a ring without them).
+inline ConsumeResult consume(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq,
+                             MessageHeader* header = nullptr) {
+    assert(hdr != nullptr);
+    assert(buf != nullptr);
+
+    const SlotGeometry slots = slot_geometry(hdr);
+
+    while (true) {
+        const uint64_t index = read_seq & hdr->index_mask;
+        SlotDescriptor& slot = slots.descriptor(index);
+
+        // Load the slot's sequence number with memory_order_acquire.
+        // This is the other half of the release/acquire pair with publish().
+        // If we see seq == read_seq, we are guaranteed to also see the payload
+        // that was written before the producer's memory_order_release store.
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (seq == read_seq) {
+            // An aborted claim holds a sequence but no message — step over it.
+            if (slot.flags & SLOT_FLAG_ABORTED) {
+                ++read_seq;
+                continue;
+            }
+
+            if (slot.flags & SLOT_FLAG_FRAGMENT) {
+                // A piece whose BEGIN we never saw — the rest of a message
+                // lost to a lap. Step over it.
+                if (!(slot.flags & SLOT_FLAG_BEGIN)) {
+                    ++read_seq;
+                    continue;
+                }
+
+                uint32_t count;
+                uint32_t msg_len;
+                switch (message_extent(slots, hdr->index_mask, hdr->capacity, read_seq, count, msg_len)) {
+                    case MessageExtent::Incomplete:
+                        return ConsumeResult::Empty;
+                    case MessageExtent::Lapped:
+                        read_seq = ring_head(hdr) - hdr->capacity;
+                        return ConsumeResult::Lapped;
+                    case MessageExtent::Complete:
+                        break;
+                }
+                // The length summed from the pieces is only reported once
+                // they still hold this message, as on the single-slot path.
+                if (msg_len > buf_len) {
+                    if (!fragments_intact(slots, hdr->index_mask, read_seq, count)) {
+                        read_seq = ring_head(hdr) - hdr->capacity;
+                        return ConsumeResult::Lapped;
+                    }
+                    buf_len = msg_len;
+                    return ConsumeResult::TooLarge;
+                }
+                copy_header(slots, index, header);
+                if (!copy_fragments(slots, hdr->index_mask, read_seq, count,
+                                    static_cast<uint8_t*>(buf), msg_len) ||
+                    !fragments_intact(slots, hdr->index_mask, read_seq, count)) {
+                    read_seq = ring_head(hdr) - hdr->capacity;
+                    return ConsumeResult::Lapped;
+                }
+                buf_len = msg_len;
+                read_seq += count;
+                return ConsumeResult::Ok;
+            }
+
+            // Message is ready. Copy the payload out — if it fits. A length
+            // that does not is only reported once the slot is known to still
+            // hold this sequence: a lapping writer may have changed it.
+            const uint32_t msg_len = slot.payload_len;
+            if (msg_len > buf_len) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_acquire) != seq) {
+                    read_seq = ring_head(hdr) - hdr->capacity;
+                    return ConsumeResult::Lapped;
+                }
+                buf_len = msg_len;
+                return ConsumeResult::TooLarge;
+            }
+            memcpy(buf, slots.payload(index), msg_len);
+            copy_header(slots, index, header);
+
+            // Seqlock-style double-check: verify the slot wasn't overwritten
+            // while we were copying. If sequence changed, the publisher lapped
+            // us mid-read and the payload is potentially corrupted.
+            // The fence keeps the copy's plain loads before the re-check.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t seq_after = slot.sequence.load(std::memory_order_acquire);
+            if (seq_after != seq) {
+                const uint64_t write_seq = ring_head(hdr);
+                read_seq = write_seq - hdr->capacity;
+                return ConsumeResult::Lapped;
+            }
+
+            buf_len = msg_len;
+            ++read_seq;
+            return ConsumeResult::Ok;
+        }
+
+        if ((seq & ~SLOT_WRITING) <= read_seq) {
+            // Slot hasn't been written yet — producer hasn't reached this
+            // sequence number, or is still writing it. Nothing to read —
+            // ever again, if the ring was superseded and this is its end.
+            return ring_drained(hdr, read_seq) ? ConsumeResult::Superseded : ConsumeResult::Empty;
+        }
+
+        // seq > read_seq: we were lapped. The producer has overwritten the slot
+        // we were about to read (and possibly many slots beyond it).
+        // Advance read_seq to the oldest message still in the ring:
+        //   write_seq - capacity = the sequence number of the oldest live slot.
+        // Load write_seq with relaxed ordering — we just need an approximate
+        // value to catch up; the acquire on slot.sequence above is the real fence.
+        const uint64_t write_seq = ring_head(hdr);
+        read_seq = write_seq - hdr->capacity;
+        return ConsumeResult::Lapped;
+    }
+}
+
+// See consume_view() in consume.h. `handler` is any callable taking a
+// const MessageView&.
+template <typename Handler>
+inline ConsumeResult consume_view(RingHeader* hdr, uint64_t& read_seq, Handler&& handler) {
+    assert(hdr != nullptr);
+
+    const SlotGeometry slots = slot_geometry(hdr);
+
+    while (true) {
+        const uint64_t index = read_seq & hdr->index_mask;
+        SlotDescriptor& slot = slots.descriptor(index);
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (seq == read_seq) {
+            if (slot.flags & SLOT_FLAG_ABORTED) {
+                ++read_seq;
+                continue;
+            }
+
+            // Hand out the slot itself — no copy. The handler reads the
+            // payload directly from shared memory.
+            const MessageView view{
+                std::span<const uint8_t>(slots.payload(index), slot.payload_len), seq, slot.flags,
+                slots.header(index)};
+            handler(view);
+
+            // Same seqlock re-check as consume(), only after the handler
+            // instead of after a memcpy: if the sequence moved, a publisher
+            // overwrote the slot while the handler was looking at it.
+            // The fence keeps the handler's plain loads from drifting past
+            // the re-check.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t seq_after = slot.sequence.load(std::memory_order_acquire);
+            if (seq_after != seq) {
+                const uint64_t write_seq = ring_head(hdr);
+                read_seq = write_seq - hdr->capacity;
+                return ConsumeResult::Torn;
+            }
+
+            ++read_seq;
+            return ConsumeResult::Ok;
+        }
+
+        if ((seq & ~SLOT_WRITING) <= read_seq) {
+            return ring_drained(hdr, read_seq) ? ConsumeResult::Superseded : ConsumeResult::Empty;
+        }
+
+        const uint64_t write_seq = ring_head(hdr);
+        read_seq = write_seq - hdr->capacity;
+        return ConsumeResult::Lapped;
+    }
+}
+
+// A filtered poll() stepping over a committed slot of another topic. The
+// topic was read from the flags like a payload, so it only counts if the
+// slot still holds `seq` afterwards — a slot lapped in between may have shown
+// the next lap's topic, and skipping it would lose a message silently.
+// Returns false if the slot was lapped.
+inline bool skip_other_topic(const SlotDescriptor& slot, uint64_t seq) {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == seq;
+}
+
+// The loop behind poll(). With Filtered, committed slots not tagged
+// `topic_id` are stepped over instead of handed to the handler.
+template <bool Filtered, typename Handler>
+inline PollResult poll_views(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, Handler&& handler,
+                             uint32_t max_messages) {
+    assert(hdr != nullptr);
+
+    PollResult result{};
+    uint32_t   skipped = 0;  // other topics' slots stepped over this call
+
+    // Geometry is immutable — load it once for the whole batch.
+    const SlotGeometry slots    = slot_geometry(hdr);
+    const uint32_t     capacity = hdr->capacity;
+    const uint32_t     mask     = hdr->index_mask;
+
+    uint32_t index = static_cast<uint32_t>(read_seq & mask);
+
+    auto advance = [&](uint32_t& i) { i = (i + 1) & mask; };
+
+    // A lap (or torn view) moves read_seq to the oldest live message and
+    // counts everything in between as lost.
+    auto skip_to_oldest = [&]() {
+        const uint64_t oldest = ring_head(hdr) - capacity;
+        if (oldest > read_seq) {
+            result.lost += oldest - read_seq;
+            read_seq = oldest;
+        }
+        ++result.lapped;
+        index = static_cast<uint32_t>(read_seq & mask);
+    };
+
+    // Laps count against the budget too, so a publisher that keeps lapping
+    // us cannot pin the caller inside poll().
+    while (result.delivered + result.lapped < max_messages) {
+        // Pull the sequence line of a slot a few messages ahead into cache
+        // while we work on this one. Read-only, moderate temporal locality.
+        // With split descriptors that line holds the next few slots as well.
+        const uint32_t ahead = (index + POLL_PREFETCH_DISTANCE) & mask;
+        __builtin_prefetch(&slots.descriptor(ahead).sequence, 0, 1);
+
+        SlotDescriptor& slot = slots.descriptor(index);
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (seq == read_seq) {
+            const uint32_t flags = slot.flags;
+            if (flags & SLOT_FLAG_ABORTED) {
+                ++read_seq;
+                advance(index);
+                continue;
+            }
+            if constexpr (Filtered) {
+                if (slot_topic_id(flags) != topic_id) {
+                    if (!skip_other_topic(slot, seq)) {
+                        skip_to_oldest();
+                        continue;
+                    }
+                    ++read_seq;
+                    advance(index);
+                    if (++skipped == capacity) {
+                        break;  // a whole ring of other topics — let the caller back off
+                    }
+                    continue;
+                }
+            }
+
+            const MessageView view{
+                std::span<const uint8_t>(slots.payload(index), slot.payload_len), seq, flags,
+                slots.header(index)};
+            handler(view);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != seq) {
+                result.torn = true;
+                skip_to_oldest();
+                return result;
+            }
+
+            ++result.delivered;
+            ++read_seq;
+            advance(index);
+            continue;
+        }
+
+        if ((seq & ~SLOT_WRITING) <= read_seq) {
+            result.superseded = ring_drained(hdr, read_seq);
+            break; // caught up — nothing more to read
+        }
+
+        skip_to_oldest();
+    }
+
+    return result;
+}
+
+// The loop behind poll(..., FragmentAssembler&, ...): poll_views(), with
+// fragmented messages delivered whole.
+template <bool Filtered, typename Handler>
+inline PollResult poll_messages(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id,
+                                FragmentAssembler& assembler, Handler&& handler, uint32_t max_messages) {
+    assert(hdr != nullptr);
+
+    PollResult result{};
+    uint32_t   skipped = 0;
+
+    const SlotGeometry slots     = slot_geometry(hdr);
+    const uint32_t     capacity  = hdr->capacity;
+    const uint32_t     mask      = hdr->index_mask;
+    const uint32_t     slot_size = hdr->slot_size;
+
+    uint32_t index = static_cast<uint32_t>(read_seq & mask);
+
+    auto skip_to_oldest = [&]() {
+        const uint64_t oldest = ring_head(hdr) - capacity;
+        if (oldest > read_seq) {
+            result.lost += oldest - read_seq;
+            read_seq = oldest;
+        }
+        ++result.lapped;
+        index = static_cast<uint32_t>(read_seq & mask);
+    };
+
+    while (result.delivered + result.lapped < max_messages) {
+        const uint32_t ahead = (index + POLL_PREFETCH_DISTANCE) & mask;
+        __builtin_prefetch(&slots.descriptor(ahead).sequence, 0, 1);
+
+        SlotDescriptor& slot = slots.descriptor(index);
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (seq != read_seq) {
+            if ((seq & ~SLOT_WRITING) <= read_seq) {
+                result.superseded = ring_drained(hdr, read_seq);
+                break; // caught up — nothing more to read
+            }
+            skip_to_oldest();
+            continue;
+        }
+
+        const uint32_t flags = slot.flags;
+        if constexpr (Filtered) {
+            // Every piece of a fragmented message carries its topic, so
+            // another topic's message is stepped over piece by piece.
+            if (slot_topic_id(flags) != topic_id && !(flags & SLOT_FLAG_ABORTED)) {
+                if (!skip_other_topic(slot, seq)) {
+                    skip_to_oldest();
+                    continue;
+                }
+                ++read_seq;
+                index = (index + 1) & mask;
+                if (++skipped == capacity) {
+                    break;
+                }
+                continue;
+            }
+        }
+        if ((flags & SLOT_FLAG_ABORTED) ||
+            ((flags & SLOT_FLAG_FRAGMENT) && !(flags & SLOT_FLAG_BEGIN))) {
+            // No message, or a piece of one whose beginning was lapped.
+            ++read_seq;
+            index = (index + 1) & mask;
+            continue;
+        }
+
+        if (!(flags & SLOT_FLAG_FRAGMENT)) {
+            const MessageView view{
+                std::span<const uint8_t>(slots.payload(index), slot.payload_len), seq, flags,
+                slots.header(index)};
+            handler(view);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != seq) {
+                result.torn = true;
+                skip_to_oldest();
+                return result;
+            }
+            ++result.delivered;
+            ++read_seq;
+            index = (index + 1) & mask;
+            continue;
+        }
+
+        uint32_t count;
+        uint32_t len;
+        const MessageExtent extent = message_extent(slots, mask, capacity, read_seq, count, len);
+        if (extent == MessageExtent::Incomplete) {
+            break; // the rest of the message is still being written
+        }
+        if (extent == MessageExtent::Lapped) {
+            skip_to_oldest();
+            continue;
+        }
+
+        if (fragments_contiguous(slots, slot_size, capacity, index, count)) {
+            // Zero-copy: one view over all the pieces, checked afterwards.
+            const MessageView view{std::span<const uint8_t>(slots.payload(index), len), seq, 0,
+                                   slots.header(index)};
+            handler(view);
+            if (!fragments_intact(slots, mask, read_seq, count)) {
+                result.torn = true;
+                skip_to_oldest();
+                return result;
+            }
+        } else {
+            // Copied and checked before the handler sees it, so it cannot tear.
+            if (assembler.buffer.size() < len) {
+                assembler.buffer.resize(len);
+            }
+            copy_header(slots, index, &assembler.header);
+            if (!copy_fragments(slots, mask, read_seq, count, assembler.buffer.data(), len) ||
+                !fragments_intact(slots, mask, read_seq, count)) {
+                skip_to_oldest();
+                continue;
+            }
+            const MessageView view{std::span<const uint8_t>(assembler.buffer.data(), len), seq, 0,
+                                   slots.headers != nullptr ? &assembler.header : nullptr};
+            handler(view);
+        }
+
+        ++result.delivered;
+        read_seq += count;
+        index = static_cast<uint32_t>(read_seq & mask);
+    }
+
+    return result;
+}
+
+// See poll() in consume.h. `handler` is any callable taking a
+// const MessageView&.
+template <typename Handler>
+inline PollResult poll(RingHeader* hdr, uint64_t& read_seq, Handler&& handler, uint32_t max_messages) {
+    return hot::poll_views<false>(hdr, read_seq, 0, handler, max_messages);
+}
+
+// See poll(..., topic_id, ...) in consume.h.
+template <typename Handler>
+inline PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, Handler&& handler,
+                       uint32_t max_messages) {
+    return hot::poll_views<true>(hdr, read_seq, topic_id, handler, max_messages);
+}
+
+// See poll(..., FragmentAssembler&, ...) in consume.h.
+template <typename Handler>
+inline PollResult poll(RingHeader* hdr, uint64_t& read_seq, FragmentAssembler& assembler,
+                       Handler&& handler, uint32_t max_messages) {
+    return hot::poll_messages<false>(hdr, read_seq, 0, assembler, handler, max_messages);
+}
+
+// See poll(..., topic_id, FragmentAssembler&, ...) in consume.h.
+template <typename Handler>
+inline PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id,
+                       FragmentAssembler& assembler, Handler&& handler, uint32_t max_messages) {
+    return hot::poll_messages<true>(hdr, read_seq, topic_id, assembler, handler, max_messages);
+}
+
+// poll(..., PackedReader&, ...): account for one packed slot's records.
+inline void count_packed_records(PackedReader& reader, const PackedSlotHeader& packed) {
+    const uint64_t first = packed.first_record;
+    if (reader.next_record == 0 || first >= reader.next_record) {
+        // In order, or past a gap. The first slot a reader sees has no gap
+        // before it — whatever was numbered earlier predates the reader.
+        if (reader.next_record != 0) {
+            reader.lost_records += first - reader.next_record;
+        }
+        reader.next_record = first + packed.record_count;
+    } else {
+        // Numbered before a slot already seen: another packer flushed it
+        // first and committed it to a later sequence. Its records were
+        // counted lost with the gap they left; they were not.
+        const uint64_t found = packed.record_count;
+        reader.lost_records -= found < reader.lost_records ? found : reader.lost_records;
+    }
+}
+
+// See poll(..., PackedReader&, ...) in consume.h. poll(), with each packed
+// slot's view unpacked into one view per record.
+template <typename Handler>
+inline PollResult poll(RingHeader* hdr, uint64_t& read_seq, PackedReader& reader, Handler&& handler,
+                       uint32_t max_slots) {
+    const uint64_t lost_before = reader.lost_records;
+    uint32_t     records      = 0;       // handler calls, the current slot's included
+    uint32_t     slot_records = 0;       // handler calls for the current slot
+    PackedReader slot_before  = reader;  // accounting to restore if the slot tears
+
+    const PollResult slots = hot::poll(hdr, read_seq, [&](const MessageView& view) {
+        slot_records = 0;
+        slot_before  = reader;
+        if (!(view.flags & SLOT_FLAG_PACKED)) {
+            handler(view);
+            slot_records = 1;
+            ++records;
+            return;
+        }
+        const PackedRecords packed = packed_records(view.payload);
+        count_packed_records(reader, packed.header);
+        for (std::span<const uint8_t> record : packed) {
+            handler(MessageView{record, view.seq, 0, view.header});
+            ++slot_records;
+            ++records;
+        }
+    }, max_slots);
+
+    PollResult result{};
+    result.lapped     = slots.lapped;
+    result.torn       = slots.torn;
+    result.superseded = slots.superseded;
+    result.delivered = records;
+    if (slots.torn) {
+        // The torn slot's header may be garbage — forget it, so its records
+        // show up as a gap once the next packed slot is read.
+        reader = slot_before;
+        result.delivered -= slot_records;
+    }
+    result.lost = reader.lost_records > lost_before ? reader.lost_records - lost_before : 0;
+    return result;
+}
+
+} // namespace aether::hot
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "aether/ring.h"
+#include "aether/term_log.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+
+namespace aether {
+
+// ---------------------------------------------------------------------------
+// Idle strategies
+//
+// What a polling loop does when an iteration finds no work. The choice trades
+// CPU for latency: a subscriber on a pinned core busy-spins, one on a shared
+// box backs off or parks. Every loop in the tree — the CLI, the daemon's TCP
+// forwarders, the bench harnesses — takes one, so the trade-off is made per
+// subscription or per daemon thread rather than hard-coded.
+//
+//   aether::IdleStrategy idle = aether::IdleStrategy::backoff();
+//   while (running) {
+//       const aether::PollResult r = aether::poll(hdr, read_seq, handler, 64);
+//       idle.idle(r.delivered + r.lapped, hdr, read_seq);
+//   }
+//
+// idle() must be called on every iteration, including productive ones: any
+// work resets the backoff so the next quiet spell starts from spinning again.
+// A strategy holds that progress, so each loop owns its own copy.
+// ---------------------------------------------------------------------------
+
+enum class IdleMode : uint32_t {
+    BusySpin = 0,  // cpu_relax() and poll again — lowest latency, burns the core
+    Yield    = 1,  // sched_yield() — gives the core up only if another thread wants it
+    Backoff  = 2,  // spin, then yield, then sleep for exponentially longer intervals
+    Park     = 3,  // sleep on the topic's futex until a publisher writes
+};
+
+struct IdleStrategy {
+    IdleMode mode = IdleMode::Park;
+
+    // Backoff: cpu_relax() iterations, then sched_yield() calls, then sleeps
+    // doubling from min_sleep up to max_sleep.
+    uint32_t                 max_spins  = 100;
+    uint32_t                 max_yields = 10;
+    std::chrono::nanoseconds min_sleep  = std::chrono::microseconds(1);
+    std::chrono::nanoseconds max_sleep  = std::chrono::milliseconds(1);
+
+    // Park: longest single futex wait. Bounds how long the loop goes without
+    // re-checking its own stop flag. A loop with no topic to park on (see
+    // idle(uint32_t)) sleeps for max_sleep instead.
+    std::chrono::nanoseconds park_timeout = std::chrono::milliseconds(100);
+
+    static IdleStrategy of(IdleMode m) {
+        IdleStrategy s;
+        s.mode = m;
+        return s;
+    }
+    static IdleStrategy busy_spin() { return of(IdleMode::BusySpin); }
+    static IdleStrategy yielding()  { return of(IdleMode::Yield); }
+    static IdleStrategy backoff()   { return of(IdleMode::Backoff); }
+    static IdleStrategy park(std::chrono::nanoseconds timeout = std::chrono::milliseconds(100)) {
+        IdleStrategy s = of(IdleMode::Park);
+        s.park_timeout = timeout;
+        return s;
+    }
+
+    // Call once per loop iteration with how much work it did (messages
+    // delivered, laps handled, ...). Parks on `hdr` in Park mode.
+    void idle(uint32_t work_count, RingHeader* hdr, uint64_t read_seq) {
+        if (work_count > 0) { reset(); return; }
+        if (mode == IdleMode::BusySpin) { cpu_relax(); return; }
+        idle_ring(hdr, read_seq);
+    }
+
+    void idle(uint32_t work_count, LogHeader* hdr, uint64_t position) {
+        if (work_count > 0) { reset(); return; }
+        if (mode == IdleMode::BusySpin) { cpu_relax(); return; }
+        idle_log(hdr, position);
+    }
+
+    // For loops that wait on something other than a publisher — e.g. a
+    // back-pressured publisher waiting for subscribers. Park sleeps max_sleep.
+    void idle(uint32_t work_count) {
+        if (work_count > 0) { reset(); return; }
+        if (mode == IdleMode::BusySpin) { cpu_relax(); return; }
+        idle_step();
+    }
+
+    // Start the next quiet spell from the first backoff stage.
+    void reset() {
+        idle_count_ = 0;
+        sleep_      = std::chrono::nanoseconds::zero();
+    }
+
+private:
+    // Out of line in libaether: only reached when there was nothing to do.
+    void idle_ring(RingHeader* hdr, uint64_t read_seq);
+    void idle_log(LogHeader* hdr, uint64_t position);
+    void idle_step();
+
+    uint32_t                 idle_count_ = 0;  // idle iterations since the last work
+    std::chrono::nanoseconds sleep_{};         // Backoff: current sleep interval
+};
+
+// "busy-spin" (or "spin"), "yield", "backoff", "park". Returns false and
+// leaves `mode` alone for anything else.
+bool parse_idle_mode(std::string_view name, IdleMode& mode);
+
+// Name accepted by parse_idle_mode() — for logs and stats.
+const char* idle_mode_name(IdleMode mode);
+
+} // namespace aether
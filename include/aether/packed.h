@@ -0,0 +1,117 @@
+#pragma once
+
+#include "aether/ring.h"
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>  // memcpy
+#include <span>
+
+namespace aether {
+
+// ---------------------------------------------------------------------------
+// Packed slots — many small messages in one slot
+//
+// A message of a few bytes published on its own takes a whole slot, and a
+// whole slot handoff: one claim, one commit, one sequence check per message.
+// A PackedPublication (publish.h) instead appends messages as records into
+// one claimed slot and commits the slot when it is full, on flush(), or once
+// it has been open for its linger time. The slot is flagged SLOT_FLAG_PACKED
+// and its payload is:
+//
+//   [ PackedSlotHeader ][ record ][ record ] ...
+//   record = [ uint32_t length ][ length bytes ], padded to PACKED_RECORD_ALIGN
+//
+// payload_len covers the PackedSlotHeader and every record. An 8-byte
+// message takes 12 bytes, so a 4 KB slot carries 340 of them per handoff.
+// ---------------------------------------------------------------------------
+
+// Written at the start of every packed slot's payload, at flush time.
+struct PackedSlotHeader {
+    // Ring-wide number of the slot's first record, taken from
+    // RingHeader::packed_records. Consecutive packed slots number their
+    // records consecutively, so a gap is records lost to a lap.
+    uint64_t first_record;
+    uint32_t record_count;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(PackedSlotHeader) == 16, "PackedSlotHeader must stay 16 bytes");
+
+// Records start on a 4-byte boundary, so the length prefix is aligned.
+constexpr uint32_t PACKED_RECORD_ALIGN = 4;
+
+// Slot bytes one record of `len` payload bytes takes, prefix and padding included.
+constexpr uint32_t packed_record_size(uint32_t len) {
+    return (static_cast<uint32_t>(sizeof(uint32_t)) + len + PACKED_RECORD_ALIGN - 1) &
+           ~(PACKED_RECORD_ALIGN - 1);
+}
+
+// Longest record a slot of `slot_size` bytes can hold on its own.
+constexpr uint32_t packed_max_record(uint32_t slot_size) {
+    constexpr uint32_t overhead = sizeof(PackedSlotHeader) + sizeof(uint32_t);
+    return slot_size < overhead ? 0 : (slot_size - overhead) & ~(PACKED_RECORD_ALIGN - 1);
+}
+
+// Walks the records of a packed payload. Every length prefix is checked
+// against the end of the payload, and read once, so a view that was
+// overwritten while it was read ends the walk early instead of running past
+// the slot.
+struct PackedRecordIterator {
+    const uint8_t* pos;
+    const uint8_t* end;
+    uint32_t       len;  // length of the record at pos
+
+    std::span<const uint8_t> operator*() const { return {pos + sizeof(len), len}; }
+
+    PackedRecordIterator& operator++() {
+        const size_t step = packed_record_size(len);
+        pos = step < static_cast<size_t>(end - pos) ? pos + step : end;
+        settle();
+        return *this;
+    }
+
+    bool operator==(const PackedRecordIterator& other) const { return pos == other.pos; }
+
+    // Load the length of the record at `pos`, or park at `end` unless a
+    // whole record starts there.
+    void settle() {
+        if (static_cast<size_t>(end - pos) < sizeof(len)) {
+            pos = end;
+            return;
+        }
+        memcpy(&len, pos, sizeof(len));
+        if (len > static_cast<size_t>(end - pos) - sizeof(len)) {
+            pos = end;
+        }
+    }
+};
+
+// The records of one packed slot, for a range-for.
+struct PackedRecords {
+    PackedSlotHeader header;  // all zero if the payload is too short to hold one
+    const uint8_t*   first;   // first record
+    const uint8_t*   last;    // one past the last record
+
+    PackedRecordIterator begin() const {
+        PackedRecordIterator it{first, last, 0};
+        it.settle();
+        return it;
+    }
+    PackedRecordIterator end() const { return {last, last, 0}; }
+};
+
+// Split a packed slot's payload into its header and records.
+inline PackedRecords packed_records(std::span<const uint8_t> payload) {
+    PackedRecords r{};
+    r.last = payload.data() + payload.size();
+    if (payload.size() < sizeof(PackedSlotHeader)) {
+        r.first = r.last;
+        return r;
+    }
+    memcpy(&r.header, payload.data(), sizeof(r.header));
+    r.first = payload.data() + sizeof(PackedSlotHeader);
+    return r;
+}
+
+} // namespace aether
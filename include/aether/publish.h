@@ -1,17 +1,237 @@
 #pragma once
 
 #include "aether/ring.h"
+#include "aether/term_log.h"
+#include <chrono>
 #include <cstdint>
+#include <span>
 
 namespace aether {
 
+enum class PublishResult {
+    Ok,             // message written
+    TooLarge,       // payload exceeds what the ring can carry (see publish()) or
+                    // the frame limit — not written
+    BackPressured,  // BackPressure topic and the slowest subscriber is a full
+                    // ring behind — not written, try again later
+    Unavailable,    // ring is held by an ExclusivePublication — not written
+    Superseded,     // the topic was resized and this ring sealed — not written;
+                    // migrate() the subscription (subscribe.h) and publish again
+};
+
 // Write a message into the next available slot in the ring buffer.
 //
 // Thread-safe: multiple producers can call this concurrently — write_seq
 // is incremented atomically so each producer gets a unique slot.
 //
-// Returns true on success.
-// Returns false if len > SLOT_DATA_SIZE — payload too large, not written.
-bool publish(RingHeader* hdr, const void* data, uint32_t len);
+// On an OverflowPolicy::Overwrite topic the oldest message is overwritten
+// when the ring is full. On a BackPressure topic the sequence is only claimed
+// if it would not overwrite a message some attached subscriber has not read
+// yet (see attach_cursor() in consume.h); otherwise nothing is written and
+// BackPressured is returned.
+//
+// A message longer than the ring's slot_size is fragmented: its pieces go
+// into consecutive slots, claimed together so that no other producer's
+// message lands between them, and flagged SLOT_FLAG_FRAGMENT / BEGIN / END.
+// consume() and poll() with a FragmentAssembler reassemble it. TooLarge
+// beyond max_message_length(capacity, slot_size). On a BackPressure topic the
+// whole message must fit, as for publish_batch().
+//
+// On a ring created with MessageHeaders, the slot's MessageHeader is stamped
+// with the current time and zero session, type and key.
+PublishResult publish(RingHeader* hdr, const void* data, uint32_t len);
+
+// publish() with the session, type and key for the message's MessageHeader.
+// Written straight into the slot's header alongside the payload copy; the
+// metadata is ignored on a ring without MessageHeaders. meta.topic_id tags
+// the slot on any ring — see "Multiplexed rings" in consume.h.
+PublishResult publish(RingHeader* hdr, const MessageMeta& meta, const void* data, uint32_t len);
+
+// One message of a publish_batch() — an iovec for the ring.
+struct PublishVec {
+    const void* data;
+    uint32_t    len;
+};
+
+// Write a burst of messages into consecutive slots.
+//
+// The whole range of sequence numbers is claimed with a single fetch_add on
+// write_seq, so a burst of N messages pays for one contended atomic instead
+// of N. The slots are then filled and released in order, each with the same
+// seqlock protocol as publish(): subscribers see the messages appear one by
+// one, never out of order, and messages from concurrent producers never
+// interleave inside the burst.
+//
+// A burst longer than the ring's capacity overwrites its own oldest messages,
+// exactly as the same messages published one by one would. On a BackPressure
+// topic the burst is all-or-nothing: BackPressured unless every message fits.
+//
+// Messages are not fragmented: each must fit one slot, or the burst is
+// TooLarge. An empty burst is a no-op that returns Ok. On any other result
+// nothing is claimed or written.
+PublishResult publish_batch(RingHeader* hdr, std::span<const PublishVec> msgs);
+
+// publish_batch() with one MessageMeta for every message of the burst — the
+// same header fields and, on a multiplexed ring, the same topic.
+PublishResult publish_batch(RingHeader* hdr, const MessageMeta& meta, std::span<const PublishVec> msgs);
+
+// ---------------------------------------------------------------------------
+// Zero-copy claim API
+//
+// try_claim() reserves the next sequence and hands back a writable span
+// straight into the slot's shared-memory payload, so an encoder can serialize
+// in place instead of building the message in a scratch buffer and having
+// publish() copy it. Every successful try_claim() must be followed by exactly
+// one commit() or abort().
+//
+//   aether::Claim c;
+//   if (aether::try_claim(hdr, sizeof(Order), c) == aether::PublishResult::Ok) {
+//       auto* o = reinterpret_cast<Order*>(c.buffer.data());
+//       o->price = ...;
+//       aether::commit(c, sizeof(Order));
+//   }
+//
+// Same ordering guarantees as publish(): the slot is invalidated when it is
+// claimed and its sequence is published with memory_order_release on commit.
+// Subscribers waiting on the claimed sequence see Empty until then, so keep
+// the window between claim and commit short.
+// ---------------------------------------------------------------------------
+
+struct Claim {
+    SlotDescriptor*    slot;    // claimed slot — owned by the caller until commit/abort
+    uint64_t           seq;     // sequence number that commit() will publish
+    std::span<uint8_t> buffer;  // writable payload, the ring's slot_size bytes
+    RingHeader*        hdr;     // ring the slot belongs to — commit() wakes its subscribers
+    MessageHeader*     header;  // the slot's header, stamped by commit(); nullptr if none
+};
+
+// Reserve the next slot for a message of at most `max_len` bytes.
+// Anything but Ok means nothing was reserved — same results as publish().
+PublishResult try_claim(RingHeader* hdr, uint32_t max_len, Claim& claim);
+
+// Publish the first `len` bytes of claim.buffer. len must be <= buffer.size().
+// The message's header, if the ring has them, is stamped at commit time.
+void commit(Claim& claim, uint32_t len);
+void commit(Claim& claim, uint32_t len, const MessageMeta& meta);
+
+// Give up the claim. The sequence is already taken, so the slot is published
+// as an empty SLOT_FLAG_ABORTED slot that consume() skips — subscribers do
+// not stall on it and do not receive a message.
+void abort(Claim& claim);
+
+// ---------------------------------------------------------------------------
+// Packed publication — many small messages per slot
+//
+// pack() appends a message as one record to a slot the handle keeps claimed,
+// and the slot is committed as a whole, flagged SLOT_FLAG_PACKED (format in
+// packed.h): when the next record does not fit, when the slot is full, on
+// flush(), or from flush_lingering() once it has been open `linger` long.
+// Subscribers walk the records with packed_records(), or poll() through a
+// PackedReader to receive one view per record.
+//
+//   aether::PackedPublication pub = aether::packed_publication(hdr, std::chrono::microseconds(50));
+//   for (const Tick& t : ticks) {
+//       aether::pack(pub, &t, sizeof(t));
+//   }
+//   aether::flush(pub);
+//
+// The open slot is a claim (see try_claim()): subscribers see Empty at its
+// sequence until it is committed, and so does everything published after it.
+// An application that packs in bursts must flush() after each burst, or call
+// flush_lingering() from its idle loop, to bound that delay. One thread packs
+// through a handle; any number of handles and ordinary publishers may share
+// the ring.
+// ---------------------------------------------------------------------------
+
+struct PackedPublication {
+    RingHeader* hdr;
+    Claim       claim;      // open slot; claim.slot is nullptr while none is
+    uint32_t    used;       // bytes of claim.buffer filled, PackedSlotHeader included
+    uint32_t    records;    // records in the open slot
+    uint64_t    opened_ns;  // CLOCK_MONOTONIC when the open slot was claimed
+    uint64_t    linger_ns;  // flush_lingering() commits a slot open this long
+};
+
+// A handle packing into `hdr` with nothing claimed yet.
+PackedPublication packed_publication(RingHeader* hdr, std::chrono::nanoseconds linger);
+
+// Append one message to the open slot, claiming a new one first if there is
+// none or the message does not fit — the full slot is committed then.
+// TooLarge if len > packed_max_record(slot_size) — publish() it instead;
+// BackPressured or Unavailable if no slot could be claimed, as for publish().
+// Anything but Ok means the message was not packed.
+PublishResult pack(PackedPublication& pub, const void* data, uint32_t len);
+
+// Commit the open slot, if any. Its MessageHeader, on rings that have them,
+// is stamped now.
+void flush(PackedPublication& pub);
+
+// flush() if the open slot has been claimed for at least the linger time.
+// Returns true if it committed one.
+bool flush_lingering(PackedPublication& pub);
+
+// ---------------------------------------------------------------------------
+// Exclusive publication — single-writer fast path
+//
+// A topic with exactly one writer does not need publish()'s locked fetch_add.
+// The writer acquires the ring once; from then on it owns write_seq, keeps
+// the next sequence and slot index in its own handle, and advances write_seq
+// with a plain store. Subscribers are unaffected — they see the same slot
+// sequences as before, and a write_seq that only gains the RING_EXCLUSIVE bit.
+//
+// Ownership is the RING_EXCLUSIVE bit of write_seq, with the owner's pid in
+// RingHeader::exclusive_pid. While it is set, a second acquire_exclusive()
+// fails and the shared publish(), publish_batch() and try_claim() on that
+// ring return Unavailable — they see the bit in the same RMW that would have
+// claimed their sequence. acquire_exclusive() waits for the shared claims
+// taken before it to commit, so the owner never writes beside one. A claim
+// left behind by a process that died is taken over.
+//
+//   aether::ExclusivePublication pub;
+//   if (aether::acquire_exclusive(hdr, pub)) {
+//       aether::publish(pub, &tick, sizeof(tick));
+//       ...
+//       aether::release_exclusive(pub);
+//   }
+//
+// The handle is not thread-safe — one thread publishes through it.
+// ---------------------------------------------------------------------------
+
+struct ExclusivePublication {
+    RingHeader*  hdr;       // ring this handle owns
+    SlotGeometry slots;
+    uint64_t     next_seq;   // sequence the next publish() writes
+    uint32_t     index;      // next_seq & mask, advanced without touching the header
+    uint32_t     mask;       // capacity - 1
+    uint32_t     slot_size;
+};
+
+// Take exclusive ownership of the ring's write side.
+// Returns false if another live process (or another handle in this one)
+// already holds it, or if the ring has been superseded. Blocks while shared
+// publishers finish the slots they claimed before it took the ring.
+bool acquire_exclusive(RingHeader* hdr, ExclusivePublication& pub);
+
+// Single-writer publish: no atomic RMW, no shared counter read.
+// Fragments long messages and stamps headers as the shared publish() does.
+// Returns Ok, TooLarge, or BackPressured (BackPressure topics only).
+PublishResult publish(ExclusivePublication& pub, const void* data, uint32_t len);
+PublishResult publish(ExclusivePublication& pub, const MessageMeta& meta, const void* data,
+                      uint32_t len);
+
+// Give up ownership; the ring goes back to shared publication.
+// After this call `pub` must not be used.
+void release_exclusive(ExclusivePublication& pub);
+
+// Append a message to a term log as one variable-length frame.
+//
+// Thread-safe: producers claim disjoint byte ranges with a single fetch_add
+// on tail_position. A claim that does not fit in the rest of the current term
+// is turned into padding and retried at the start of the next term.
+//
+// Frames are variable-length already, so a log message is never fragmented:
+// it is one frame or nothing.
+// Returns Ok, or TooLarge if len > log_max_payload(term_length) — not written.
+PublishResult publish(LogHeader* hdr, const void* data, uint32_t len);
 
 } // namespace aether
\ No newline at end of file
@@ -12,6 +12,9 @@ struct RemotePublisher {
 
 RemotePublisher remote_publisher(const char* host, uint16_t port = DEFAULT_TCP_PORT);
 void remote_disconnect(RemotePublisher& pub);
+// Messages up to MAX_MESSAGE_SIZE; longer than WIRE_MAX_FRAGMENT, they are
+// sent as fragment frames and reassembled by the daemon, which publishes
+// them whole. Returns false on disconnect or an oversized topic or message.
 bool remote_publish(RemotePublisher& pub,
                     const char* topic, uint32_t topic_len,
                     const void* data, uint32_t data_len);
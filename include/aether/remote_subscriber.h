@@ -15,8 +15,10 @@ RemoteSubscriber remote_subscriber(const char* host, const char* topic, uint32_t
                                    uint16_t port = DEFAULT_TCP_PORT);
 void remote_disconnect(RemoteSubscriber& sub);
 
-// Blocks up to timeout_ms milliseconds (default: 5000).
-// Returns the number of bytes written to buf, or -1 on disconnect/timeout.
+// Blocks up to timeout_ms milliseconds (default: 5000) for each frame.
+// A message that arrives fragmented is reassembled into buf.
+// Returns the number of bytes written to buf, or -1 on disconnect/timeout
+// or a message longer than buf_capacity.
 int remote_consume(RemoteSubscriber& sub, void* buf, uint32_t buf_capacity,
                    int timeout_ms = 5000);
 
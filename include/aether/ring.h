@@ -3,6 +3,11 @@
 #include <atomic>
 #include <cstdint>
 #include <cstddef>
+#include <ctime>   // clock_gettime
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>  // __rdtsc
+#endif
 
 namespace aether {
 
@@ -10,40 +15,219 @@ namespace aether {
 // Constants
 // ---------------------------------------------------------------------------
 
-// Maximum bytes a single message payload can occupy in a slot.
-// 4096 = one memory page — a natural allocation unit.
-// If a payload exceeds this, publish() returns an error. No silent truncation.
+// Default payload bytes per slot (RingHeader::slot_size) for topics that do
+// not choose their own. 4096 = one memory page — a natural allocation unit.
+// A payload larger than the ring's slot size is split across consecutive
+// slots by publish() (see SLOT_FLAG_FRAGMENT).
 constexpr std::size_t SLOT_DATA_SIZE = 4096;
 
+// Largest slot size a ring may be created with.
+constexpr std::size_t MAX_SLOT_DATA_SIZE = 1 << 20;
+
+// Largest message publish() accepts, fragmented or not. A fragmented message
+// must also fit in the ring at once — see max_message_length().
+constexpr std::size_t MAX_MESSAGE_SIZE = 16 << 20;
+
+// Slots (interleaved) and payloads (split) are padded to this, so two slots
+// never share a cache line: no false sharing between the producer and any
+// subscriber touching its neighbour.
+constexpr std::size_t SLOT_ALIGN = 64;
+
 // Written into RingHeader::magic on initialisation.
 // If we open a shm segment and the magic doesn't match, the segment is
 // stale, corrupt, or belongs to a different program — reject it.
 constexpr uint64_t RING_MAGIC = 0xAE7E4000DEADC0DE;
 
-// Bump this if the layout of RingHeader or Slot ever changes incompatibly.
-constexpr uint32_t RING_VERSION = 1;
+// Bump this if the layout of RingHeader, SlotDescriptor or the slot array
+// ever changes incompatibly.
+constexpr uint32_t RING_VERSION = 2;
+
+// SlotDescriptor::flags bits.
+// ABORTED: the producer claimed this sequence and then gave it up (abort()).
+// The slot carries no message; consume() steps over it.
+constexpr uint32_t SLOT_FLAG_ABORTED = 0x1;
+
+// FRAGMENT: the slot holds one piece of a message longer than the ring's slot
+// size, which publish() split across consecutive sequences. BEGIN marks the
+// first piece and END the last; pieces in between carry FRAGMENT alone.
+// Every piece but the last is exactly slot_size bytes. A message that fits
+// one slot carries none of the three, as it always has.
+constexpr uint32_t SLOT_FLAG_FRAGMENT = 0x2;
+constexpr uint32_t SLOT_FLAG_BEGIN    = 0x4;
+constexpr uint32_t SLOT_FLAG_END      = 0x8;
+
+// PACKED: the slot holds many small messages appended by a PackedPublication
+// rather than one message; its payload is laid out as packed.h describes.
+constexpr uint32_t SLOT_FLAG_PACKED = 0x10;
+
+// Bits 16..31 of SlotDescriptor::flags: the logical topic a slot belongs to
+// on a multiplexed ring, where many low-rate topics share one physical ring
+// (MessageMeta::topic_id). 0 on a ring that carries a single topic. Kept in
+// the descriptor so a subscriber filters by topic without touching payloads.
+constexpr uint32_t SLOT_TOPIC_SHIFT = 16;
+constexpr uint32_t SLOT_FLAG_MASK   = (1u << SLOT_TOPIC_SHIFT) - 1;
+constexpr uint32_t MAX_TOPIC_ID     = 0xFFFF;
+
+inline uint32_t slot_topic_flags(uint16_t topic_id) {
+    return static_cast<uint32_t>(topic_id) << SLOT_TOPIC_SHIFT;
+}
+
+inline uint16_t slot_topic_id(uint32_t flags) {
+    return static_cast<uint16_t>(flags >> SLOT_TOPIC_SHIFT);
+}
+
+// Top bit of SlotDescriptor::sequence: a producer owns the slot and is writing the
+// message for (sequence & ~SLOT_WRITING). Set by a CAS from the previous
+// lap's committed sequence, cleared by the commit store — see publish.cpp.
+constexpr uint64_t SLOT_WRITING = 1ULL << 63;
+
+// Top bit of RingHeader::write_seq: the ring has been superseded by a larger
+// one (see "Ring migration" in shm.h). Set once, with a CAS that fixes
+// the last sequence the ring carries; a claim that returns it set got no
+// sequence here and must be retried on the successor. ring_head() is
+// write_seq as a sequence number.
+constexpr uint64_t RING_SEALED = 1ULL << 63;
+
+// Next bit of RingHeader::write_seq: an ExclusivePublication owns the ring
+// (see "Exclusive publication" in publish.h). Shared claims read it in the
+// same RMW that would take their sequence, so none can slip in beside the
+// owner; one that returns it set got nothing. Never set together with
+// RING_SEALED for longer than a failed acquire takes to back out.
+constexpr uint64_t RING_EXCLUSIVE = 1ULL << 62;
+
+// Either bit: write_seq is not taking shared claims.
+constexpr uint64_t RING_CLAIM_FLAGS = RING_SEALED | RING_EXCLUSIVE;
+
+// Longest shm name RingHeader::successor_name holds, terminator included.
+constexpr uint32_t RING_MAX_SUCCESSOR_NAME_LEN = 64;
+
+// RingHeader::residency / LogHeader::residency bits: how every process that
+// maps the segment keeps it resident. Chosen by the creator (SegmentOptions
+// in shm.h) and applied per mapping by apply_residency().
+constexpr uint32_t RESIDENCY_PREFAULT = 0x1;  // populate the page tables up front
+constexpr uint32_t RESIDENCY_LOCK     = 0x2;  // mlock(): never paged out or reclaimed
+constexpr uint32_t RESIDENCY_DONTFORK = 0x4;  // MADV_DONTFORK: fork() children do not inherit it
 
 // ---------------------------------------------------------------------------
 // Slot — one entry in the ring buffer
 // ---------------------------------------------------------------------------
 
-// alignas(64): each slot is aligned to a 64-byte cache line boundary.
-// This prevents two adjacent slots from sharing a cache line, which would
-// cause false sharing between the producer and any subscriber touching them.
-struct alignas(64) Slot {
+// The part of a slot that publishers and subscribers synchronise on. In the
+// interleaved layout it heads each slot; in the split layout descriptors form
+// their own dense array ahead of the payloads (see SlotLayout).
+struct SlotDescriptor {
     // The producer sets this AFTER writing payload_len and data[].
     // A subscriber waiting on slot index i polls this value:
     //   - sequence == expected_seq  → message is ready, safe to read
     //   - sequence <  expected_seq  → slot not yet written (subscriber is ahead)
     //   - sequence >  expected_seq  → subscriber was lapped (message overwritten)
+    // While a producer is writing, SLOT_WRITING is set on top of the sequence
+    // it is writing; subscribers compare with the bit masked off, so "being
+    // written for expected_seq or earlier" reads as not-yet-written.
     std::atomic<uint64_t> sequence;
 
-    // How many bytes of data[] are actually used by this message.
-    // Always <= SLOT_DATA_SIZE.
+    // How many bytes of the slot's payload are actually used by this message.
+    // Always <= RingHeader::slot_size.
     uint32_t payload_len;
 
-    // Raw message bytes. Only the first payload_len bytes are valid.
-    uint8_t data[SLOT_DATA_SIZE];
+    // SLOT_FLAG_* bits and the slot's topic id (SLOT_TOPIC_SHIFT), written
+    // with payload_len before the sequence store.
+    uint32_t flags;
+};
+
+// How a slot ring arranges descriptors and payloads. Chosen by the creator
+// (SegmentOptions in shm.h), recorded in RingHeader::slot_layout.
+enum class SlotLayout : uint32_t {
+    // [ slot 0 ][ slot 1 ] ... [ slot N-1 ] — each slot is its descriptor
+    // followed by slot_size payload bytes, padded to SLOT_ALIGN. With the
+    // default slot size, consecutive sequence words are 4160 bytes, a page, apart.
+    Interleaved = 0,
+
+    // [ descriptor 0 .. N-1 ][ pad ][ payload 0 ][ payload 1 ] ... [ payload N-1 ]
+    // Descriptors are 16 bytes, four to a cache line, so a subscriber
+    // waiting on the next message, poll()'s prefetch and the lap check walk
+    // a compact array instead of touching a new page per slot. The pad puts
+    // the payload pool on a SLOT_DATA_SIZE boundary; payloads are slot_size
+    // padded to SLOT_ALIGN, so with the default size each is exactly one 4 KB page.
+    Split = 1,
+};
+
+// ---------------------------------------------------------------------------
+// Message headers
+// ---------------------------------------------------------------------------
+
+// Whether a ring carries a MessageHeader per slot, and which clock stamps it.
+// Chosen by the creator (SegmentOptions in shm.h), recorded in
+// RingHeader::message_headers.
+enum class MessageHeaders : uint32_t {
+    None      = 0,  // no headers — slots carry only the payload (default)
+    Monotonic = 1,  // timestamp: CLOCK_MONOTONIC nanoseconds, comparable across processes
+    Tsc       = 2,  // timestamp: the CPU's time-stamp counter — cheaper to read, in
+                    // cycles; only comparable across cores with an invariant TSC
+};
+
+// Fixed per-message metadata, so applications need not prefix every payload
+// with their own header to route messages or measure latency. One per slot,
+// in an array of its own after the slots (see message_header_offset()):
+// filters read it without touching the payload, and a payload's bytes are
+// the message's alone. publish() fills it under the slot's seqlock, so it is
+// exactly as consistent as the payload it describes.
+struct alignas(32) MessageHeader {
+    uint64_t timestamp;   // publish time, in the ring's MessageHeaders clock
+    uint64_t key;         // application key — routing, partitioning, conflation
+    uint32_t session_id;  // publisher session, chosen by the publisher
+    uint32_t type_id;     // application message type
+    uint64_t reserved;
+};
+
+// What a publisher supplies for a message's header; publish() adds the
+// timestamp. Publishes without one leave these fields 0. topic_id is not part
+// of the header: it tags the slot itself (SLOT_TOPIC_SHIFT), on any ring.
+struct MessageMeta {
+    uint32_t session_id = 0;
+    uint32_t type_id    = 0;
+    uint64_t key        = 0;
+    uint16_t topic_id   = 0;  // logical topic on a multiplexed ring, 0 otherwise
+};
+
+// ---------------------------------------------------------------------------
+// Overflow policy and subscriber cursors
+// ---------------------------------------------------------------------------
+
+// What publish() does when the ring is full of messages a subscriber has not
+// read yet. Chosen per topic when the topic is created.
+enum class OverflowPolicy : uint32_t {
+    Overwrite    = 0,  // overwrite the oldest message; laggards see Lapped (default)
+    BackPressure = 1,  // refuse to overwrite unread data; publish() returns BackPressured
+};
+
+// Maximum number of subscribers that can hold a cursor on one ring.
+constexpr uint32_t RING_MAX_CURSORS = 16;
+
+// A subscriber's published read position on a BackPressure topic.
+// Publishers never claim a sequence >= (slowest read_seq + capacity).
+// One cache line each: every subscriber writes only its own cursor.
+struct alignas(64) SubscriberCursor {
+    // Next sequence this subscriber will read. Stored with release after the
+    // subscriber is done with everything before it.
+    std::atomic<uint64_t> read_seq;
+
+    // Owning process, 0 while the entry is free. The daemon frees entries
+    // whose process has died, so a crashed subscriber cannot block the topic.
+    std::atomic<uint32_t> pid;
+};
+
+// ---------------------------------------------------------------------------
+// Subscriber wake-up
+// ---------------------------------------------------------------------------
+
+// Where subscribers blocked in consume_wait() / wait_for_message() sleep.
+// A subscriber that finds nothing to read increments `waiters` and sleeps on
+// `futex`; a publisher that sees `waiters` != 0 after publishing bumps
+// `futex` and wakes them. While nobody is parked, publishing costs one load.
+struct SubscriberWakeup {
+    std::atomic<uint32_t> waiters;  // subscribers parked, or about to park
+    std::atomic<uint32_t> futex;    // bumped by the publisher before FUTEX_WAKE
 };
 
 // ---------------------------------------------------------------------------
@@ -52,8 +236,8 @@ struct alignas(64) Slot {
 
 // Memory layout of the full shm segment:
 //
-//   [ RingHeader (aligned to 64 bytes) ]
-//   [ Slot 0 ][ Slot 1 ] ... [ Slot N-1 ]
+//   [ RingHeader (aligned to 64 bytes, cursor table included) ]
+//   [ capacity slots of slot_size bytes, arranged as slot_layout says ]
 //
 // The broker creates this segment; publishers and subscribers map it read/write.
 
@@ -64,13 +248,75 @@ struct alignas(64) RingHeader {
     // Layout version: reject segments written by an incompatible binary.
     uint32_t version;
 
-    // Number of slots in the ring. Set once at creation, never changed.
+    // Number of slots in the ring, a power of two. Set once at creation,
+    // never changed.
     uint32_t capacity;
 
     // Monotonically increasing counter. The producer increments this to
     // claim the next slot to write into.
-    // slot index = write_seq % capacity
+    // slot index = write_seq & index_mask
     std::atomic<uint64_t> write_seq;
+
+    // pid of the process holding the ring's ExclusivePublication, or 0 while
+    // the ring is shared. Says who owns the ring, so a dead owner can be taken
+    // over; what keeps shared publishers out is RING_EXCLUSIVE in write_seq.
+    std::atomic<uint32_t> exclusive_pid;
+
+    // Set once at creation, never changed.
+    OverflowPolicy policy;
+
+    // Size of the pages backing the segment: the system page size, or the
+    // hugetlbfs page size for a huge-page segment (see SegmentOptions).
+    // Mappings are this granular, so unmapping rounds up to it.
+    uint32_t page_size;
+
+    // RESIDENCY_* bits every mapping of the segment should apply.
+    uint32_t residency;
+
+    // NUMA node the segment's memory is bound to, or -1 if it was left to
+    // first touch. Lets clients co-locate with their topic.
+    int32_t numa_node;
+
+    // Set once at creation, never changed. Fills what was padding before
+    // publish_limit, so the header's first line stays one line.
+    SlotLayout slot_layout;
+
+    // BackPressure only: cached first sequence publishers may not claim,
+    // i.e. slowest cursor + capacity. Only ever too low, never too high —
+    // a publisher that hits it recomputes it from the cursor table, and
+    // attaching or freeing a cursor resets it to 0 to force that.
+    std::atomic<uint64_t> publish_limit;
+
+    // Parked subscribers. On the write_seq line, which every publish already
+    // writes — checking for waiters costs no extra cache miss.
+    SubscriberWakeup wakeup;
+
+    // Geometry every publish and consume reads. Set once at creation and
+    // never written again, so it lives on a line of its own that stays
+    // shared in every core's cache instead of on the contended first line.
+    uint32_t index_mask;  // capacity - 1: slot index = sequence & index_mask
+    uint32_t slot_size;   // payload bytes per slot, at most MAX_SLOT_DATA_SIZE
+    MessageHeaders message_headers;  // whether slots have a MessageHeader, and its clock
+
+    // Number the next packed record will take, starting at 1. Numbers every
+    // packed record ring-wide, so subscribers count lost records and not just
+    // lost slots. Written once per packed slot, on a line of its own.
+    alignas(64) std::atomic<uint64_t> packed_records;
+
+    // Migration (see "Ring migration" in shm.h). `epoch` counts the resizes
+    // the topic went through before this ring was created — 0 for its first
+    // ring. Once the ring is superseded, `successor_seq` is the first
+    // sequence its successor carries, stored with release after the
+    // successor's name and arena offset (0: a segment of its own); 0 while
+    // the ring is current. Written once, so the line stays shared.
+    alignas(64) std::atomic<uint64_t> successor_seq;
+    uint32_t epoch;
+    uint32_t reserved;
+    uint64_t successor_offset;
+    char     successor_name[RING_MAX_SUCCESSOR_NAME_LEN];
+
+    // BackPressure only: one entry per attached subscriber.
+    SubscriberCursor cursors[RING_MAX_CURSORS];
 };
 
 // ---------------------------------------------------------------------------
@@ -82,4 +328,150 @@ struct alignas(64) RingHeader {
 static_assert(std::atomic<uint64_t>::is_always_lock_free,
               "std::atomic<uint64_t> must be lock-free on this platform");
 
+// Four split-layout descriptors per cache line.
+static_assert(sizeof(SlotDescriptor) == 16, "SlotDescriptor must stay 16 bytes");
+
+// Two message headers per cache line.
+static_assert(sizeof(MessageHeader) == 32, "MessageHeader must stay 32 bytes");
+
+// ---------------------------------------------------------------------------
+// Slot geometry
+// ---------------------------------------------------------------------------
+
+// `size` rounded up to a multiple of SLOT_ALIGN.
+constexpr std::size_t align_slot(std::size_t size) {
+    return (size + SLOT_ALIGN - 1) / SLOT_ALIGN * SLOT_ALIGN;
+}
+
+// Bytes from one slot's descriptor to the next.
+constexpr std::size_t slot_descriptor_stride(uint32_t slot_size, SlotLayout layout) {
+    return layout == SlotLayout::Split ? sizeof(SlotDescriptor)
+                                       : align_slot(sizeof(SlotDescriptor) + slot_size);
+}
+
+// Bytes from one slot's payload to the next.
+constexpr std::size_t slot_payload_stride(uint32_t slot_size, SlotLayout layout) {
+    return layout == SlotLayout::Split ? align_slot(slot_size)
+                                       : align_slot(sizeof(SlotDescriptor) + slot_size);
+}
+
+// Byte offset of slot 0's payload from the start of the segment.
+constexpr std::size_t slot_payload_offset(uint32_t capacity, SlotLayout layout) {
+    if (layout == SlotLayout::Interleaved) {
+        return sizeof(RingHeader) + sizeof(SlotDescriptor);
+    }
+    const std::size_t descriptors_end = sizeof(RingHeader) + capacity * sizeof(SlotDescriptor);
+    return (descriptors_end + SLOT_DATA_SIZE - 1) / SLOT_DATA_SIZE * SLOT_DATA_SIZE;
+}
+
+// Byte offset of the end of the slots — where the MessageHeader array starts
+// on a ring that has one. A multiple of SLOT_ALIGN in both layouts.
+constexpr std::size_t message_header_offset(uint32_t capacity, uint32_t slot_size, SlotLayout layout) {
+    if (layout == SlotLayout::Interleaved) {
+        return sizeof(RingHeader) + capacity * slot_descriptor_stride(slot_size, layout);
+    }
+    return slot_payload_offset(capacity, layout) + capacity * slot_payload_stride(slot_size, layout);
+}
+
+// Longest message a ring of this geometry can carry: every fragment of a
+// message is in the ring at once, so at most `capacity` slots of it.
+constexpr uint32_t max_message_length(uint32_t capacity, uint32_t slot_size) {
+    const uint64_t ring_bytes = static_cast<uint64_t>(capacity) * slot_size;
+    return static_cast<uint32_t>(ring_bytes < MAX_MESSAGE_SIZE ? ring_bytes : MAX_MESSAGE_SIZE);
+}
+
+// Where slot i's descriptor and payload live in one process's mapping.
+// Both layouts are a base plus a stride, so the hot paths resolve the
+// geometry once and index without branching on the layout.
+struct SlotGeometry {
+    uint8_t*    descriptors;        // descriptor of slot 0
+    std::size_t descriptor_stride;
+    uint8_t*    payloads;           // payload of slot 0
+    std::size_t payload_stride;
+    MessageHeader* headers;         // header of slot 0, nullptr without MessageHeaders
+
+    SlotDescriptor& descriptor(uint64_t index) const {
+        return *reinterpret_cast<SlotDescriptor*>(descriptors + index * descriptor_stride);
+    }
+    uint8_t* payload(uint64_t index) const {
+        return payloads + index * payload_stride;
+    }
+    MessageHeader* header(uint64_t index) const {
+        return headers != nullptr ? headers + index : nullptr;
+    }
+};
+
+inline SlotGeometry slot_geometry(RingHeader* hdr) {
+    auto* base = reinterpret_cast<uint8_t*>(hdr);
+    return SlotGeometry{
+        .descriptors       = base + sizeof(RingHeader),
+        .descriptor_stride = slot_descriptor_stride(hdr->slot_size, hdr->slot_layout),
+        .payloads          = base + slot_payload_offset(hdr->capacity, hdr->slot_layout),
+        .payload_stride    = slot_payload_stride(hdr->slot_size, hdr->slot_layout),
+        .headers           = hdr->message_headers == MessageHeaders::None
+                                 ? nullptr
+                                 : reinterpret_cast<MessageHeader*>(
+                                       base + message_header_offset(hdr->capacity, hdr->slot_size,
+                                                                    hdr->slot_layout)),
+    };
+}
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+
+// write_seq as a sequence number — the next one a publisher would claim. On
+// a superseded ring, the first sequence of its successor: claims refused
+// after the seal still bump write_seq, but never moved the ring's end.
+inline uint64_t ring_head(const RingHeader* hdr) {
+    const uint64_t seq = hdr->write_seq.load(std::memory_order_relaxed);
+    if (!(seq & RING_SEALED)) {
+        return seq & ~RING_EXCLUSIVE;
+    }
+    const uint64_t end = hdr->successor_seq.load(std::memory_order_acquire);
+    return end != 0 ? end : seq & ~RING_CLAIM_FLAGS;
+}
+
+// True once the ring has been superseded and `read_seq` has reached its end:
+// every message from read_seq on is in the successor. Checked by consume()
+// and poll() only when they find nothing to read.
+inline bool ring_drained(const RingHeader* hdr, uint64_t read_seq) {
+    const uint64_t end = hdr->successor_seq.load(std::memory_order_acquire);
+    return end != 0 && read_seq >= end;
+}
+
+// Spin-wait hint. On x86 `pause` stops the core from speculating ahead in a
+// tight poll loop and frees execution resources for the sibling hyperthread.
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+// "none", "monotonic" or "tsc" — the daemon's config spelling, for logs.
+inline const char* message_headers_name(MessageHeaders headers) {
+    switch (headers) {
+        case MessageHeaders::None:      return "none";
+        case MessageHeaders::Monotonic: return "monotonic";
+        case MessageHeaders::Tsc:       return "tsc";
+    }
+    return "unknown";
+}
+
+// Current time in `clock` — what publish() stamps into MessageHeader::timestamp.
+// Subscribers measure latency as header_timestamp(clock) - header->timestamp.
+inline uint64_t header_timestamp(MessageHeaders clock) {
+#if defined(__x86_64__) || defined(__i386__)
+    if (clock == MessageHeaders::Tsc) {
+        return __rdtsc();
+    }
+#endif
+    (void)clock;
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000'000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
 } // namespace aether
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "aether/ring.h"
+#include "aether/slot_protocol.h"
+#include "aether/publish.h"
+#include "aether/consume.h"
+
+#include <cassert>
+#include <cstring>  // memcpy
+#include <type_traits>
+
+namespace aether {
+
+// ---------------------------------------------------------------------------
+// RingView — a slot ring whose geometry is known at compile time
+//
+// The generic publish() / consume() in libaether read capacity, slot size
+// and layout from the header on every call and index with a runtime mask
+// and stride. When a topic's geometry is fixed by the application, a
+// RingView checks the header once, in attach_view(), and from then on every
+// slot address is the segment base plus constants: the mask, strides and
+// payload offset fold into the instruction stream, the size check is against
+// a literal, and the typed overloads copy with a fixed-size memcpy the
+// compiler turns into a few moves. Everything is inline in this header.
+//
+//   using TickRing = aether::RingView<65536, 16>;
+//   TickRing ticks;
+//   if (!aether::attach_view(sub.hdr, ticks)) { /* topic has another geometry */ }
+//   aether::publish(ticks, tick);                   // tick: a 16-byte struct
+//   aether::consume(ticks, tick, read_seq);
+//
+// The view speaks the same slot protocol as the generic functions (see
+// slot_protocol.h), so views and generic publishers and subscribers can
+// share a ring freely. The generic functions remain the fallback for
+// geometry only known at run time.
+// ---------------------------------------------------------------------------
+
+template <uint32_t Capacity, uint32_t SlotSize, SlotLayout Layout = SlotLayout::Interleaved>
+struct RingView {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "RingView capacity must be a power of two");
+    static_assert(SlotSize > 0 && SlotSize <= MAX_SLOT_DATA_SIZE,
+                  "RingView slot size must be 1..MAX_SLOT_DATA_SIZE");
+
+    static constexpr uint32_t    capacity          = Capacity;
+    static constexpr uint32_t    slot_size         = SlotSize;
+    static constexpr SlotLayout  layout            = Layout;
+    static constexpr uint64_t    mask              = Capacity - 1;
+    static constexpr std::size_t descriptor_stride = slot_descriptor_stride(SlotSize, Layout);
+    static constexpr std::size_t payload_stride    = slot_payload_stride(SlotSize, Layout);
+    static constexpr std::size_t payload_offset    = slot_payload_offset(Capacity, Layout);
+
+    RingHeader* hdr = nullptr;  // set by attach_view()
+
+    SlotDescriptor& descriptor(uint64_t index) const {
+        return *reinterpret_cast<SlotDescriptor*>(reinterpret_cast<uint8_t*>(hdr) + sizeof(RingHeader) +
+                                                  index * descriptor_stride);
+    }
+    uint8_t* payload(uint64_t index) const {
+        return reinterpret_cast<uint8_t*>(hdr) + payload_offset + index * payload_stride;
+    }
+};
+
+// Bind `view` to a mapped ring. Returns false, leaving `view` untouched, if
+// the segment is not a slot ring of exactly the view's capacity, slot size
+// and layout — the one check that makes the constants safe to use. Views
+// write no MessageHeaders, so a ring created with them is refused too.
+template <uint32_t C, uint32_t S, SlotLayout L>
+bool attach_view(RingHeader* hdr, RingView<C, S, L>& view) {
+    assert(hdr != nullptr);
+    if (hdr->magic != RING_MAGIC || hdr->version != RING_VERSION ||
+        hdr->capacity != C || hdr->slot_size != S || hdr->slot_layout != L ||
+        hdr->message_headers != MessageHeaders::None) {
+        return false;
+    }
+    view.hdr = hdr;
+    return true;
+}
+
+// Same contract as publish(RingHeader*, ...): thread-safe, honours the
+// topic's OverflowPolicy and an ExclusivePublication holding the ring.
+template <uint32_t C, uint32_t S, SlotLayout L>
+inline PublishResult publish(const RingView<C, S, L>& view, const void* data, uint32_t len) {
+    assert(view.hdr != nullptr);
+    assert(data != nullptr);
+
+    if (len > S) {
+        return PublishResult::TooLarge;
+    }
+    RingHeader* hdr = view.hdr;
+
+    while (true) {
+        uint64_t seq;
+        if (!claim_sequences(hdr, 1, seq)) {
+            return claim_refusal(hdr);
+        }
+        SlotDescriptor& slot = view.descriptor(seq & RingView<C, S, L>::mask);
+        if (!begin_write(slot, seq)) {
+            continue;  // lapped before we reached the slot — claim again
+        }
+        memcpy(view.payload(seq & RingView<C, S, L>::mask), data, len);
+        release_slot(slot, seq, len, 0);
+        wake_subscribers(hdr->wakeup);
+        return PublishResult::Ok;
+    }
+}
+
+// Publish one trivially copyable T — a fixed-size copy of sizeof(T) bytes.
+// A T that does not fit the view's slots fails to compile instead of
+// returning TooLarge.
+template <uint32_t C, uint32_t S, SlotLayout L, typename T>
+inline PublishResult publish(const RingView<C, S, L>& view, const T& msg) {
+    static_assert(std::is_trivially_copyable_v<T>, "RingView messages must be trivially copyable");
+    static_assert(sizeof(T) <= S, "message type does not fit the view's slot size");
+    return publish(view, &msg, static_cast<uint32_t>(sizeof(T)));
+}
+
+// Same contract as consume(RingHeader*, ...), for messages of one slot: a
+// buffer of S bytes holds any message, a smaller one gets TooLarge for a
+// message longer than buf_len. Fragmented messages are not
+// reassembled — each piece is returned on its own — so topics that carry
+// them are consumed through the generic functions.
+template <uint32_t C, uint32_t S, SlotLayout L>
+inline ConsumeResult consume(const RingView<C, S, L>& view, void* buf, uint32_t& buf_len,
+                             uint64_t& read_seq) {
+    assert(view.hdr != nullptr);
+    assert(buf != nullptr);
+
+    while (true) {
+        const uint64_t index = read_seq & RingView<C, S, L>::mask;
+        SlotDescriptor& slot = view.descriptor(index);
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (seq == read_seq) {
+            if (slot.flags & SLOT_FLAG_ABORTED) {
+                ++read_seq;
+                continue;
+            }
+
+            // Checked against the sequence before it is reported, like the
+            // payload: a lapping writer may have changed it.
+            const uint32_t msg_len = slot.payload_len;
+            if (msg_len > buf_len) {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_acquire) != seq) {
+                    read_seq = ring_head(view.hdr) - C;
+                    return ConsumeResult::Lapped;
+                }
+                buf_len = msg_len;
+                return ConsumeResult::TooLarge;
+            }
+            memcpy(buf, view.payload(index), msg_len);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_acquire) != seq) {
+                read_seq = ring_head(view.hdr) - C;
+                return ConsumeResult::Lapped;
+            }
+
+            buf_len = msg_len;
+            ++read_seq;
+            return ConsumeResult::Ok;
+        }
+
+        if ((seq & ~SLOT_WRITING) <= read_seq) {
+            return ring_drained(view.hdr, read_seq) ? ConsumeResult::Superseded : ConsumeResult::Empty;
+        }
+
+        read_seq = ring_head(view.hdr) - C;
+        return ConsumeResult::Lapped;
+    }
+}
+
+// Consume one T published with publish(view, const T&): a fixed-size copy
+// of sizeof(T) bytes. Every message on the topic should be a T; one of any
+// other length is TooLarge, with read_seq left on it for the byte consume()
+// to read. As with consume(), `msg` may have been overwritten when the
+// result is Lapped or TooLarge.
+template <uint32_t C, uint32_t S, SlotLayout L, typename T>
+inline ConsumeResult consume(const RingView<C, S, L>& view, T& msg, uint64_t& read_seq) {
+    static_assert(std::is_trivially_copyable_v<T>, "RingView messages must be trivially copyable");
+    static_assert(sizeof(T) <= S, "message type does not fit the view's slot size");
+    assert(view.hdr != nullptr);
+
+    while (true) {
+        const uint64_t index = read_seq & RingView<C, S, L>::mask;
+        SlotDescriptor& slot = view.descriptor(index);
+        const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
+
+        if (seq == read_seq) {
+            if (slot.flags & SLOT_FLAG_ABORTED) {
+                ++read_seq;
+                continue;
+            }
+            // The length is only trusted once the re-check below has shown
+            // that the slot still holds this sequence.
+            const uint32_t msg_len = slot.payload_len;
+            memcpy(&msg, view.payload(index), sizeof(T));
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_acquire) != seq) {
+                read_seq = ring_head(view.hdr) - C;
+                return ConsumeResult::Lapped;
+            }
+            if (msg_len != sizeof(T)) {
+                return ConsumeResult::TooLarge;
+            }
+
+            ++read_seq;
+            return ConsumeResult::Ok;
+        }
+
+        if ((seq & ~SLOT_WRITING) <= read_seq) {
+            return ring_drained(view.hdr, read_seq) ? ConsumeResult::Superseded : ConsumeResult::Empty;
+        }
+
+        read_seq = ring_head(view.hdr) - C;
+        return ConsumeResult::Lapped;
+    }
+}
+
+} // namespace aether
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "aether/arena.h"
 #include "aether/ring.h"
+#include "aether/term_log.h"
 #include <cstdint>
 #include <cstddef>
+#include <string>
+#include <vector>
 
 namespace aether {
 
@@ -11,10 +15,76 @@ namespace aether {
 // ---------------------------------------------------------------------------
 
 // Returns the total number of bytes needed for a shm segment that holds
-// one RingHeader followed by `capacity` Slots.
+// one RingHeader followed by `capacity` slots of `slot_size` payload bytes
+// arranged as `layout`, and a MessageHeader per slot unless `headers` is None.
 // This is what we pass to ftruncate() when creating the segment.
-constexpr std::size_t shm_segment_size(uint32_t capacity) {
-    return sizeof(RingHeader) + capacity * sizeof(Slot);
+constexpr std::size_t shm_segment_size(uint32_t capacity, uint32_t slot_size = SLOT_DATA_SIZE,
+                                       SlotLayout layout = SlotLayout::Interleaved,
+                                       MessageHeaders headers = MessageHeaders::None) {
+    return message_header_offset(capacity, slot_size, layout) +
+           (headers == MessageHeaders::None ? 0 : capacity * sizeof(MessageHeader));
+}
+
+// Size of an existing ring's segment, from its header.
+inline std::size_t shm_segment_size(const RingHeader* hdr) {
+    return shm_segment_size(hdr->capacity, hdr->slot_size, hdr->slot_layout, hdr->message_headers);
+}
+
+// ---------------------------------------------------------------------------
+// Segment options
+// ---------------------------------------------------------------------------
+
+// Where huge-page segments live. POSIX shm (/dev/shm) is tmpfs and cannot
+// hand out hugetlb pages, so these segments are files on a hugetlbfs mount
+// under the same name: "/aether_prices" → HUGETLBFS_PATH "/aether_prices".
+constexpr char HUGETLBFS_PATH[] = "/dev/hugepages";
+
+// How a new segment is backed. Only the creator chooses; attaching finds the
+// segment wherever it lives and reads the rest from the header.
+struct SegmentOptions {
+    // Back the segment with huge pages (2 MB on x86-64) from the hugetlbfs
+    // mount, its size rounded up to a whole number of them. A 4 MB ring then
+    // needs 2 dTLB entries instead of ~1000. If there is no mount or the
+    // pool is exhausted, the segment falls back to ordinary shm pages
+    // (advised MADV_HUGEPAGE, in case the kernel does shmem THP).
+    // The header's page_size says which one it got.
+    bool huge_pages = false;
+
+    // Residency policy, stored in the header as RESIDENCY_* bits so every
+    // process mapping the topic applies it (see apply_residency()).
+    // Without any of them, the first lap around a fresh mapping takes a
+    // page fault per 4 KB touched.
+    bool prefault  = false;  // populate page tables when mapped
+    bool lock      = false;  // mlock the mapping
+    bool dont_fork = false;  // MADV_DONTFORK on the mapping
+
+    // Bind the segment's memory to this NUMA node (mbind, before anything
+    // touches it), so the ring lives next to the CPUs that use it rather
+    // than wherever the creating thread happened to run. -1: first touch.
+    // A node that does not exist fails creation with EINVAL.
+    int32_t numa_node = -1;
+
+    // Slot rings only (term logs ignore them): payload bytes per slot, at
+    // most MAX_SLOT_DATA_SIZE — a 16-byte tick topic need not pay for 4 KB
+    // slots — and whether descriptors sit in their own dense array instead
+    // of at the head of each slot (see SlotLayout).
+    uint32_t   slot_size   = SLOT_DATA_SIZE;
+    SlotLayout slot_layout = SlotLayout::Interleaved;
+
+    // Slot rings only: give every slot a MessageHeader stamped with this
+    // clock (see MessageHeader in ring.h). None keeps the segment as it was.
+    MessageHeaders message_headers = MessageHeaders::None;
+
+    uint32_t residency() const {
+        return (prefault ? RESIDENCY_PREFAULT : 0) | (lock ? RESIDENCY_LOCK : 0) |
+               (dont_fork ? RESIDENCY_DONTFORK : 0);
+    }
+};
+
+// Round a segment size up to a whole number of `page_size` pages — the
+// length actually mapped.
+constexpr std::size_t segment_mapped_size(std::size_t size, uint32_t page_size) {
+    return (size + page_size - 1) / page_size * page_size;
 }
 
 // ---------------------------------------------------------------------------
@@ -22,20 +92,31 @@ constexpr std::size_t shm_segment_size(uint32_t capacity) {
 // ---------------------------------------------------------------------------
 
 // Create a new named shm segment, map it into this process, and initialise
-// the RingHeader (magic, version, capacity, write_seq = 0).
-// Also initialises each Slot's sequence number to its index (i), so that
-// a subscriber waiting for sequence 0 will correctly see slot 0 as not-yet-written.
+// the RingHeader (magic, version, capacity, write_seq = 1).
+// The slots rely on the fresh segment's zero fill — a zero descriptor
+// sequence means "not written yet" — so creation touches the header pages
+// only and each slot page is faulted in when it is first published.
 //
 // `name`     — POSIX shm name, must start with '/' (e.g. "/aether-prices")
-// `capacity` — number of Slots in the ring; must be a power of two (not enforced here)
+// `capacity` — number of slots in the ring; must be a power of two
+// `policy`   — what publish() does when unread messages fill the ring
+// `options`  — page backing and slot size, see SegmentOptions
 //
 // Returns a pointer to the mapped RingHeader on success, nullptr on failure.
-// On failure, errno is set by the failing syscall.
-RingHeader* shm_create(const char* name, uint32_t capacity);
+// On failure, errno is set by the failing syscall, or to EINVAL for a
+// capacity that is not a power of two, a slot size of 0 or above
+// MAX_SLOT_DATA_SIZE, or an unknown MessageHeaders clock.
+RingHeader* shm_create(const char* name, uint32_t capacity,
+                       OverflowPolicy policy = OverflowPolicy::Overwrite,
+                       const SegmentOptions& options = {});
 
 // Open an existing named shm segment and map it into this process.
+// Huge-page segments are found on HUGETLBFS_PATH when /dev/shm has no such name.
 // Validates that magic == RING_MAGIC and version == RING_VERSION before
-// returning — rejects stale or incompatible segments.
+// returning — rejects stale or incompatible segments. A segment whose header
+// geometry is one shm_create() would refuse, or whose size does not match
+// that geometry (truncated, or left half-created by a crash), fails with
+// EINVAL.
 //
 // Returns a pointer to the mapped RingHeader on success, nullptr on failure.
 RingHeader* shm_attach(const char* name);
@@ -45,10 +126,141 @@ RingHeader* shm_attach(const char* name);
 // After this call, `hdr` is invalid and must not be used.
 void shm_detach(RingHeader* hdr);
 
-// Delete the named shm segment. The segment continues to exist (and remain
+// Delete the named shm segment, whichever of /dev/shm or HUGETLBFS_PATH
+// holds it. The segment continues to exist (and remain
 // mapped) in any process that already has it attached, but no new process
 // can open it by name after this call.
 // Typically called by the daemon on shutdown.
 void shm_destroy(const char* name);
 
+// Names of the existing segments whose name starts with `prefix` (itself
+// starting with '/', e.g. "/aether_"), from /dev/shm and HUGETLBFS_PATH
+// alike, in no particular order. How a restarted daemon finds the segments
+// it left behind.
+std::vector<std::string> shm_list(const char* prefix);
+
+// ---------------------------------------------------------------------------
+// Residency
+// ---------------------------------------------------------------------------
+
+// Apply the segment's residency policy (hdr->residency) to this process's
+// mapping of it: populate the page tables, mlock, and/or mark it
+// MADV_DONTFORK. shm_create*() and shm_attach*() only record or read the
+// policy; subscribe() and the daemon apply it.
+//
+// Best effort — returns the RESIDENCY_* bits that took effect. mlock fails
+// beyond RLIMIT_MEMLOCK unless the process has CAP_IPC_LOCK; the mapping is
+// usable either way.
+uint32_t apply_residency(RingHeader* hdr);
+uint32_t apply_residency(LogHeader* hdr);
+
+// NUMA node holding the page at `addr` in this process's mapping, faulting
+// it in if needed. -1 if the kernel cannot say (no NUMA support).
+int numa_node_of(const void* addr);
+
+// "prefault+lock+dontfork", or "none" — for logs and stats.
+// `buf` holds the longest name.
+void format_residency(uint32_t residency, char (&buf)[32]);
+
+// ---------------------------------------------------------------------------
+// Term-log segments
+// ---------------------------------------------------------------------------
+
+// Create a new named shm segment holding a term log (see term_log.h) and
+// initialise its LogHeader. The terms rely on ftruncate's zero fill — a zero
+// FrameHeader means "not written yet".
+//
+// `term_length` — bytes per term; must be a power of two between
+//                 LOG_MIN_TERM_LENGTH and LOG_MAX_TERM_LENGTH (EINVAL otherwise)
+// `options`     — page backing, see SegmentOptions
+//
+// Returns a pointer to the mapped LogHeader on success, nullptr on failure.
+LogHeader* shm_create_log(const char* name, uint32_t term_length,
+                          const SegmentOptions& options = {});
+
+// Open an existing term-log segment and validate LOG_MAGIC / LOG_VERSION.
+// Returns nullptr if the segment is missing, stale, or a slot ring.
+LogHeader* shm_attach_log(const char* name);
+
+// Unmap a term-log segment. Same contract as shm_detach(RingHeader*).
+void shm_detach(LogHeader* hdr);
+
+// ---------------------------------------------------------------------------
+// Arena segments
+// ---------------------------------------------------------------------------
+
+// Bytes an arena_create_ring() of this geometry takes out of an arena whose
+// pages are `page_size` bytes.
+constexpr std::size_t arena_ring_size(uint32_t capacity, uint32_t slot_size, SlotLayout layout,
+                                      MessageHeaders headers, uint32_t page_size) {
+    return segment_mapped_size(shm_segment_size(capacity, slot_size, layout, headers), page_size);
+}
+
+// Create a new named shm segment of at least `size` bytes holding an empty
+// arena (see arena.h). options.huge_pages and options.numa_node back the
+// whole arena, as for shm_create(); every other option is per ring.
+//
+// Returns a pointer to the mapped ArenaHeader on success, nullptr on
+// failure (EINVAL if `size` cannot hold the header and one page).
+ArenaHeader* shm_create_arena(const char* name, std::size_t size, const SegmentOptions& options = {});
+
+// Open an existing arena and validate ARENA_MAGIC / ARENA_VERSION.
+// Returns nullptr if the segment is missing, stale, or not an arena.
+ArenaHeader* shm_attach_arena(const char* name);
+
+// Unmap an arena — and with it every ring this process found in it.
+// Same contract as shm_detach(RingHeader*).
+void shm_detach(ArenaHeader* arena);
+
+// Carve a slot ring named `name` out of `arena` and initialise it as
+// shm_create() would. The ring is backed like the arena: options.huge_pages
+// and options.numa_node are ignored, the rest apply. Only one process may
+// create rings in an arena; see arena.h.
+//
+// Returns the ring on success, nullptr on failure with errno set: EINVAL as
+// for shm_create() or for a name longer than ARENA_MAX_NAME_LEN, EEXIST if
+// the arena already has a ring by that name, ENOSPC if the arena's space or
+// directory is used up.
+RingHeader* arena_create_ring(ArenaHeader* arena, const char* name, uint32_t name_len,
+                              uint32_t capacity, OverflowPolicy policy = OverflowPolicy::Overwrite,
+                              const SegmentOptions& options = {});
+
+// ---------------------------------------------------------------------------
+// Ring migration
+//
+// A slot ring cannot grow in place: every process maps it at its size, and
+// a sequence's slot depends on the capacity. Instead the daemon creates a
+// larger successor and supersedes the old ring with it:
+//
+//   1. shm_supersede() seals the old ring. One CAS sets RING_SEALED on
+//      write_seq and fixes the ring's end: every sequence claimed before it
+//      is written to the old ring as usual, every claim after it is refused
+//      with PublishResult::Superseded.
+//   2. The successor carries on from that sequence, with copies of the old
+//      ring's cursors, and is recorded in the old header as a forwarding
+//      pointer (successor_name / successor_offset, published by
+//      successor_seq). Its epoch is one more than the old ring's.
+//   3. Subscribers drain the old ring up to its end, then get
+//      ConsumeResult::Superseded (PollResult::superseded) and migrate()
+//      (subscribe.h) to the successor at the same read_seq. Publishers
+//      migrate() when publish() returns Superseded, and publish again.
+//
+// No message is lost or delivered twice across the switch, and nobody
+// re-subscribes. The old ring stays valid in every process that has it
+// mapped, and the daemon keeps its name until it shuts down, so a process
+// that migrates late still finds the whole chain.
+// ---------------------------------------------------------------------------
+
+// Supersede `old` with `successor`: a ring nothing has been published to
+// yet, of the same slot size and at least the same capacity, created as
+// segment `successor_name` — or at `successor_offset` of arena
+// `successor_name` if that is not 0. Wakes the old ring's parked subscribers.
+//
+// Returns false with errno set, and neither ring changed: EBUSY if `old` is
+// held by an ExclusivePublication, EINVAL if it was superseded already or
+// `successor` does not fit the above, ENAMETOOLONG for a name of
+// RING_MAX_SUCCESSOR_NAME_LEN bytes or more.
+bool shm_supersede(RingHeader* old, RingHeader* successor, const char* successor_name,
+                   uint64_t successor_offset = 0);
+
 } // namespace aether
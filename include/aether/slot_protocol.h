@@ -0,0 +1,267 @@
+#pragma once
+
+#include "aether/ring.h"
+#include "aether/publish.h"
+
+#include <linux/futex.h>  // FUTEX_WAKE
+#include <sched.h>        // sched_yield
+#include <sys/syscall.h>  // SYS_futex
+#include <unistd.h>       // syscall
+
+#include <atomic>
+#include <climits>        // INT_MAX
+#include <cstdint>
+
+namespace aether {
+
+// ---------------------------------------------------------------------------
+// Slot protocol — the writer side of the per-slot seqlock
+//
+// The building blocks every slot-ring publish path is made of: claim a
+// sequence, take its slot, release it, wake parked subscribers. The inline
+// hot path (hot_path.h), which libaether's publish functions wrap, and the
+// compile-time RingView (ring_view.h) are both built from these, so the
+// protocol lives in exactly one place. They are inline so that both compile
+// into the caller's loop; applications should use the publish APIs, not these.
+// ---------------------------------------------------------------------------
+
+// Spins on another writer's unfinished copy before yielding the CPU to it.
+constexpr uint32_t STALLED_WRITER_SPINS = 64;
+
+// One iteration of waiting for another publisher to finish a write. It
+// normally finishes within one memcpy; if it does not, it has probably been
+// descheduled — give it the CPU.
+inline void wait_for_writer(uint32_t& spins) {
+    if (++spins < STALLED_WRITER_SPINS) {
+        cpu_relax();
+    } else {
+        sched_yield();
+    }
+}
+
+// Take ownership of `slot` for sequence `seq` — the "write-begin" half of
+// the seqlock, made safe for many producers.
+//
+// A plain store(0) is not enough once the ring wraps: a producer that
+// stalled between its fetch_add and its write can meet a producer one lap
+// ahead at the same slot, and two memcpys into one slot tear the payload
+// under a valid sequence. Instead the slot's sequence word is CASed from the
+// previous lap's committed value to `seq | SLOT_WRITING`, so exactly one
+// producer writes a slot at a time and lap order is preserved:
+//
+//   committed c < seq      → CAS to seq | WRITING, we own the slot
+//   WRITING for c < seq    → previous lap still copying; wait for its commit
+//   c (or WRITING c) > seq → a newer lap already owns the slot; our claim is
+//                            stale and we must not touch it → false
+//
+// The WRITING word also keeps subscribers out: it never equals a read_seq,
+// and compared without the bit it reads as "not written yet" to a subscriber
+// waiting on seq, and as "lapped" to one still waiting on the previous lap.
+inline bool begin_write(SlotDescriptor& slot, uint64_t seq) {
+    uint64_t cur = slot.sequence.load(std::memory_order_acquire);
+    uint32_t spins = 0;
+    while (true) {
+        if ((cur & ~SLOT_WRITING) >= seq) {
+            return false;
+        }
+        if (cur & SLOT_WRITING) {
+            wait_for_writer(spins);
+            cur = slot.sequence.load(std::memory_order_acquire);
+            continue;
+        }
+        // Acquire: our payload writes must not start before the previous
+        // lap's commit. On failure `cur` is reloaded and re-examined.
+        if (slot.sequence.compare_exchange_weak(cur, seq | SLOT_WRITING,
+                                                std::memory_order_acquire,
+                                                std::memory_order_acquire)) {
+            break;
+        }
+    }
+
+    // Keep the payload writes that follow from becoming visible before the
+    // WRITING mark — a subscriber that copied any of them then fails its
+    // re-check.
+    std::atomic_thread_fence(std::memory_order_release);
+    return true;
+}
+
+// Publish: store the sequence number with memory_order_release.
+// This is the fence — all writes above this line (payload_len, flags, data)
+// are guaranteed to be visible to any subscriber that reads this
+// atomic with memory_order_acquire and sees the new value.
+inline void release_slot(SlotDescriptor& slot, uint64_t seq, uint32_t len, uint32_t flags) {
+    slot.payload_len = len;
+    slot.flags       = flags;
+    slot.sequence.store(seq, std::memory_order_release);
+}
+
+// BackPressure topics: first sequence no publisher may claim — the slowest
+// attached cursor plus one ring. With no cursor attached nothing unread is
+// protected, but the limit still stops one ring past the current write_seq,
+// so publishers recompute it (and see a newly attached cursor) at least once
+// per lap.
+inline uint64_t compute_publish_limit(const RingHeader* hdr) {
+    uint64_t slowest = ring_head(hdr);
+    for (const SubscriberCursor& cursor : hdr->cursors) {
+        if (cursor.pid.load(std::memory_order_acquire) == 0) continue;
+        // Acquire pairs with update_cursor(): the subscriber is done reading
+        // every slot before this position, so they may be overwritten.
+        const uint64_t pos = cursor.read_seq.load(std::memory_order_acquire);
+        if (pos < slowest) slowest = pos;
+    }
+    return slowest + hdr->capacity;
+}
+
+// True if every sequence below `end` may be claimed without overwriting a
+// message an attached subscriber has not read. Scans the cursor table only
+// when the cached limit is exhausted.
+inline bool below_publish_limit(RingHeader* hdr, uint64_t end) {
+    if (end <= hdr->publish_limit.load(std::memory_order_acquire)) {
+        return true;
+    }
+    const uint64_t limit = compute_publish_limit(hdr);
+    hdr->publish_limit.store(limit, std::memory_order_release);
+    return end <= limit;
+}
+
+// True once the ring has been sealed for migration: no claim succeeds on it.
+inline bool ring_sealed(const RingHeader* hdr) {
+    return (hdr->write_seq.load(std::memory_order_relaxed) & RING_SEALED) != 0;
+}
+
+// True while an ExclusivePublication owns the ring.
+inline bool ring_exclusive(const RingHeader* hdr) {
+    return (hdr->write_seq.load(std::memory_order_relaxed) & RING_EXCLUSIVE) != 0;
+}
+
+// Claim `count` consecutive sequence numbers starting at `first`.
+// Returns false (nothing claimed) if a BackPressure topic has no room, the
+// ring is sealed, or an ExclusivePublication owns it — claim_refusal() tells
+// which.
+inline bool claim_sequences(RingHeader* hdr, uint64_t count, uint64_t& first) {
+    uint64_t seq = hdr->write_seq.load(std::memory_order_relaxed);
+    if (hdr->policy == OverflowPolicy::Overwrite) {
+        // The load above keeps a refused claim from bumping write_seq in the
+        // common case; the fetch_add's own result is what decides.
+        if (seq & RING_CLAIM_FLAGS) {
+            return false;
+        }
+        // fetch_add returns the old value — that becomes our sequence number.
+        // The slot's sequence word orders the payload; seq_cst is only for
+        // wake_subscribers(), and costs nothing extra on x86 — the locked
+        // add is a full barrier either way. A sealed or exclusively held
+        // ring hands out numbers past its end, which nobody writes or waits
+        // for: the seal ignores them and the owner's next store drops them.
+        first = hdr->write_seq.fetch_add(count, std::memory_order_seq_cst);
+        return !(first & RING_CLAIM_FLAGS);
+    }
+
+    // BackPressure: a fetch_add past the limit could not be handed back, so
+    // check the limit and claim in one CAS on write_seq.
+    do {
+        if ((seq & RING_CLAIM_FLAGS) || !below_publish_limit(hdr, seq + count)) {
+            return false;
+        }
+    } while (!hdr->write_seq.compare_exchange_weak(seq, seq + count, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed));
+    first = seq;
+    return true;
+}
+
+// What a publish call reports when claim_sequences() refused it.
+inline PublishResult claim_refusal(const RingHeader* hdr) {
+    const uint64_t seq = hdr->write_seq.load(std::memory_order_relaxed);
+    if (seq & RING_SEALED) {
+        return PublishResult::Superseded;
+    }
+    // An Overwrite ring refuses nothing else, even if the owner has let go
+    // since.
+    if ((seq & RING_EXCLUSIVE) || hdr->policy == OverflowPolicy::Overwrite) {
+        return PublishResult::Unavailable;
+    }
+    return PublishResult::BackPressured;
+}
+
+// Claim the next sequence number and take ownership of its slot; `payload`
+// is set to the slot's data and `header` to its MessageHeader (nullptr if
+// the ring has none). Shared by publish() and try_claim(). A claim
+// that was lapped before it reached its slot is abandoned and a fresh
+// sequence is claimed — subscribers waiting on the abandoned sequence see
+// the newer one and count a lap.
+// Returns nullptr if claim_sequences() refused.
+inline SlotDescriptor* claim_slot(RingHeader* hdr, uint64_t& seq, uint8_t*& payload,
+                                  MessageHeader*& header) {
+    const SlotGeometry slots = slot_geometry(hdr);
+    while (true) {
+        if (!claim_sequences(hdr, 1, seq)) {
+            return nullptr;
+        }
+
+        // Map sequence number to a slot index.
+        // The ring wraps: slot 0 is reused after `capacity` messages.
+        const uint64_t index = seq & hdr->index_mask;
+        SlotDescriptor& slot = slots.descriptor(index);
+        if (begin_write(slot, seq)) {
+            payload = slots.payload(index);
+            header  = slots.header(index);
+            return &slot;
+        }
+    }
+}
+
+// Timestamp for the headers of one publish call: the clock is only read on
+// rings that have headers.
+inline uint64_t header_now(const RingHeader* hdr) {
+    return hdr->message_headers == MessageHeaders::None ? 0 : header_timestamp(hdr->message_headers);
+}
+
+// Fill a slot's MessageHeader, if the ring has them. Written between
+// begin_write() and release_slot(), like the payload, so the subscriber's
+// re-check covers it too.
+inline void write_header(MessageHeader* header, uint64_t timestamp, const MessageMeta& meta) {
+    if (header == nullptr) {
+        return;
+    }
+    header->timestamp  = timestamp;
+    header->key        = meta.key;
+    header->session_id = meta.session_id;
+    header->type_id    = meta.type_id;
+}
+
+// Slots a message of `len` bytes is split into when it exceeds one slot.
+inline uint32_t fragment_count(uint32_t len, uint32_t slot_size) {
+    return (len + slot_size - 1) / slot_size;
+}
+
+// SlotDescriptor::flags of piece `i` out of `count`.
+inline uint32_t fragment_flags(uint32_t i, uint32_t count) {
+    return SLOT_FLAG_FRAGMENT | (i == 0 ? SLOT_FLAG_BEGIN : 0) | (i + 1 == count ? SLOT_FLAG_END : 0);
+}
+
+// ---------------------------------------------------------------------------
+// Wake-up — publisher side of SubscriberWakeup
+// ---------------------------------------------------------------------------
+
+// The segments are shared between processes, so this is the shared (not
+// FUTEX_PRIVATE_FLAG) operation — the kernel keys it by the physical page,
+// not the virtual address each process mapped it at.
+inline void futex_wake_all(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// Called after a message's position counter was advanced. Costs one load
+// while nobody is parked; only then bumps the futex word and makes the
+// syscall.
+//
+// seq_cst pairs with park_subscriber(): the publisher advances its counter
+// and then reads `waiters`, the subscriber bumps `waiters` and then reads the
+// counter. With all four in one total order at least one side sees the
+// other, so a subscriber never sleeps through the message it is waiting for.
+inline void wake_subscribers(SubscriberWakeup& w) {
+    if (w.waiters.load(std::memory_order_seq_cst) != 0) {
+        w.futex.fetch_add(1, std::memory_order_release);
+        futex_wake_all(&w.futex);
+    }
+}
+
+} // namespace aether
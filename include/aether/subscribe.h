@@ -1,6 +1,8 @@
 #pragma once
 
+#include "aether/control.h"
 #include "aether/ring.h"
+#include "aether/term_log.h"
 #include <cstddef>
 #include <cstdint>
 
@@ -8,21 +10,113 @@ namespace aether {
 
 // Handle returned by subscribe(). Passed to consume() and unsubscribe().
 struct Subscription {
-    RingHeader* hdr;       // pointer to the mapped ring buffer
-    size_t      map_size;  // total size of the mapping — needed for munmap()
+    RingHeader* hdr;        // pointer to the mapped ring buffer
+    size_t      map_size;   // total size of the mapping — needed for munmap(); for a
+                            // ring in a shared mapping, that mapping's size
+    uint32_t    residency;  // RESIDENCY_* bits in effect for this mapping
+    uint16_t    topic_id;   // tag of a multiplexed topic on the shared ring; 0 otherwise
+};
+
+// Slot geometry a subscribe() asks for when it creates the topic. A field left
+// at 0 takes the daemon's configured value for the topic (1024 slots of
+// SLOT_DATA_SIZE bytes unless configured otherwise).
+struct TopicGeometry {
+    uint32_t capacity  = 0;  // number of slots, a power of two
+    uint32_t slot_size = 0;  // payload bytes per slot, at most MAX_SLOT_DATA_SIZE
 };
 
 // Connect to the daemon, look up or create the shm segment for `topic`,
-// and map it into this process's address space.
+// and map it into this process's address space, applying the topic's
+// residency policy (prefault / mlock / MADV_DONTFORK, see apply_residency()).
 //
 // `topic`     — topic name (not null-terminated; length given by `topic_len`)
 // `topic_len` — length of topic name in bytes, must be <= MAX_TOPIC_LEN
+// `policy`    — overflow policy if this call creates the topic. An existing
+//               topic keeps its policy; check sub.hdr->policy if it matters.
+// `geometry`  — capacity and slot size if this call creates the topic. An
+//               existing topic keeps its own; see sub.hdr->capacity / slot_size.
+//
+// A `topic` of the form "channel/name" is a logical topic multiplexed on the
+// slot ring of topic "channel" (see "Multiplexed rings" in consume.h): the
+// Subscription maps the channel's ring and carries the topic's id, to be
+// polled with and published with through MessageMeta::topic_id. All logical
+// topics of one channel share a single mapping per process, released by the
+// last unsubscribe(). `policy` and `geometry` apply if the channel is created.
+//
+// When the daemon keeps the topic in its arena (arena.h), the arena is mapped
+// once per process and shared the same way; a later subscribe() to any
+// other topic already in it resolves the ring from the arena's directory
+// without contacting the daemon.
 //
 // Returns a Subscription on success.
-// Terminates (assert/abort) on any error — fail fast.
-Subscription subscribe(const char* topic, uint32_t topic_len);
+// Terminates (assert/abort) on any error, including an invalid geometry — fail fast.
+Subscription subscribe(const char* topic, uint32_t topic_len,
+                       OverflowPolicy policy = OverflowPolicy::Overwrite,
+                       const TopicGeometry& geometry = {});
 
-// Unmap the shm segment. After this call, `sub.hdr` is invalid.
+// Unmap the shm segment — for a multiplexed topic or a ring in an arena,
+// once no other subscription still uses the mapping. After this call,
+// `sub.hdr` is invalid.
 void unsubscribe(Subscription& sub);
 
+// ---------------------------------------------------------------------------
+// Live resize
+//
+// resize_topic() has the daemon supersede a topic's ring with a larger one
+// ("Ring migration" in shm.h). Nobody re-subscribes: each Subscription moves
+// over with migrate() when its ring tells it to —
+//
+//   - a subscriber once it has read everything the old ring holds:
+//     consume() returns ConsumeResult::Superseded, poll() sets
+//     PollResult::superseded. read_seq carries over unchanged.
+//   - a publisher when publish() returns PublishResult::Superseded; the
+//     message was not written, so publish it again afterwards.
+//
+//   const aether::PollResult r = aether::poll(sub.hdr, read_seq, handler, 64);
+//   if (r.superseded) {
+//       aether::migrate(sub, cursor);
+//   }
+//
+// Claims, packed slots and ExclusivePublications hold a RingHeader of their
+// own: commit or flush them, and release them, before migrating. A ring held
+// by an ExclusivePublication cannot be resized.
+// ---------------------------------------------------------------------------
+
+// Ask the daemon to grow `topic` to `capacity` slots, a power of two above
+// its current capacity. A multiplexed topic grows its channel's ring.
+// Returns the daemon's status: Ok, TopicNotFound, LayoutMismatch (term log),
+// InvalidGeometry, Busy (held by an ExclusivePublication) or InternalError.
+ControlStatus resize_topic(const char* topic, uint32_t topic_len, uint32_t capacity);
+
+// Move `sub` to the successor of its ring if the ring has been superseded:
+// map the successor (following the old header's forwarding pointer), release
+// the old ring as unsubscribe() would, and return true. False, with `sub`
+// untouched, while the ring is current — or if the successor is not
+// published within a park timeout (100 ms) of the seal, or cannot be mapped;
+// call it again later. A ring superseded more than once takes one migrate()
+// per step — the next ring reports Superseded in turn.
+bool migrate(Subscription& sub);
+
+// migrate() for a subscriber holding a BackPressure cursor (consume.h):
+// `cursor` moves to the successor too, at the same read position. A null
+// cursor stays null.
+bool migrate(Subscription& sub, SubscriberCursor*& cursor);
+
+// Handle returned by subscribe_log(). Passed to the term-log consume().
+struct LogSubscription {
+    LogHeader* hdr;        // pointer to the mapped term log
+    size_t     map_size;   // total size of the mapping — needed for munmap()
+    uint32_t   residency;  // RESIDENCY_* bits in effect for this mapping
+};
+
+// Same as subscribe(), but for a topic using the term-log layout. The first
+// subscriber creates the topic as a term log; if the topic already exists
+// with the slot layout, this fails.
+//
+// Terminates (assert/abort) on any error — fail fast.
+LogSubscription subscribe_log(const char* topic, uint32_t topic_len);
+
+// Unmap the term-log segment. After this call, `sub.hdr` is invalid.
+void unsubscribe(LogSubscription& sub);
+
 } // namespace aether
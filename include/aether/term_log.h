@@ -0,0 +1,155 @@
+#pragma once
+
+#include "aether/ring.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+namespace aether {
+
+// ---------------------------------------------------------------------------
+// Term log — Aeron-style alternative to the fixed-slot ring
+//
+// The log is LOG_PARTITION_COUNT term buffers used in rotation. Each term is an
+// append-only byte array of variable-length frames. Publishers claim bytes
+// with a single fetch_add on a 64-bit tail position; the position maps to a
+// term and an offset inside it:
+//
+//   term_id   = position >> term_shift
+//   partition = term_id % LOG_PARTITION_COUNT
+//   offset    = position & (term_length - 1)
+//
+// A frame is an 8-byte FrameHeader followed by the payload, padded so the
+// next frame starts on a FRAME_ALIGNMENT boundary. An 8-byte message takes
+// 16 bytes of log instead of a whole 4 KB slot, so four of them share a
+// cache line.
+// ---------------------------------------------------------------------------
+
+// Written into LogHeader::magic on initialisation. Distinct from RING_MAGIC so
+// a slot-ring client can never mistake a term log for its own layout.
+constexpr uint64_t LOG_MAGIC = 0xAE7E4000DEAD1060;
+
+// Bump this if the layout of LogHeader or FrameHeader ever changes incompatibly.
+constexpr uint32_t LOG_VERSION = 1;
+
+// Three terms: one being written, one still readable by lagging subscribers,
+// one being cleaned for reuse.
+constexpr uint32_t LOG_PARTITION_COUNT = 3;
+
+// Every frame starts on an 8-byte boundary so the FrameHeader tag is a
+// naturally aligned 64-bit atomic.
+constexpr uint32_t FRAME_ALIGNMENT = 8;
+
+// Term length bounds. Must be a power of two so position → offset is a mask.
+constexpr uint32_t LOG_MIN_TERM_LENGTH     = 4096;
+constexpr uint32_t LOG_MAX_TERM_LENGTH     = 1u << 30;
+constexpr uint32_t LOG_DEFAULT_TERM_LENGTH = 1u << 20;  // 1 MB — 3 MB mapped per topic
+
+// ---------------------------------------------------------------------------
+// FrameHeader — 8 bytes in front of every frame
+// ---------------------------------------------------------------------------
+
+// The whole header is one atomic word, stored last with memory_order_release:
+//
+//   bits 63..32  term_id of the term this frame was written in
+//   bits 31..28  frame flags (FRAME_FLAG_*)
+//   bits 27..0   frame length in bytes, header included, before alignment
+//
+// Because the term_id is part of the commit word, a subscriber can tell a
+// freshly committed frame from a leftover written LOG_PARTITION_COUNT terms
+// ago, and a zero word (cleaned memory) from either.
+struct FrameHeader {
+    std::atomic<uint64_t> tag;
+};
+
+static_assert(sizeof(FrameHeader) == FRAME_ALIGNMENT,
+              "FrameHeader must be exactly one alignment unit");
+
+// Padding frame: fills the end of a term that a claim did not fit into.
+// Subscribers skip it without delivering anything.
+constexpr uint32_t FRAME_FLAG_PAD = 0x8;
+
+constexpr uint32_t FRAME_LENGTH_MASK = 0x0FFF'FFFF;
+
+constexpr uint64_t make_frame_tag(uint64_t term_id, uint32_t flags, uint32_t length) {
+    return (term_id << 32) | (static_cast<uint64_t>(flags) << 28) | length;
+}
+
+constexpr uint32_t frame_term_id(uint64_t tag) { return static_cast<uint32_t>(tag >> 32); }
+constexpr uint32_t frame_flags(uint64_t tag)   { return static_cast<uint32_t>(tag >> 28) & 0xF; }
+constexpr uint32_t frame_length(uint64_t tag)  { return static_cast<uint32_t>(tag) & FRAME_LENGTH_MASK; }
+
+constexpr uint32_t align_frame(uint32_t length) {
+    return (length + FRAME_ALIGNMENT - 1) & ~(FRAME_ALIGNMENT - 1);
+}
+
+// Largest payload a single frame may carry. Capping a frame at 1/8 of a term
+// (as Aeron does) bounds the padding wasted at the end of each term and
+// guarantees a claim straddles at most one term boundary.
+constexpr uint32_t log_max_payload(uint32_t term_length) {
+    return term_length / 8 - static_cast<uint32_t>(sizeof(FrameHeader));
+}
+
+// ---------------------------------------------------------------------------
+// LogHeader — lives at offset 0 of a term-log shm segment
+// ---------------------------------------------------------------------------
+
+// Memory layout of the full shm segment:
+//
+//   [ LogHeader (aligned to 64 bytes) ]
+//   [ term partition 0 ][ term partition 1 ][ term partition 2 ]
+
+struct alignas(64) LogHeader {
+    // Sanity check: detect stale or foreign shm segments on attach.
+    uint64_t magic;
+
+    // Layout version: reject segments written by an incompatible binary.
+    uint32_t version;
+
+    // Bytes per term. Power of two, set once at creation.
+    uint32_t term_length;
+
+    // log2(term_length), so position → term_id is a shift.
+    uint32_t term_shift;
+
+    // Size of the pages backing the segment — see RingHeader::page_size.
+    uint32_t page_size;
+
+    // RESIDENCY_* bits every mapping of the segment should apply.
+    uint32_t residency;
+
+    // NUMA node the segment is bound to, or -1 — see RingHeader::numa_node.
+    int32_t numa_node;
+
+    // Term the publishers are currently appending to. Written once per term
+    // rotation and read by subscribers to detect that they were lapped, so it
+    // sits on its own cache line, away from the hot tail counter.
+    alignas(64) std::atomic<uint64_t> active_term_id;
+
+    // Every byte below this position is known to be zeroed (or already
+    // written in its current term). Publishers never write past it; the
+    // publisher that rotates into a new term cleans the next partition and
+    // then advances this.
+    std::atomic<uint64_t> clean_position;
+
+    // Next byte to claim, across all terms. Publishers fetch_add the aligned
+    // frame length to reserve space.
+    alignas(64) std::atomic<uint64_t> tail_position;
+
+    // Parked subscribers — next to the tail, which every publish writes.
+    SubscriberWakeup wakeup;
+};
+
+// Returns the total number of bytes needed for a term-log shm segment.
+constexpr std::size_t log_segment_size(uint32_t term_length) {
+    return sizeof(LogHeader) + static_cast<std::size_t>(LOG_PARTITION_COUNT) * term_length;
+}
+
+// Start of the partition holding `term_id`.
+inline uint8_t* log_term(LogHeader* hdr, uint64_t term_id) {
+    uint8_t* terms = reinterpret_cast<uint8_t*>(hdr + 1);
+    return terms + (term_id % LOG_PARTITION_COUNT) * hdr->term_length;
+}
+
+} // namespace aether
@@ -26,11 +26,25 @@ namespace aether {
 constexpr uint16_t DEFAULT_TCP_PORT = 9090;
 
 enum class MsgType : uint8_t {
-    Subscribe = 1,  // client → daemon: body = topic name
-    Publish   = 2,  // client → daemon: body = topic_len(4) + topic + payload
-    Message   = 3,  // daemon → client: body = payload
+    Subscribe       = 1,  // client → daemon: body = topic name
+    Publish         = 2,  // client → daemon: body = topic_len(4) + topic + payload
+    Message         = 3,  // daemon → client: body = payload
+    PublishFragment = 4,  // client → daemon: body = topic_len(4) + topic + flags(1) + piece
+    MessageFragment = 5,  // daemon → client: body = flags(1) + piece
 };
 
+// Fragment frame flags. A message too long for one frame, or one that sits
+// fragmented in a ring, travels as fragment frames sent back to back: BEGIN
+// on the first piece, END on the last, neither on the pieces in between.
+// The receiver reassembles; a Publish or Message frame, or a new BEGIN,
+// abandons a message still missing pieces.
+constexpr uint8_t WIRE_FRAGMENT_BEGIN = 0x1;
+constexpr uint8_t WIRE_FRAGMENT_END   = 0x2;
+
+// Largest payload remote_publish() sends as one Publish frame; longer
+// messages go as PublishFragment frames of at most this many bytes.
+constexpr uint32_t WIRE_MAX_FRAGMENT = 64 * 1024;
+
 struct WireHeader {
     MsgType  msg_type;
     uint32_t body_len;
@@ -1,58 +1,247 @@
 #include "aether/consume.h"
+#include "aether/hot_path.h"
+#include "futex.h"
 
 #include <cstring>  // memcpy
 #include <cassert>
+#include <unistd.h>  // getpid
 
 namespace aether {
 
+// The data path is inline in hot_path.h; these are its out-of-line copies
+// for callers that link against libaether instead of including it.
+
 ConsumeResult consume(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq) {
+    return hot::consume(hdr, buf, buf_len, read_seq);
+}
+
+ConsumeResult consume(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq,
+                      MessageHeader& header) {
+    return hot::consume(hdr, buf, buf_len, read_seq, &header);
+}
+
+ConsumeResult consume_view(RingHeader* hdr, uint64_t& read_seq, ViewHandler handler, void* ctx) {
+    assert(handler != nullptr);
+    return hot::consume_view(hdr, read_seq, [&](const MessageView& view) { handler(view, ctx); });
+}
+
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, ViewHandler handler, void* ctx,
+                uint32_t max_messages) {
+    assert(handler != nullptr);
+    return hot::poll(hdr, read_seq, [&](const MessageView& view) { handler(view, ctx); },
+                     max_messages);
+}
+
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, FragmentAssembler& assembler,
+                ViewHandler handler, void* ctx, uint32_t max_messages) {
+    assert(handler != nullptr);
+    return hot::poll(hdr, read_seq, assembler,
+                     [&](const MessageView& view) { handler(view, ctx); }, max_messages);
+}
+
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, ViewHandler handler,
+                void* ctx, uint32_t max_messages) {
+    assert(handler != nullptr);
+    return hot::poll(hdr, read_seq, topic_id,
+                     [&](const MessageView& view) { handler(view, ctx); }, max_messages);
+}
+
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, uint16_t topic_id, FragmentAssembler& assembler,
+                ViewHandler handler, void* ctx, uint32_t max_messages) {
+    assert(handler != nullptr);
+    return hot::poll(hdr, read_seq, topic_id, assembler,
+                     [&](const MessageView& view) { handler(view, ctx); }, max_messages);
+}
+
+PollResult poll(RingHeader* hdr, uint64_t& read_seq, PackedReader& reader, ViewHandler handler,
+                void* ctx, uint32_t max_slots) {
+    assert(handler != nullptr);
+    return hot::poll(hdr, read_seq, reader,
+                     [&](const MessageView& view) { handler(view, ctx); }, max_slots);
+}
+
+// ---------------------------------------------------------------------------
+// Subscriber cursors
+// ---------------------------------------------------------------------------
+
+SubscriberCursor* attach_cursor(RingHeader* hdr, uint64_t read_seq) {
+    assert(hdr != nullptr);
+
+    if (hdr->policy != OverflowPolicy::BackPressure) {
+        return nullptr;
+    }
+
+    const auto self = static_cast<uint32_t>(getpid());
+    for (SubscriberCursor& cursor : hdr->cursors) {
+        uint32_t free_pid = 0;
+        if (!cursor.pid.compare_exchange_strong(free_pid, self, std::memory_order_acq_rel)) {
+            continue;
+        }
+        cursor.read_seq.store(read_seq, std::memory_order_release);
+
+        // The cached publish limit may have been computed without us and be
+        // too high. Drop it so the next publish recomputes it with our cursor.
+        hdr->publish_limit.store(0, std::memory_order_release);
+        return &cursor;
+    }
+    return nullptr;
+}
+
+void detach_cursor(SubscriberCursor* cursor) {
+    if (cursor == nullptr) return;
+
+    // A cached limit that still counts us is only too low — publishers
+    // recompute it when they reach it — so there is nothing else to reset.
+    cursor->pid.store(0, std::memory_order_release);
+}
+
+SubscriberCursor* move_cursor(RingHeader* successor, const RingHeader* old, SubscriberCursor* cursor) {
+    if (cursor == nullptr) return nullptr;
+
+    const uint64_t read_seq = cursor->read_seq.load(std::memory_order_relaxed);
+    SubscriberCursor& copy = successor->cursors[cursor - old->cursors];
+    if (copy.pid.load(std::memory_order_acquire) == cursor->pid.load(std::memory_order_relaxed)) {
+        copy.read_seq.store(read_seq, std::memory_order_release);
+        return &copy;
+    }
+    return attach_cursor(successor, read_seq);
+}
+
+// ---------------------------------------------------------------------------
+// Blocking wait
+// ---------------------------------------------------------------------------
+
+// Shared by both layouts: `tail` is write_seq or tail_position, `pos` the
+// subscriber's read_seq or byte position.
+static bool wait_past(SubscriberWakeup& wakeup, const std::atomic<uint64_t>& tail, uint64_t pos,
+                      std::chrono::nanoseconds timeout) {
+    if (load_tail(tail, std::memory_order_acquire) > pos) {
+        return true;
+    }
+    return park_subscriber(wakeup, tail, pos, timeout);
+}
+
+// consume() until it returns something other than Empty or `timeout` runs
+// out, parking in between. A claim that is still being written wakes us
+// before its commit, so the retry spins briefly rather than parking again.
+template <typename Header>
+static ConsumeResult consume_until(Header* hdr, const std::atomic<uint64_t>& tail, void* buf,
+                                   uint32_t& buf_len, uint64_t& pos, std::chrono::nanoseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        const ConsumeResult r = consume(hdr, buf, buf_len, pos);
+        if (r != ConsumeResult::Empty) {
+            return r;
+        }
+        const auto remaining = deadline - std::chrono::steady_clock::now();
+        if (remaining <= std::chrono::nanoseconds::zero()) {
+            return ConsumeResult::Empty;
+        }
+        if (load_tail(tail, std::memory_order_acquire) > pos) {
+            cpu_relax();
+        } else {
+            park_subscriber(hdr->wakeup, tail, pos, remaining);
+        }
+    }
+}
+
+bool wait_for_message(RingHeader* hdr, uint64_t read_seq, std::chrono::nanoseconds timeout) {
+    assert(hdr != nullptr);
+    return wait_past(hdr->wakeup, hdr->write_seq, read_seq, timeout);
+}
+
+ConsumeResult consume_wait(RingHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& read_seq,
+                           std::chrono::nanoseconds timeout) {
+    assert(hdr != nullptr);
+    return consume_until(hdr, hdr->write_seq, buf, buf_len, read_seq, timeout);
+}
+
+// ---------------------------------------------------------------------------
+// Term log
+// ---------------------------------------------------------------------------
+
+// A term's partition is cleaned for reuse when publishers rotate into
+// term_id + 2. Until then everything committed in term_id stays intact.
+static bool log_lapped(const LogHeader* hdr, uint64_t term_id) {
+    return hdr->active_term_id.load(std::memory_order_relaxed) >= term_id + 2;
+}
+
+// Oldest term that has not started being cleaned.
+static uint64_t log_oldest_position(const LogHeader* hdr) {
+    const uint64_t active = hdr->active_term_id.load(std::memory_order_relaxed);
+    return (active - 1) << hdr->term_shift;
+}
+
+ConsumeResult consume(LogHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& position) {
     assert(hdr != nullptr);
     assert(buf != nullptr);
 
-    Slot* slots = reinterpret_cast<Slot*>(hdr + 1);
-    Slot& slot  = slots[read_seq % hdr->capacity];
-
-    // Load the slot's sequence number with memory_order_acquire.
-    // This is the other half of the release/acquire pair with publish().
-    // If we see seq == read_seq, we are guaranteed to also see the payload
-    // that was written before the producer's memory_order_release store.
-    const uint64_t seq = slot.sequence.load(std::memory_order_acquire);
-
-    if (seq == read_seq) {
-        // Message is ready. Copy the payload out.
-        const uint32_t msg_len = slot.payload_len;
-        memcpy(buf, slot.data, msg_len);
-
-        // Seqlock-style double-check: verify the slot wasn't overwritten
-        // while we were copying. If sequence changed, the publisher lapped
-        // us mid-read and the payload is potentially corrupted.
-        const uint64_t seq_after = slot.sequence.load(std::memory_order_acquire);
-        if (seq_after != seq) {
-            const uint64_t write_seq = hdr->write_seq.load(std::memory_order_relaxed);
-            read_seq = write_seq - hdr->capacity;
+    const uint64_t term_mask = hdr->term_length - 1;
+
+    while (true) {
+        const uint64_t term_id = position >> hdr->term_shift;
+        uint8_t* frame = log_term(hdr, term_id) + (position & term_mask);
+
+        // Acquire pairs with the publisher's release store of the tag: if we
+        // see this term's tag, we also see the payload written before it.
+        const uint64_t tag = reinterpret_cast<FrameHeader*>(frame)->tag.load(std::memory_order_acquire);
+
+        if (frame_term_id(tag) != static_cast<uint32_t>(term_id) || frame_length(tag) == 0) {
+            // Nothing committed here for this term yet — either the publisher
+            // has not got this far, or the partition was already recycled.
+            if (log_lapped(hdr, term_id)) {
+                position = log_oldest_position(hdr);
+                return ConsumeResult::Lapped;
+            }
+            return ConsumeResult::Empty;
+        }
+
+        const uint32_t length = frame_length(tag);
+
+        if (frame_flags(tag) & FRAME_FLAG_PAD) {
+            // Padding lengths are already aligned. Skip and look again.
+            position += length;
+            continue;
+        }
+
+        const uint32_t msg_len = length - static_cast<uint32_t>(sizeof(FrameHeader));
+        if (msg_len > buf_len) {
+            // Only reported once the term is known not to be recycled under
+            // us — the tag may have come from a partition being cleaned.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (log_lapped(hdr, term_id)) {
+                position = log_oldest_position(hdr);
+                return ConsumeResult::Lapped;
+            }
+            buf_len = msg_len;
+            return ConsumeResult::TooLarge;
+        }
+        memcpy(buf, frame + sizeof(FrameHeader), msg_len);
+
+        // Reader half of the rotation seqlock: the fence keeps the copy above
+        // from being reordered after the active_term_id load below. If the
+        // partition was not being cleaned when we checked, the copy is intact.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (log_lapped(hdr, term_id)) {
+            position = log_oldest_position(hdr);
             return ConsumeResult::Lapped;
         }
 
-        buf_len = msg_len;
-        ++read_seq;
+        buf_len   = msg_len;
+        position += align_frame(length);
         return ConsumeResult::Ok;
     }
+}
 
-    if (seq < read_seq) {
-        // Slot hasn't been written yet — producer hasn't reached this
-        // sequence number. Nothing to read.
-        return ConsumeResult::Empty;
-    }
+bool wait_for_message(LogHeader* hdr, uint64_t position, std::chrono::nanoseconds timeout) {
+    assert(hdr != nullptr);
+    return wait_past(hdr->wakeup, hdr->tail_position, position, timeout);
+}
 
-    // seq > read_seq: we were lapped. The producer has overwritten the slot
-    // we were about to read (and possibly many slots beyond it).
-    // Advance read_seq to the oldest message still in the ring:
-    //   write_seq - capacity = the sequence number of the oldest live slot.
-    // Load write_seq with relaxed ordering — we just need an approximate
-    // value to catch up; the acquire on slot.sequence above is the real fence.
-    const uint64_t write_seq = hdr->write_seq.load(std::memory_order_relaxed);
-    read_seq = write_seq - hdr->capacity;
-    return ConsumeResult::Lapped;
+ConsumeResult consume_wait(LogHeader* hdr, void* buf, uint32_t& buf_len, uint64_t& position,
+                           std::chrono::nanoseconds timeout) {
+    assert(hdr != nullptr);
+    return consume_until(hdr, hdr->tail_position, buf, buf_len, position, timeout);
 }
 
 } // namespace aether
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "aether/ring.h"
+#include "aether/slot_protocol.h"  // wake_subscribers, futex_wake_all
+
+#include <linux/futex.h>  // FUTEX_WAIT
+#include <sys/syscall.h>  // SYS_futex
+#include <unistd.h>       // syscall
+
+#include <chrono>
+#include <ctime>          // timespec
+
+// Private to libaether: the subscriber side of SubscriberWakeup. The
+// publisher side (wake_subscribers()) is in slot_protocol.h, where the
+// inline publish paths can reach it.
+//
+// The segments are shared between processes, so these are the shared (not
+// FUTEX_PRIVATE_FLAG) futex operations — the kernel keys them by the
+// physical page, not the virtual address each process mapped it at.
+
+namespace aether {
+
+// Sleep while `*word == expected`, for at most `timeout`. Returns on a wake,
+// a timeout, a signal, or immediately if the word already changed — callers
+// re-check their condition either way.
+inline void futex_wait(std::atomic<uint32_t>* word, uint32_t expected, std::chrono::nanoseconds timeout) {
+    const auto ns = timeout.count();
+    timespec ts{};
+    ts.tv_sec  = static_cast<time_t>(ns / 1'000'000'000);
+    ts.tv_nsec = static_cast<long>(ns % 1'000'000'000);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+// `tail` as a position. write_seq carries RING_EXCLUSIVE while a ring is
+// held exclusively; a seal is left in, so it reads as "past" and wakes the
+// subscriber to migrate.
+inline uint64_t load_tail(const std::atomic<uint64_t>& tail, std::memory_order order) {
+    return tail.load(order) & ~RING_EXCLUSIVE;
+}
+
+// Subscriber side: sleep until `tail` (write_seq or tail_position) moves
+// past `pos`, or `timeout` expires. Returns true if it did.
+inline bool park_subscriber(SubscriberWakeup& w, const std::atomic<uint64_t>& tail, uint64_t pos,
+                            std::chrono::nanoseconds timeout) {
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + timeout;
+
+    while (true) {
+        // Read the futex word before registering: a wake that lands after
+        // this point changes it, and FUTEX_WAIT then returns immediately.
+        const uint32_t word = w.futex.load(std::memory_order_acquire);
+        w.waiters.fetch_add(1, std::memory_order_seq_cst);
+
+        const bool ready = load_tail(tail, std::memory_order_seq_cst) > pos;
+        if (!ready) {
+            const auto remaining = deadline - clock::now();
+            if (remaining > std::chrono::nanoseconds::zero()) {
+                futex_wait(&w.futex, word, remaining);
+            }
+        }
+        w.waiters.fetch_sub(1, std::memory_order_relaxed);
+
+        if (ready || load_tail(tail, std::memory_order_acquire) > pos) {
+            return true;
+        }
+        if (clock::now() >= deadline) {
+            return false;
+        }
+    }
+}
+
+} // namespace aether
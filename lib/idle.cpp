@@ -0,0 +1,70 @@
+#include "aether/idle.h"
+#include "aether/consume.h"
+
+#include <sched.h>  // sched_yield
+#include <algorithm>
+#include <thread>   // this_thread::sleep_for
+
+namespace aether {
+
+void IdleStrategy::idle_step() {
+    if (mode == IdleMode::Yield) {
+        sched_yield();
+        return;
+    }
+
+    // Backoff, or Park with nothing to park on.
+    if (mode == IdleMode::Backoff) {
+        if (idle_count_ < max_spins) {
+            ++idle_count_;
+            cpu_relax();
+            return;
+        }
+        if (idle_count_ < max_spins + max_yields) {
+            ++idle_count_;
+            sched_yield();
+            return;
+        }
+        sleep_ = sleep_ == std::chrono::nanoseconds::zero() ? min_sleep
+                                                            : std::min(sleep_ * 2, max_sleep);
+        std::this_thread::sleep_for(sleep_);
+        return;
+    }
+    std::this_thread::sleep_for(max_sleep);
+}
+
+void IdleStrategy::idle_ring(RingHeader* hdr, uint64_t read_seq) {
+    if (mode == IdleMode::Park) {
+        wait_for_message(hdr, read_seq, park_timeout);
+        return;
+    }
+    idle_step();
+}
+
+void IdleStrategy::idle_log(LogHeader* hdr, uint64_t position) {
+    if (mode == IdleMode::Park) {
+        wait_for_message(hdr, position, park_timeout);
+        return;
+    }
+    idle_step();
+}
+
+bool parse_idle_mode(std::string_view name, IdleMode& mode) {
+    if (name == "busy-spin" || name == "spin") { mode = IdleMode::BusySpin; return true; }
+    if (name == "yield")                       { mode = IdleMode::Yield;    return true; }
+    if (name == "backoff")                     { mode = IdleMode::Backoff;  return true; }
+    if (name == "park")                        { mode = IdleMode::Park;     return true; }
+    return false;
+}
+
+const char* idle_mode_name(IdleMode mode) {
+    switch (mode) {
+        case IdleMode::BusySpin: return "busy-spin";
+        case IdleMode::Yield:    return "yield";
+        case IdleMode::Backoff:  return "backoff";
+        case IdleMode::Park:     return "park";
+    }
+    return "unknown";
+}
+
+} // namespace aether
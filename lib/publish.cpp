@@ -1,46 +1,326 @@
 #include "aether/publish.h"
+#include "aether/hot_path.h"
+#include "aether/slot_protocol.h"
 
 #include <cstring>  // memcpy
 #include <cassert>
+#include <cerrno>     // ESRCH
+#include <csignal>    // kill
+#include <unistd.h>   // getpid
 
 namespace aether {
 
-bool publish(RingHeader* hdr, const void* data, uint32_t len) {
+// The data path is inline in hot_path.h; these are its out-of-line copies
+// for callers that link against libaether instead of including it.
+
+PublishResult publish(RingHeader* hdr, const void* data, uint32_t len) {
+    return hot::publish(hdr, data, len);
+}
+
+PublishResult publish(RingHeader* hdr, const MessageMeta& meta, const void* data, uint32_t len) {
+    return hot::publish(hdr, meta, data, len);
+}
+
+PublishResult publish_batch(RingHeader* hdr, std::span<const PublishVec> msgs) {
+    return hot::publish_batch(hdr, msgs);
+}
+
+PublishResult publish_batch(RingHeader* hdr, const MessageMeta& meta, std::span<const PublishVec> msgs) {
+    return hot::publish_batch(hdr, meta, msgs);
+}
+
+PublishResult try_claim(RingHeader* hdr, uint32_t max_len, Claim& claim) {
     assert(hdr != nullptr);
-    assert(data != nullptr);
 
-    // Fail fast — no silent truncation.
-    if (len > SLOT_DATA_SIZE) {
+    if (max_len > hdr->slot_size) {
+        return PublishResult::TooLarge;
+    }
+
+    uint64_t seq;
+    uint8_t* payload;
+    MessageHeader* header;
+    SlotDescriptor* slot = claim_slot(hdr, seq, payload, header);
+    if (slot == nullptr) {
+        return claim_refusal(hdr);
+    }
+    claim = Claim{slot, seq, std::span<uint8_t>(payload, hdr->slot_size), hdr, header};
+    return PublishResult::Ok;
+}
+
+void commit(Claim& claim, uint32_t len) {
+    commit(claim, len, MessageMeta{});
+}
+
+void commit(Claim& claim, uint32_t len, const MessageMeta& meta) {
+    assert(claim.slot != nullptr);
+    assert(len <= claim.buffer.size());
+
+    write_header(claim.header, header_now(claim.hdr), meta);
+    release_slot(*claim.slot, claim.seq, len, slot_topic_flags(meta.topic_id));
+    wake_subscribers(claim.hdr->wakeup);
+    claim.slot = nullptr;
+}
+
+void abort(Claim& claim) {
+    assert(claim.slot != nullptr);
+
+    release_slot(*claim.slot, claim.seq, 0, SLOT_FLAG_ABORTED);
+    wake_subscribers(claim.hdr->wakeup);  // a parked subscriber must step over it
+    claim.slot = nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Packed publication
+// ---------------------------------------------------------------------------
+
+PackedPublication packed_publication(RingHeader* hdr, std::chrono::nanoseconds linger) {
+    assert(hdr != nullptr);
+    return PackedPublication{
+        .hdr       = hdr,
+        .claim     = {},
+        .used      = 0,
+        .records   = 0,
+        .opened_ns = 0,
+        .linger_ns = static_cast<uint64_t>(linger.count()),
+    };
+}
+
+PublishResult pack(PackedPublication& pub, const void* data, uint32_t len) {
+    return hot::pack(pub, data, len);
+}
+
+void flush(PackedPublication& pub) {
+    hot::flush(pub);
+}
+
+bool flush_lingering(PackedPublication& pub) {
+    if (pub.claim.slot == nullptr ||
+        header_timestamp(MessageHeaders::Monotonic) - pub.opened_ns < pub.linger_ns) {
         return false;
     }
+    hot::flush(pub);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Exclusive publication
+// ---------------------------------------------------------------------------
 
-    // Atomically claim the next sequence number.
-    // fetch_add returns the old value — that becomes our sequence number.
-    // memory_order_relaxed is sufficient here: we only need atomicity for
-    // the counter itself. The release fence comes later on the slot's sequence store.
-    const uint64_t seq = hdr->write_seq.fetch_add(1, std::memory_order_relaxed);
+// Where to go on from an owner that died holding the ring. Its write_seq may
+// be short of the slots it wrote (it stores write_seq after them) and may
+// carry numbers that refused shared claims added. The slots are exact: it
+// wrote in sequence order, so the newest one is where it stopped — rewritten
+// if it died copying into it.
+static uint64_t takeover_seq(RingHeader* hdr) {
+    const SlotGeometry slots = slot_geometry(hdr);
+    uint64_t next = 1;
+    for (uint32_t i = 0; i < hdr->capacity; ++i) {
+        const uint64_t cur = slots.descriptor(i).sequence.load(std::memory_order_acquire);
+        const uint64_t end = (cur & SLOT_WRITING) ? cur & ~SLOT_WRITING : cur + 1;
+        if (end > next) next = end;
+    }
+    return next;
+}
 
-    // Map sequence number to a slot index.
-    // The ring wraps: slot 0 is reused after `capacity` messages.
-    Slot* slots = reinterpret_cast<Slot*>(hdr + 1);
-    Slot& slot  = slots[seq % hdr->capacity];
+bool acquire_exclusive(RingHeader* hdr, ExclusivePublication& pub) {
+    assert(hdr != nullptr);
 
-    // Invalidate the slot before writing. Any consumer that loads this
-    // will see 0 < read_seq (since read_seq >= 1) and return Empty.
-    // This is the "write-begin" half of our seqlock — it prevents a
-    // consumer from reading partially written payload.
-    slot.sequence.store(0, std::memory_order_release);
+    const auto self = static_cast<uint32_t>(getpid());
+    uint32_t owner = 0;
+    while (!hdr->exclusive_pid.compare_exchange_strong(owner, self, std::memory_order_acq_rel)) {
+        // Held by someone. Only a claim whose process no longer exists is
+        // taken over; CAS again from exactly that pid so two would-be owners
+        // cannot both steal it.
+        if (owner == self || kill(static_cast<pid_t>(owner), 0) == 0 || errno != ESRCH) {
+            return false;
+        }
+    }
 
-    slot.payload_len = len;
-    memcpy(slot.data, data, len);
+    // Shut out shared claims. The same RMW tells us where they stopped, and
+    // whether the ring was sealed first — a superseded ring takes no more
+    // messages. The bit may already be set if we took over from a dead owner.
+    const uint64_t prev = hdr->write_seq.fetch_or(RING_EXCLUSIVE, std::memory_order_seq_cst);
+    if (prev & RING_SEALED) {
+        if (!(prev & RING_EXCLUSIVE)) {
+            hdr->write_seq.fetch_and(~RING_EXCLUSIVE, std::memory_order_relaxed);
+        }
+        uint32_t self_pid = self;
+        hdr->exclusive_pid.compare_exchange_strong(self_pid, 0, std::memory_order_release);
+        return false;
+    }
+    const uint64_t next = (prev & RING_EXCLUSIVE) ? takeover_seq(hdr) : prev & ~RING_CLAIM_FLAGS;
 
-    // Publish: store the sequence number with memory_order_release.
-    // This is the fence — all writes above this line (payload_len, data)
-    // are guaranteed to be visible to any subscriber that reads this
-    // atomic with memory_order_acquire and sees the new value.
-    slot.sequence.store(seq, std::memory_order_release);
+    // Every sequence below `next` was claimed by a shared publisher that may
+    // still be copying, or not even have marked its slot yet. Wait until each
+    // slot the next lap will reuse holds that sequence or a newer one, and is
+    // not being written: our plain stores must never meet begin_write().
+    // Shared claims were refused all through a dead owner's tenure, so a
+    // takeover has none to wait on.
+    if (!(prev & RING_EXCLUSIVE)) {
+        const SlotGeometry slots = slot_geometry(hdr);
+        const uint64_t oldest = next > hdr->capacity ? next - hdr->capacity : 1;
+        for (uint64_t s = oldest; s < next; ++s) {
+            const SlotDescriptor& slot = slots.descriptor(s & hdr->index_mask);
+            uint32_t spins = 0;
+            uint64_t cur = slot.sequence.load(std::memory_order_acquire);
+            while ((cur & SLOT_WRITING) || cur < s) {
+                wait_for_writer(spins);
+                cur = slot.sequence.load(std::memory_order_acquire);
+            }
+        }
+    }
 
+    // We own write_seq from here on. Drop whatever refused claims added to it
+    // since the fetch_or.
+    hdr->write_seq.store(next | RING_EXCLUSIVE, std::memory_order_seq_cst);
+    pub = ExclusivePublication{
+        .hdr      = hdr,
+        .slots     = slot_geometry(hdr),
+        .next_seq  = next,
+        .index     = static_cast<uint32_t>(next & hdr->index_mask),
+        .mask      = hdr->index_mask,
+        .slot_size = hdr->slot_size,
+    };
     return true;
 }
 
-} // namespace aether
\ No newline at end of file
+PublishResult publish(ExclusivePublication& pub, const void* data, uint32_t len) {
+    return hot::publish(pub, data, len);
+}
+
+PublishResult publish(ExclusivePublication& pub, const MessageMeta& meta, const void* data,
+                      uint32_t len) {
+    return hot::publish(pub, meta, data, len);
+}
+
+void release_exclusive(ExclusivePublication& pub) {
+    assert(pub.hdr != nullptr);
+
+    // Only clear our own claim — if it was taken over (we were presumed dead),
+    // the new owner keeps it. Clearing the bit is a store, not a fetch_and:
+    // it also drops whatever refused shared claims added to write_seq.
+    auto self = static_cast<uint32_t>(getpid());
+    if (pub.hdr->exclusive_pid.load(std::memory_order_relaxed) == self) {
+        pub.hdr->write_seq.store(pub.next_seq, std::memory_order_seq_cst);
+        pub.hdr->exclusive_pid.compare_exchange_strong(self, 0, std::memory_order_release);
+    }
+    pub.hdr = nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Term log
+// ---------------------------------------------------------------------------
+
+// Wait until every claim in `term_id` has committed its tag. Claims tile a
+// term exactly — frames, plus the pads a straddling claim writes — so
+// walking the committed lengths from offset 0 reaches the end of the term
+// only once no publisher is still copying into it.
+static void await_term_committed(LogHeader* hdr, uint64_t term_id) {
+    const uint8_t* term = log_term(hdr, term_id);
+    uint32_t offset = 0;
+    uint32_t spins  = 0;
+    while (offset < hdr->term_length) {
+        const auto* frame = reinterpret_cast<const FrameHeader*>(term + offset);
+        const uint64_t tag = frame->tag.load(std::memory_order_acquire);
+        if (frame_term_id(tag) == static_cast<uint32_t>(term_id) && frame_length(tag) != 0) {
+            offset += align_frame(frame_length(tag));
+            spins = 0;
+        } else {
+            wait_for_writer(spins);
+        }
+    }
+}
+
+// Called by the one publisher whose claim covers the first byte of `term_id`.
+// Tells subscribers the term moved on, then cleans the partition that the
+// *next* rotation will write into (its previous contents are two terms old).
+static void rotate_term(LogHeader* hdr, uint64_t term_id) {
+    // Seqlock-style writer: publish the new active term before touching the
+    // partition, so a subscriber that read stale bytes from it sees the
+    // lap when it re-checks active_term_id after its copy.
+    hdr->active_term_id.store(term_id, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // Partitions beyond the first LOG_PARTITION_COUNT terms start zeroed by
+    // ftruncate — only recycled ones need cleaning.
+    //
+    // A publisher that claimed in the old term and was descheduled before its
+    // memcpy may still be about to write there. Cleaning under it would let
+    // its late frame land on top of the partition's next term, so the clean
+    // waits for the old term to be fully committed first.
+    const uint64_t next = term_id + 1;
+    if (next >= LOG_PARTITION_COUNT) {
+        await_term_committed(hdr, next - LOG_PARTITION_COUNT);
+        memset(log_term(hdr, next), 0, hdr->term_length);
+    }
+
+    hdr->clean_position.store((term_id + 2) << hdr->term_shift, std::memory_order_release);
+}
+
+PublishResult publish(LogHeader* hdr, const void* data, uint32_t len) {
+    assert(hdr != nullptr);
+    assert(data != nullptr);
+
+    const uint32_t term_length = hdr->term_length;
+    if (len > log_max_payload(term_length)) {
+        return PublishResult::TooLarge;
+    }
+
+    const uint32_t frame_len = static_cast<uint32_t>(sizeof(FrameHeader)) + len;
+    const uint32_t aligned   = align_frame(frame_len);
+    const uint64_t term_mask = term_length - 1;
+
+    while (true) {
+        // Claim [pos, end). The frame's tag store below is what publishes the
+        // bytes to subscribers; seq_cst only orders the claim before
+        // wake_subscribers() — free on x86, where the add is locked anyway.
+        const uint64_t pos     = hdr->tail_position.fetch_add(aligned, std::memory_order_seq_cst);
+        const uint64_t end     = pos + aligned;
+        const uint64_t term_id = pos >> hdr->term_shift;
+        const uint64_t offset  = pos & term_mask;
+        const bool straddles   = offset + aligned > term_length;
+
+        // Never write into memory that still holds frames from
+        // LOG_PARTITION_COUNT terms ago. Only waits if publishers fill a
+        // whole term before the rotation has cleaned the next one.
+        uint32_t spins = 0;
+        while (end > hdr->clean_position.load(std::memory_order_acquire)) {
+            wait_for_writer(spins);
+        }
+
+        // Exactly one claim per term boundary rotates: the one that starts on
+        // it, or the one that straddles it.
+        if (offset == 0 && term_id != 0) {
+            rotate_term(hdr, term_id);
+        } else if (straddles) {
+            rotate_term(hdr, term_id + 1);
+        }
+
+        if (straddles) {
+            // The frame does not fit in this term. Pad out the rest of this
+            // term and the overshoot into the next one, then claim again.
+            const uint64_t term_end = term_length - offset;
+            auto* tail_pad = reinterpret_cast<FrameHeader*>(log_term(hdr, term_id) + offset);
+            auto* head_pad = reinterpret_cast<FrameHeader*>(log_term(hdr, term_id + 1));
+            tail_pad->tag.store(make_frame_tag(term_id, FRAME_FLAG_PAD,
+                                               static_cast<uint32_t>(term_end)),
+                                std::memory_order_release);
+            head_pad->tag.store(make_frame_tag(term_id + 1, FRAME_FLAG_PAD,
+                                               static_cast<uint32_t>(aligned - term_end)),
+                                std::memory_order_release);
+            continue;
+        }
+
+        uint8_t* frame = log_term(hdr, term_id) + offset;
+        memcpy(frame + sizeof(FrameHeader), data, len);
+
+        // Commit: the tag carries the term_id, so this single release store
+        // makes the frame visible and distinguishes it from stale bytes.
+        reinterpret_cast<FrameHeader*>(frame)->tag.store(
+            make_frame_tag(term_id, 0, frame_len), std::memory_order_release);
+        wake_subscribers(hdr->wakeup);
+        return PublishResult::Ok;
+    }
+}
+
+} // namespace aether
@@ -2,8 +2,10 @@
 #include "aether/control.h"
 #include "aether/ring.h"
 
+#include <algorithm>  // std::min
 #include <cassert>
 #include <cstring>
+#include <vector>
 
 namespace aether {
 
@@ -18,14 +20,46 @@ void remote_disconnect(RemotePublisher& pub) {
     }
 }
 
+// A message longer than WIRE_MAX_FRAGMENT, sent as PublishFragment frames.
+static bool publish_fragments(int fd, const char* topic, uint32_t topic_len,
+                              const uint8_t* data, uint32_t data_len) {
+    std::vector<uint8_t> body(4 + topic_len + 1 + WIRE_MAX_FRAGMENT);
+    std::memcpy(body.data(), &topic_len, 4);
+    std::memcpy(body.data() + 4, topic, topic_len);
+    uint8_t* flags = body.data() + 4 + topic_len;
+
+    for (uint32_t off = 0; off < data_len; off += WIRE_MAX_FRAGMENT) {
+        const uint32_t piece = std::min(WIRE_MAX_FRAGMENT, data_len - off);
+        *flags = (off == 0 ? WIRE_FRAGMENT_BEGIN : 0) |
+                 (off + piece == data_len ? WIRE_FRAGMENT_END : 0);
+        std::memcpy(flags + 1, data + off, piece);
+        if (!send_msg(fd, MsgType::PublishFragment, body.data(), 4 + topic_len + 1 + piece)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool remote_publish(RemotePublisher& pub,
                     const char* topic, uint32_t topic_len,
                     const void* data, uint32_t data_len) {
     assert(pub.fd >= 0);
 
+    if (topic_len > MAX_TOPIC_LEN || data_len > MAX_MESSAGE_SIZE) return false;
+    if (data_len > WIRE_MAX_FRAGMENT) {
+        return publish_fragments(pub.fd, topic, topic_len, static_cast<const uint8_t*>(data), data_len);
+    }
+
+    // Default-sized payloads are staged on the stack; only larger ones pay
+    // for a heap buffer.
     const uint32_t body_len = 4 + topic_len + data_len;
-    uint8_t body[4 + MAX_TOPIC_LEN + SLOT_DATA_SIZE];
-    if (body_len > sizeof(body)) return false;
+    uint8_t stack_body[4 + MAX_TOPIC_LEN + SLOT_DATA_SIZE];
+    std::vector<uint8_t> heap_body;
+    uint8_t* body = stack_body;
+    if (body_len > sizeof(stack_body)) {
+        heap_body.resize(body_len);
+        body = heap_body.data();
+    }
 
     std::memcpy(body, &topic_len, 4);
     std::memcpy(body + 4, topic, topic_len);
@@ -27,31 +27,75 @@ void remote_disconnect(RemoteSubscriber& sub) {
     }
 }
 
+// Read and drop `len` bytes of a fragment that is not being assembled.
+static bool discard(int fd, uint32_t len) {
+    uint8_t scratch[4096];
+    while (len > 0) {
+        const uint32_t n = len < sizeof(scratch) ? len : static_cast<uint32_t>(sizeof(scratch));
+        if (!read_exact(fd, scratch, n)) return false;
+        len -= n;
+    }
+    return true;
+}
+
 int remote_consume(RemoteSubscriber& sub, void* buf, uint32_t buf_capacity,
                    int timeout_ms) {
     assert(sub.fd >= 0);
 
-    pollfd pfd{};
-    pfd.fd     = sub.fd;
-    pfd.events = POLLIN;
-    int ready = poll(&pfd, 1, timeout_ms);
-    if (ready <= 0)
-        return -1;
+    auto* out = static_cast<uint8_t*>(buf);
+    uint32_t have       = 0;      // bytes of a fragmented message assembled so far
+    bool     assembling = false;
+    bool     overflow   = false;  // the message being assembled does not fit buf
 
-    WireHeader whdr{};
-    if (!read_exact(sub.fd, &whdr, sizeof(whdr)))
-        return -1;
+    while (true) {
+        pollfd pfd{};
+        pfd.fd     = sub.fd;
+        pfd.events = POLLIN;
+        int ready = poll(&pfd, 1, timeout_ms);
+        if (ready <= 0)
+            return -1;
 
-    if (whdr.msg_type != MsgType::Message)
-        return -1;
+        WireHeader whdr{};
+        if (!read_exact(sub.fd, &whdr, sizeof(whdr)))
+            return -1;
 
-    if (whdr.body_len > buf_capacity)
-        return -1;
+        if (whdr.msg_type == MsgType::Message) {
+            if (whdr.body_len > buf_capacity)
+                return -1;
+            if (!read_exact(sub.fd, buf, whdr.body_len))
+                return -1;
+            return static_cast<int>(whdr.body_len);
+        }
 
-    if (!read_exact(sub.fd, buf, whdr.body_len))
-        return -1;
+        if (whdr.msg_type != MsgType::MessageFragment || whdr.body_len < 1)
+            return -1;
 
-    return static_cast<int>(whdr.body_len);
+        uint8_t flags;
+        if (!read_exact(sub.fd, &flags, 1))
+            return -1;
+        const uint32_t piece = whdr.body_len - 1;
+        if (flags & WIRE_FRAGMENT_BEGIN) {
+            assembling = true;
+            overflow   = false;
+            have       = 0;
+        }
+
+        // Pieces of a message whose BEGIN was lost (or that outgrew buf)
+        // are read off the socket and dropped, keeping the stream framed.
+        if (!assembling || overflow || piece > buf_capacity - have) {
+            overflow = assembling;
+            if (!discard(sub.fd, piece))
+                return -1;
+        } else {
+            if (!read_exact(sub.fd, out + have, piece))
+                return -1;
+            have += piece;
+        }
+
+        if (assembling && (flags & WIRE_FRAGMENT_END)) {
+            return overflow ? -1 : static_cast<int>(have);
+        }
+    }
 }
 
 } // namespace aether
@@ -1,10 +1,21 @@
 #include "aether/shm.h"
+#include "aether/slot_protocol.h"
 
-#include <sys/mman.h>   // mmap, munmap, shm_open, shm_unlink
+#include <sys/mman.h>   // mmap, munmap, madvise, mlock, shm_open, shm_unlink
 #include <sys/stat.h>   // mode constants (S_IRUSR, S_IWUSR)
+#include <sys/vfs.h>    // statfs
+#include <sys/syscall.h> // SYS_mbind, SYS_get_mempolicy
+#include <linux/magic.h> // HUGETLBFS_MAGIC
+#include <linux/mempolicy.h> // MPOL_BIND, MPOL_F_NODE, MPOL_F_ADDR
 #include <fcntl.h>      // O_CREAT, O_RDWR, O_EXCL
-#include <unistd.h>     // ftruncate, close
+#include <dirent.h>     // opendir, readdir
+#include <unistd.h>     // ftruncate, close, unlink, sysconf
+#include <climits>      // PATH_MAX
 #include <cassert>      // assert
+#include <cerrno>       // errno, EINVAL
+#include <cstdio>       // snprintf
+#include <cstring>      // strcat
+#include <algorithm>    // std::find
 #include <new>          // placement new
 
 namespace aether {
@@ -16,7 +27,7 @@ namespace aether {
 // Map a file descriptor into our address space as read+write.
 // Returns the mapped pointer, or nullptr if mmap fails.
 // fd is closed before returning — mmap keeps the mapping alive independently.
-static RingHeader* map_and_close(int fd, std::size_t size) {
+static void* map_and_close(int fd, std::size_t size) {
     void* ptr = mmap(
         nullptr,            // let the kernel choose the address
         size,               // total bytes to map
@@ -32,16 +43,118 @@ static RingHeader* map_and_close(int fd, std::size_t size) {
         return nullptr;
     }
 
-    return static_cast<RingHeader*>(ptr);
+    return ptr;
 }
 
-// ---------------------------------------------------------------------------
-// shm_create
-// ---------------------------------------------------------------------------
+// Highest NUMA node numa_node may name, plus one.
+static constexpr uint32_t MAX_NUMA_NODES = 1024;
 
-RingHeader* shm_create(const char* name, uint32_t capacity) {
-    assert(name != nullptr);
-    assert(capacity > 0);
+// Bind [addr, addr + size) to NUMA node `node` before any page is touched.
+// On a shared mapping this sets the policy of the shm object itself, so
+// pages are allocated on `node` whichever process faults them first.
+// glibc has no mbind() wrapper (libnuma does); the syscall is all we need.
+static bool bind_to_node(void* addr, std::size_t size, int32_t node) {
+    if (node < 0) {
+        return true;
+    }
+    if (static_cast<uint32_t>(node) >= MAX_NUMA_NODES) {
+        errno = EINVAL;
+        return false;
+    }
+
+    unsigned long mask[MAX_NUMA_NODES / (8 * sizeof(unsigned long))] = {};
+    mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+    // maxnode counts one more than the bits the kernel reads.
+    if (syscall(SYS_mbind, addr, size, MPOL_BIND, mask, MAX_NUMA_NODES + 1, 0) == 0) {
+        return true;
+    }
+    // A kernel without NUMA support has exactly one node.
+    return errno == ENOSYS && node == 0;
+}
+
+// hugetlbfs file standing in for shm `name`: "/aether_x" → "/dev/hugepages/aether_x".
+static bool hugetlbfs_path(const char* name, char (&path)[PATH_MAX]) {
+    const int written = snprintf(path, sizeof(path), "%s%s", HUGETLBFS_PATH, name);
+    return written > 0 && written < static_cast<int>(sizeof(path));
+}
+
+// Huge page size of the filesystem mounted at HUGETLBFS_PATH, or 0 if that
+// is not a hugetlbfs mount.
+static uint32_t hugetlbfs_page_size() {
+    struct statfs fs{};
+    if (statfs(HUGETLBFS_PATH, &fs) != 0 || fs.f_type != HUGETLBFS_MAGIC) {
+        return 0;
+    }
+    return static_cast<uint32_t>(fs.f_bsize);
+}
+
+// Create `name` as a hugetlbfs file and map it. Returns nullptr with errno
+// set when there is no mount, the name already exists (EEXIST), or the pool
+// cannot supply the pages (ENOMEM). hugetlbfs reserves a shared mapping's
+// pages at mmap time, so an exhausted pool fails here rather than with a
+// SIGBUS on first touch.
+static void* create_huge(const char* name, std::size_t size, int32_t numa_node,
+                         uint32_t& page_size) {
+    const uint32_t huge = hugetlbfs_page_size();
+    char path[PATH_MAX];
+    if (huge == 0 || !hugetlbfs_path(name, path)) {
+        errno = ENOENT;
+        return nullptr;
+    }
+
+    // Keep O_EXCL meaning "no segment by this name" across both places
+    // shm_attach() looks.
+    if (const int existing = shm_open(name, O_RDONLY, 0); existing != -1) {
+        close(existing);
+        errno = EEXIST;
+        return nullptr;
+    }
+
+    int fd = open(path, O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    // hugetlbfs only accepts whole huge pages.
+    const std::size_t mapped = segment_mapped_size(size, huge);
+    if (ftruncate(fd, static_cast<off_t>(mapped)) == -1) {
+        const int err = errno;
+        close(fd);
+        unlink(path);
+        errno = err;
+        return nullptr;
+    }
+
+    void* ptr = map_and_close(fd, mapped);
+    if (ptr == nullptr) {
+        const int err = errno;
+        unlink(path);
+        errno = err;
+        return nullptr;
+    }
+    if (!bind_to_node(ptr, mapped, numa_node)) {
+        const int err = errno;
+        munmap(ptr, mapped);
+        unlink(path);
+        errno = err;
+        return nullptr;
+    }
+
+    page_size = huge;
+    return ptr;
+}
+
+// Create a new zero-filled segment of `size` bytes, map it, bind it to
+// options.numa_node, and report the page size backing it. Used by both layouts.
+static void* create_segment(const char* name, std::size_t size, const SegmentOptions& options,
+                            uint32_t& page_size) {
+    if (options.huge_pages) {
+        void* ptr = create_huge(name, size, options.numa_node, page_size);
+        if (ptr != nullptr || errno == EEXIST) {
+            return ptr;
+        }
+        // No hugetlbfs mount, or the pool is exhausted: use ordinary pages.
+    }
 
     // O_EXCL: fail if the segment already exists.
     // This detects leftover segments from a previous crash — the daemon must
@@ -52,8 +165,6 @@ RingHeader* shm_create(const char* name, uint32_t capacity) {
         return nullptr; // errno set by shm_open (e.g. EEXIST if already exists)
     }
 
-    const std::size_t size = shm_segment_size(capacity);
-
     // Set the size of the segment. A newly created shm object has size 0;
     // without this call, any access to the mapped memory would segfault.
     if (ftruncate(fd, static_cast<off_t>(size)) == -1) {
@@ -62,11 +173,72 @@ RingHeader* shm_create(const char* name, uint32_t capacity) {
         return nullptr;
     }
 
-    RingHeader* hdr = map_and_close(fd, size);
-    if (hdr == nullptr) {
+    void* ptr = map_and_close(fd, size);
+    if (ptr == nullptr) {
         shm_unlink(name);
         return nullptr;
     }
+    if (!bind_to_node(ptr, size, options.numa_node)) {
+        const int err = errno;
+        munmap(ptr, size);
+        shm_unlink(name);
+        errno = err;
+        return nullptr;
+    }
+
+    // Best effort: with shmem THP set to "advise", the kernel may still
+    // back the fallback with transparent huge pages.
+    if (options.huge_pages) {
+        madvise(ptr, size, MADV_HUGEPAGE);
+    }
+
+    page_size = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+    return ptr;
+}
+
+// Open an existing segment read+write: POSIX shm first, then hugetlbfs.
+// Returns the fd, or -1 with errno set (ENOENT if neither has it).
+static int open_segment(const char* name) {
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd != -1 || errno != ENOENT) {
+        return fd;
+    }
+
+    char path[PATH_MAX];
+    if (!hugetlbfs_path(name, path)) {
+        return -1;
+    }
+    return open(path, O_RDWR);
+}
+
+// ---------------------------------------------------------------------------
+// shm_create
+// ---------------------------------------------------------------------------
+
+// Power-of-two capacity lets every publish and consume find a slot with
+// `seq & index_mask` instead of a 64-bit division.
+static bool valid_ring(uint32_t capacity, const SegmentOptions& options) {
+    return capacity != 0 && (capacity & (capacity - 1)) == 0 &&
+           options.slot_size != 0 && options.slot_size <= MAX_SLOT_DATA_SIZE &&
+           options.message_headers <= MessageHeaders::Tsc;
+}
+
+// valid_ring() for a header found in an existing segment, plus the fields
+// init_ring() derives: a geometry shm_create() could have written.
+static bool valid_geometry(const RingHeader* hdr) {
+    SegmentOptions options;
+    options.slot_size       = hdr->slot_size;
+    options.message_headers = hdr->message_headers;
+    return valid_ring(hdr->capacity, options) && hdr->index_mask == hdr->capacity - 1 &&
+           hdr->slot_layout <= SlotLayout::Split &&
+           hdr->page_size != 0 && (hdr->page_size & (hdr->page_size - 1)) == 0;
+}
+
+// Initialise a ring in zero-filled memory at `mem`. shm_create() and
+// arena_create_ring() differ only in where that memory comes from.
+static RingHeader* init_ring(void* mem, uint32_t capacity, OverflowPolicy policy,
+                             const SegmentOptions& options, uint32_t page_size) {
+    auto* hdr = static_cast<RingHeader*>(mem);
 
     // Construct the RingHeader in place using placement new.
     // The memory already exists (mmap'd) — we just need to initialise it.
@@ -81,18 +253,56 @@ RingHeader* shm_create(const char* name, uint32_t capacity) {
         .version  = RING_VERSION,
         .capacity = capacity,
         .write_seq = 1,         // first published message will have sequence 1
+        .exclusive_pid = 0,     // shared until someone calls acquire_exclusive()
+        .policy    = policy,
+        .page_size = page_size,
+        .residency = options.residency(),
+        .numa_node = options.numa_node,
+        .slot_layout = options.slot_layout,
+        .publish_limit = 0,     // no cursors yet — the first publish computes it
+        .wakeup    = {},        // nobody parked
+        .index_mask = capacity - 1,
+        .slot_size  = options.slot_size,
+        .message_headers = options.message_headers,  // the header array is zero-filled
+        .packed_records = 1,    // first packed record is number 1; readers start at 0
+        .successor_seq = 0,     // current — shm_supersede() links a successor
+        .epoch     = 0,         // a topic's first ring; shm_supersede() numbers successors
+        .reserved  = 0,
+        .successor_offset = 0,
+        .successor_name = {},
+        .cursors   = {},        // all free (pid 0)
     };
 
-    // All slot sequences initialised to 0 = "never written".
+    // The slots are left alone. `mem` is always fresh memory — a segment just
+    // created with O_EXCL, or arena space never handed out before — and the
+    // kernel zero-fills it, so every descriptor already reads sequence 0 =
+    // "never written" (the lock-free atomic is plain bytes, see ring.h).
     // Consumers start their read_seq at 1 (= initial write_seq), so they
-    // always see 0 < read_seq for unwritten slots → Empty.
-    Slot* slots = reinterpret_cast<Slot*>(hdr + 1);
-    for (uint32_t i = 0; i < capacity; ++i) {
-        new (&slots[i]) Slot{};
-        slots[i].sequence.store(0, std::memory_order_relaxed);
+    // always see 0 < read_seq for unwritten slots → Empty. Storing the zeros
+    // ourselves would fault in every page of the ring here, under the
+    // daemon's registry lock, instead of when the slot is first published.
+    return hdr;
+}
+
+RingHeader* shm_create(const char* name, uint32_t capacity, OverflowPolicy policy,
+                       const SegmentOptions& options) {
+    assert(name != nullptr);
+
+    if (!valid_ring(capacity, options)) {
+        errno = EINVAL;
+        return nullptr;
     }
 
-    return hdr;
+    uint32_t page_size = 0;
+    void* mem = create_segment(
+        name, shm_segment_size(capacity, options.slot_size, options.slot_layout,
+                               options.message_headers),
+        options, page_size);
+    if (mem == nullptr) {
+        return nullptr;
+    }
+
+    return init_ring(mem, capacity, policy, options, page_size);
 }
 
 // ---------------------------------------------------------------------------
@@ -103,7 +313,7 @@ RingHeader* shm_attach(const char* name) {
     assert(name != nullptr);
 
     // Open existing segment — no O_CREAT, no O_EXCL.
-    int fd = shm_open(name, O_RDWR, 0);
+    int fd = open_segment(name);
     if (fd == -1) {
         return nullptr;
     }
@@ -116,7 +326,14 @@ RingHeader* shm_attach(const char* name) {
         return nullptr;
     }
 
-    RingHeader* hdr = map_and_close(fd, static_cast<std::size_t>(st.st_size));
+    const auto size = static_cast<std::size_t>(st.st_size);
+    if (size < sizeof(RingHeader)) {  // not even a header: created and never sized
+        close(fd);
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    auto* hdr = static_cast<RingHeader*>(map_and_close(fd, size));
     if (hdr == nullptr) {
         return nullptr;
     }
@@ -124,7 +341,18 @@ RingHeader* shm_attach(const char* name) {
     // Validate before trusting any of the mapped data.
     // If magic or version doesn't match, this is a stale or incompatible segment.
     if (hdr->magic != RING_MAGIC || hdr->version != RING_VERSION) {
-        munmap(hdr, static_cast<std::size_t>(st.st_size));
+        munmap(hdr, size);
+        return nullptr;
+    }
+
+    // Slots are indexed from the header's geometry and shm_detach() unmaps
+    // the size it implies, so both must agree with the segment: a crash
+    // between ftruncate() and init_ring(), or a truncated file, leaves one
+    // that does not.
+    if (!valid_geometry(hdr) || size < shm_segment_size(hdr) ||
+        size > segment_mapped_size(shm_segment_size(hdr), hdr->page_size)) {
+        munmap(hdr, size);
+        errno = EINVAL;
         return nullptr;
     }
 
@@ -138,8 +366,9 @@ RingHeader* shm_attach(const char* name) {
 void shm_detach(RingHeader* hdr) {
     assert(hdr != nullptr);
 
-    // Reconstruct the total segment size so we can unmap the right number of bytes.
-    const std::size_t size = shm_segment_size(hdr->capacity);
+    // Reconstruct the mapped size so we can unmap the right number of bytes.
+    // A huge-page segment was mapped in whole huge pages.
+    const std::size_t size = segment_mapped_size(shm_segment_size(hdr), hdr->page_size);
     munmap(hdr, size);
 }
 
@@ -153,6 +382,375 @@ void shm_destroy(const char* name) {
     // Removes the name from /dev/shm. Processes that already have the segment
     // mapped keep their mapping — it stays alive until the last munmap().
     shm_unlink(name);
+
+    // A huge-page segment lives on hugetlbfs instead.
+    char path[PATH_MAX];
+    if (hugetlbfs_path(name, path)) {
+        unlink(path);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// shm_list
+// ---------------------------------------------------------------------------
+
+// Add "/<entry>" for each entry of `dir` starting with prefix + 1, unless
+// `names` has it already.
+static void list_dir(const char* dir, const char* prefix, std::vector<std::string>& names) {
+    DIR* d = opendir(dir);
+    if (d == nullptr) {
+        return;
+    }
+    const std::size_t prefix_len = strlen(prefix + 1);
+    while (const dirent* entry = readdir(d)) {
+        if (strncmp(entry->d_name, prefix + 1, prefix_len) != 0) {
+            continue;
+        }
+        std::string name = std::string("/") + entry->d_name;
+        if (std::find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(std::move(name));
+        }
+    }
+    closedir(d);
+}
+
+std::vector<std::string> shm_list(const char* prefix) {
+    assert(prefix != nullptr && prefix[0] == '/');
+
+    std::vector<std::string> names;
+    list_dir("/dev/shm", prefix, names);
+    list_dir(HUGETLBFS_PATH, prefix, names);
+    return names;
+}
+
+// ---------------------------------------------------------------------------
+// Residency
+// ---------------------------------------------------------------------------
+
+// Map every page of [addr, addr + size) writable in this process, so the
+// first lap of publishes and reads takes no page faults.
+static void prefault(void* addr, std::size_t size, uint32_t page_size) {
+    // Linux 5.14+: one call, and the entries come out writable.
+    if (madvise(addr, size, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+
+    // Older kernels: read one byte per page. Shared mappings get read-only
+    // entries this way, so the first write still takes a (cheap) fault.
+    const volatile uint8_t* bytes = static_cast<const volatile uint8_t*>(addr);
+    for (std::size_t off = 0; off < size; off += page_size) {
+        (void)bytes[off];
+    }
+}
+
+static uint32_t apply_residency(void* addr, std::size_t size, uint32_t page_size, uint32_t residency) {
+    uint32_t applied = 0;
+
+    if ((residency & RESIDENCY_DONTFORK) && madvise(addr, size, MADV_DONTFORK) == 0) {
+        applied |= RESIDENCY_DONTFORK;
+    }
+
+    // Before mlock: mlock faults pages in too, but read-only on a shared mapping.
+    if (residency & RESIDENCY_PREFAULT) {
+        prefault(addr, size, page_size);
+        applied |= RESIDENCY_PREFAULT;
+    }
+
+    if ((residency & RESIDENCY_LOCK) && mlock(addr, size) == 0) {
+        applied |= RESIDENCY_LOCK;
+    }
+
+    return applied;
+}
+
+uint32_t apply_residency(RingHeader* hdr) {
+    assert(hdr != nullptr);
+    const std::size_t size = segment_mapped_size(shm_segment_size(hdr), hdr->page_size);
+    return apply_residency(hdr, size, hdr->page_size, hdr->residency);
+}
+
+uint32_t apply_residency(LogHeader* hdr) {
+    assert(hdr != nullptr);
+    const std::size_t size = segment_mapped_size(log_segment_size(hdr->term_length), hdr->page_size);
+    return apply_residency(hdr, size, hdr->page_size, hdr->residency);
+}
+
+int numa_node_of(const void* addr) {
+    // Touch the page first: get_mempolicy reports where a page *is*, and an
+    // unfaulted page is nowhere yet.
+    (void)*static_cast<const volatile uint8_t*>(addr);
+
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, nullptr, 0, addr, MPOL_F_NODE | MPOL_F_ADDR) != 0) {
+        return -1;
+    }
+    return node;
+}
+
+void format_residency(uint32_t residency, char (&buf)[32]) {
+    buf[0] = '\0';
+    const struct { uint32_t bit; const char* name; } names[] = {
+        {RESIDENCY_PREFAULT, "prefault"},
+        {RESIDENCY_LOCK,     "lock"},
+        {RESIDENCY_DONTFORK, "dontfork"},
+    };
+    for (const auto& entry : names) {
+        if ((residency & entry.bit) == 0) continue;
+        if (buf[0] != '\0') strcat(buf, "+");
+        strcat(buf, entry.name);
+    }
+    if (buf[0] == '\0') strcat(buf, "none");
+}
+
+// ---------------------------------------------------------------------------
+// shm_create_log
+// ---------------------------------------------------------------------------
+
+LogHeader* shm_create_log(const char* name, uint32_t term_length, const SegmentOptions& options) {
+    assert(name != nullptr);
+
+    // Power of two, so position → (term_id, offset) is a shift and a mask.
+    if (term_length < LOG_MIN_TERM_LENGTH || term_length > LOG_MAX_TERM_LENGTH ||
+        (term_length & (term_length - 1)) != 0) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    // The new segment is zero-filled (ftruncate, or hugetlbfs' fresh pages).
+    // A zero FrameHeader tag never matches a committed frame, so the terms
+    // need no further initialisation.
+    uint32_t page_size = 0;
+    void* ptr = create_segment(name, log_segment_size(term_length), options, page_size);
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+
+    // All LOG_PARTITION_COUNT terms start out clean, so publishers may write
+    // up to the end of the third term before anyone has to clean anything.
+    return new (ptr) LogHeader{
+        .magic          = LOG_MAGIC,
+        .version        = LOG_VERSION,
+        .term_length    = term_length,
+        .term_shift     = static_cast<uint32_t>(__builtin_ctz(term_length)),
+        .page_size      = page_size,
+        .residency      = options.residency(),
+        .numa_node      = options.numa_node,
+        .active_term_id = 0,
+        .clean_position = static_cast<uint64_t>(LOG_PARTITION_COUNT) * term_length,
+        .tail_position  = 0,
+        .wakeup         = {},
+    };
+}
+
+// ---------------------------------------------------------------------------
+// shm_attach_log
+// ---------------------------------------------------------------------------
+
+LogHeader* shm_attach_log(const char* name) {
+    assert(name != nullptr);
+
+    int fd = open_segment(name);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        return nullptr;
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    auto* hdr = static_cast<LogHeader*>(ptr);
+    if (size < sizeof(LogHeader) || hdr->magic != LOG_MAGIC || hdr->version != LOG_VERSION) {
+        munmap(ptr, size);
+        return nullptr;
+    }
+
+    return hdr;
+}
+
+// ---------------------------------------------------------------------------
+// shm_detach (term log)
+// ---------------------------------------------------------------------------
+
+void shm_detach(LogHeader* hdr) {
+    assert(hdr != nullptr);
+    munmap(hdr, segment_mapped_size(log_segment_size(hdr->term_length), hdr->page_size));
+}
+
+// ---------------------------------------------------------------------------
+// Arena segments
+// ---------------------------------------------------------------------------
+
+ArenaHeader* shm_create_arena(const char* name, std::size_t size, const SegmentOptions& options) {
+    assert(name != nullptr);
+
+    // Sized before the page size is known: a huge-page arena is rounded up
+    // by create_segment(), and its header takes the first huge page.
+    const uint32_t small_page = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+    if (size < segment_mapped_size(sizeof(ArenaHeader), small_page) + small_page) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    uint32_t page_size = 0;
+    void* ptr = create_segment(name, segment_mapped_size(size, small_page), options, page_size);
+    if (ptr == nullptr) {
+        return nullptr;
+    }
+
+    // The directory is zero-filled already; only the header fields are set.
+    auto* arena = static_cast<ArenaHeader*>(ptr);
+    arena->magic     = ARENA_MAGIC;
+    arena->version   = ARENA_VERSION;
+    arena->size      = segment_mapped_size(size, page_size);
+    arena->page_size = page_size;
+    arena->numa_node = options.numa_node;
+    arena->used      = segment_mapped_size(sizeof(ArenaHeader), page_size);
+    arena->ring_count.store(0, std::memory_order_relaxed);
+    return arena;
+}
+
+ArenaHeader* shm_attach_arena(const char* name) {
+    assert(name != nullptr);
+
+    int fd = open_segment(name);
+    if (fd == -1) {
+        return nullptr;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) == -1) {
+        close(fd);
+        return nullptr;
+    }
+
+    const auto size = static_cast<std::size_t>(st.st_size);
+    auto* arena = static_cast<ArenaHeader*>(map_and_close(fd, size));
+    if (arena == nullptr) {
+        return nullptr;
+    }
+
+    if (size < sizeof(ArenaHeader) || arena->magic != ARENA_MAGIC || arena->version != ARENA_VERSION ||
+        arena->size > size) {
+        munmap(arena, size);
+        return nullptr;
+    }
+
+    return arena;
+}
+
+void shm_detach(ArenaHeader* arena) {
+    assert(arena != nullptr);
+    munmap(arena, arena->size);
+}
+
+RingHeader* arena_create_ring(ArenaHeader* arena, const char* name, uint32_t name_len,
+                              uint32_t capacity, OverflowPolicy policy, const SegmentOptions& options) {
+    assert(arena != nullptr);
+    assert(name != nullptr);
+
+    if (!valid_ring(capacity, options) || name_len == 0 || name_len > ARENA_MAX_NAME_LEN) {
+        errno = EINVAL;
+        return nullptr;
+    }
+    if (arena_find_ring(arena, name, name_len) != nullptr) {
+        errno = EEXIST;
+        return nullptr;
+    }
+
+    const uint32_t count = arena->ring_count.load(std::memory_order_relaxed);
+    const std::size_t size = arena_ring_size(capacity, options.slot_size, options.slot_layout,
+                                             options.message_headers, arena->page_size);
+    if (count == ARENA_MAX_RINGS || size > arena->size - arena->used) {
+        errno = ENOSPC;
+        return nullptr;
+    }
+
+    // Fresh arena space is still zero-filled, as a new segment would be.
+    SegmentOptions ring_options = options;
+    ring_options.numa_node = arena->numa_node;
+    RingHeader* hdr = init_ring(reinterpret_cast<uint8_t*>(arena) + arena->used, capacity, policy,
+                                ring_options, arena->page_size);
+
+    ArenaEntry& entry = arena->directory[count];
+    entry.offset   = arena->used;
+    entry.size     = size;
+    entry.name_len = name_len;
+    memcpy(entry.name, name, name_len);
+    arena->used += size;
+
+    // Publish the entry, and the initialised ring behind it, to readers.
+    arena->ring_count.store(count + 1, std::memory_order_release);
+    return hdr;
+}
+
+// ---------------------------------------------------------------------------
+// Ring migration
+// ---------------------------------------------------------------------------
+
+bool shm_supersede(RingHeader* old, RingHeader* successor, const char* successor_name,
+                   uint64_t successor_offset) {
+    assert(old != nullptr);
+    assert(successor != nullptr);
+    assert(successor_name != nullptr);
+
+    const std::size_t name_len = strlen(successor_name);
+    if (name_len >= RING_MAX_SUCCESSOR_NAME_LEN) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    if (ring_sealed(old) || successor->capacity < old->capacity ||
+        successor->slot_size != old->slot_size ||
+        successor->write_seq.load(std::memory_order_relaxed) != 1) {
+        errno = EINVAL;
+        return false;
+    }
+
+    // An ExclusivePublication writes write_seq with plain stores that would
+    // clear the seal, so a ring that carries its bit is not sealed. Both
+    // bits live in write_seq: an acquire_exclusive() racing us sees the seal
+    // in its fetch_or and backs out.
+    uint64_t end = old->write_seq.load(std::memory_order_relaxed);
+    do {
+        if (end & RING_CLAIM_FLAGS) {
+            errno = (end & RING_SEALED) ? EINVAL : EBUSY;
+            return false;
+        }
+    } while (!old->write_seq.compare_exchange_weak(end, end | RING_SEALED, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed));
+
+    // The successor is private until the forwarding pointer is published.
+    // Its sequences continue the old ring's, so read_seq carries over. A
+    // cursor copied here is at most the old ring's end: it can only hold
+    // publishers back more than needed until its subscriber migrates.
+    successor->epoch = old->epoch + 1;
+    successor->write_seq.store(end, std::memory_order_relaxed);
+    successor->packed_records.store(old->packed_records.load(std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+    for (uint32_t i = 0; i < RING_MAX_CURSORS; ++i) {
+        const uint32_t pid = old->cursors[i].pid.load(std::memory_order_acquire);
+        if (pid == 0) continue;
+        successor->cursors[i].read_seq.store(old->cursors[i].read_seq.load(std::memory_order_acquire),
+                                             std::memory_order_relaxed);
+        successor->cursors[i].pid.store(pid, std::memory_order_relaxed);
+    }
+    successor->publish_limit.store(0, std::memory_order_relaxed);  // recompute from the copies
+
+    memcpy(old->successor_name, successor_name, name_len + 1);
+    old->successor_offset = successor_offset;
+    old->successor_seq.store(end, std::memory_order_release);
+
+    // Parked subscribers wake up to find the end of the ring.
+    wake_subscribers(old->wakeup);
+    return true;
 }
 
 } // namespace aether
@@ -1,20 +1,40 @@
 #include "aether/subscribe.h"
 #include "aether/shm.h"
 #include "aether/control.h"
+#include "aether/consume.h"        // move_cursor
+#include "aether/slot_protocol.h"  // ring_sealed, wait_for_writer
 
 #include <sys/mman.h>    // munmap
 #include <sys/socket.h>  // socket, connect, send, recv, close
 #include <sys/un.h>      // sockaddr_un
 #include <unistd.h>      // close
 #include <cassert>
+#include <chrono>
 #include <cstring>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 namespace aether {
 
-Subscription subscribe(const char* topic, uint32_t topic_len) {
-    assert(topic != nullptr);
-    assert(topic_len > 0 && topic_len <= MAX_TOPIC_LEN);
+// Segments mapped once per process and shared by several subscriptions, by
+// shm name: the daemon's arena, and channels carrying multiplexed topics.
+struct SharedMapping {
+    void*    base;
+    size_t   map_size;
+    bool     arena;  // an ArenaHeader, not a RingHeader
+    uint32_t refs;
+};
+
+// How long migrate() waits for a sealed ring's forwarding pointer — the
+// default IdleStrategy::park() timeout.
+constexpr auto SUCCESSOR_WAIT = std::chrono::milliseconds(100);
+
+static std::mutex                                     g_shared_mutex;
+static std::unordered_map<std::string, SharedMapping> g_shared_mappings;
 
+// Send `req` to the daemon and return its answer.
+static SubscribeResponse send_request(const SubscribeRequest& req) {
     // --- 1. Connect to the daemon ---
     int sock = socket(AF_UNIX, SOCK_STREAM, 0);
     assert(sock != -1);
@@ -26,11 +46,7 @@ Subscription subscribe(const char* topic, uint32_t topic_len) {
     int rc = connect(sock, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
     assert(rc == 0);
 
-    // --- 2. Send SubscribeRequest ---
-    SubscribeRequest req{};
-    req.topic_len = topic_len;
-    std::memcpy(req.topic, topic, topic_len);
-
+    // --- 2. Send the request ---
     ssize_t sent = send(sock, &req, sizeof(req), 0);
     assert(sent == static_cast<ssize_t>(sizeof(req)));
 
@@ -38,26 +54,258 @@ Subscription subscribe(const char* topic, uint32_t topic_len) {
     SubscribeResponse resp{};
     ssize_t received = recv(sock, &resp, sizeof(resp), MSG_WAITALL);
     assert(received == static_cast<ssize_t>(sizeof(resp)));
-    assert(resp.status == ControlStatus::Ok);
 
     close(sock);
+    return resp;
+}
+
+// Ask the daemon for the shm segment backing `topic`, creating it with
+// `layout`, `policy` and `geometry` if it does not exist yet. Asserts the
+// daemon answered Ok.
+static SubscribeResponse request_topic(const char* topic, uint32_t topic_len, RingLayout layout,
+                                       OverflowPolicy policy, const TopicGeometry& geometry) {
+    assert(topic != nullptr);
+    assert(topic_len > 0 && topic_len <= MAX_TOPIC_LEN);
+
+    SubscribeRequest req{};
+    req.topic_len = topic_len;
+    req.layout    = layout;
+    req.policy    = policy;
+    req.capacity  = geometry.capacity;
+    req.slot_size = geometry.slot_size;
+    req.op        = ControlOp::Subscribe;
+    std::memcpy(req.topic, topic, topic_len);
+
+    const SubscribeResponse resp = send_request(req);
+    assert(resp.status == ControlStatus::Ok);
+    assert(resp.layout == layout);
+    return resp;
+}
+
+// The ring named `topic` in an arena this process has mapped already, with
+// a reference taken on the mapping, or nullptr. g_shared_mutex must be held.
+static RingHeader* find_in_mapped_arena(const char* topic, uint32_t topic_len, size_t& map_size) {
+    for (auto& [name, shared] : g_shared_mappings) {
+        if (!shared.arena) continue;
+        RingHeader* hdr = arena_find_ring(static_cast<ArenaHeader*>(shared.base), topic, topic_len);
+        if (hdr != nullptr) {
+            ++shared.refs;
+            map_size = shared.map_size;
+            return hdr;
+        }
+    }
+    return nullptr;
+}
+
+// Map the ring of segment `shm_name` — at `arena_offset` of that arena if
+// it is not 0 — for one more subscription. Arenas, and the channels of
+// multiplexed topics (`channel`), are mapped once per process and counted.
+// Returns nullptr, with nothing mapped or counted, if the segment cannot be
+// attached or holds no ring at `arena_offset`.
+static RingHeader* try_map_ring(const char* shm_name, uint64_t arena_offset, bool channel,
+                                size_t& map_size) {
+    if (arena_offset == 0 && !channel) {
+        RingHeader* hdr = shm_attach(shm_name);
+        if (hdr == nullptr) {
+            return nullptr;
+        }
 
-    // --- 4. Map the shm segment ---
-    RingHeader* hdr = shm_attach(resp.shm_name);
+        // shm_segment_size() reconstructs the total mapping size from the ring's
+        // geometry, rounded to whole pages for a huge-page segment.
+        // We store it in the handle so unsubscribe() can call munmap() correctly.
+        map_size = segment_mapped_size(shm_segment_size(hdr), hdr->page_size);
+        return hdr;
+    }
+
+    std::lock_guard<std::mutex> lock(g_shared_mutex);
+    auto it = g_shared_mappings.find(shm_name);
+    if (it == g_shared_mappings.end()) {
+        SharedMapping shared{};
+        if (arena_offset != 0) {
+            ArenaHeader* arena = shm_attach_arena(shm_name);
+            if (arena == nullptr) {
+                return nullptr;
+            }
+            shared = SharedMapping{arena, arena->size, true, 0};
+        } else {
+            RingHeader* ring = shm_attach(shm_name);
+            if (ring == nullptr) {
+                return nullptr;
+            }
+            shared = SharedMapping{ring, segment_mapped_size(shm_segment_size(ring), ring->page_size),
+                                   false, 0};
+        }
+        it = g_shared_mappings.emplace(shm_name, shared).first;
+    }
+
+    SharedMapping& shared = it->second;
+    RingHeader* hdr = shared.arena ? arena_ring(static_cast<ArenaHeader*>(shared.base), arena_offset)
+                                   : static_cast<RingHeader*>(shared.base);
+    if (hdr == nullptr) {
+        if (shared.refs == 0) {  // mapped just now, for nothing
+            munmap(shared.base, shared.map_size);
+            g_shared_mappings.erase(it);
+        }
+        return nullptr;
+    }
+    ++shared.refs;
+    map_size = shared.map_size;
+    return hdr;
+}
+
+// try_map_ring() for a segment the daemon just named: asserts it is there.
+static RingHeader* map_ring(const char* shm_name, uint64_t arena_offset, bool channel,
+                            size_t& map_size) {
+    RingHeader* hdr = try_map_ring(shm_name, arena_offset, channel, map_size);
     assert(hdr != nullptr);
+    return hdr;
+}
+
+// Undo one map_ring(): a ring inside a shared mapping releases its
+// reference on it, any other is unmapped.
+static void unmap_ring(RingHeader* hdr, size_t map_size) {
+    {
+        std::lock_guard<std::mutex> lock(g_shared_mutex);
+        const auto* at = reinterpret_cast<const uint8_t*>(hdr);
+        for (auto it = g_shared_mappings.begin(); it != g_shared_mappings.end(); ++it) {
+            const auto* base = static_cast<const uint8_t*>(it->second.base);
+            if (at < base || at >= base + it->second.map_size) continue;
+            if (--it->second.refs == 0) {
+                munmap(it->second.base, it->second.map_size);
+                g_shared_mappings.erase(it);
+            }
+            return;
+        }
+    }
+    munmap(hdr, map_size);
+}
 
-    // shm_segment_size() reconstructs the total mapping size from capacity.
-    // We store it in the handle so unsubscribe() can call munmap() correctly.
-    const size_t map_size = shm_segment_size(hdr->capacity);
+Subscription subscribe(const char* topic, uint32_t topic_len, OverflowPolicy policy,
+                       const TopicGeometry& geometry) {
+    // A topic whose ring is in an arena we have mapped is resolved in memory,
+    // without a round trip to the daemon. Multiplexed topics need their id.
+    // The name finds the topic's first ring; a resized topic is followed
+    // along its successors to the current one.
+    if (std::memchr(topic, '/', topic_len) == nullptr) {
+        Subscription sub{};
+        {
+            std::lock_guard<std::mutex> lock(g_shared_mutex);
+            sub.hdr = find_in_mapped_arena(topic, topic_len, sub.map_size);
+        }
+        if (sub.hdr != nullptr) {
+            bool moved = false;
+            while (migrate(sub)) {
+                moved = true;
+            }
+            if (!moved) {
+                sub.residency = apply_residency(sub.hdr);
+            }
+            return sub;
+        }
+    }
 
-    return Subscription{hdr, map_size};
+    const SubscribeResponse resp = request_topic(topic, topic_len, RingLayout::Slots, policy, geometry);
+
+    // --- 4. Map the segment — an arena or channel once per process ---
+    size_t map_size = 0;
+    RingHeader* hdr = map_ring(resp.shm_name, resp.arena_offset, resp.topic_id != 0, map_size);
+    return Subscription{hdr, map_size, apply_residency(hdr), resp.topic_id};
 }
 
 void unsubscribe(Subscription& sub) {
+    assert(sub.hdr != nullptr);
+    unmap_ring(sub.hdr, sub.map_size);
+    sub.hdr       = nullptr;
+    sub.map_size  = 0;
+    sub.residency = 0;
+    sub.topic_id  = 0;
+}
+
+// First half of migrate(): map the successor of `sub`'s ring, or return
+// nullptr — ring still current, forwarding pointer not published in time,
+// or successor not mappable — with nothing changed. The old ring stays
+// mapped, so whatever lives in it (a cursor) can still be read.
+static RingHeader* map_successor(const Subscription& sub, size_t& map_size) {
+    const RingHeader* old = sub.hdr;
+    if (!ring_sealed(old)) {
+        return nullptr;
+    }
+    // Sealed, so the forwarding pointer is a few stores away — unless the
+    // process sealing it died in between.
+    const auto deadline = std::chrono::steady_clock::now() + SUCCESSOR_WAIT;
+    uint32_t spins = 0;
+    while (old->successor_seq.load(std::memory_order_acquire) == 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return nullptr;
+        }
+        wait_for_writer(spins);
+    }
+    return try_map_ring(old->successor_name, old->successor_offset, sub.topic_id != 0, map_size);
+}
+
+// Second half: let go of the old ring and point `sub` at `next`.
+static void release_for_successor(Subscription& sub, RingHeader* next, size_t map_size) {
+    unmap_ring(sub.hdr, sub.map_size);
+    sub.hdr       = next;
+    sub.map_size  = map_size;
+    sub.residency = apply_residency(next);
+}
+
+bool migrate(Subscription& sub) {
+    assert(sub.hdr != nullptr);
+
+    size_t map_size = 0;
+    RingHeader* next = map_successor(sub, map_size);
+    if (next == nullptr) {
+        return false;
+    }
+    release_for_successor(sub, next, map_size);
+    return true;
+}
+
+bool migrate(Subscription& sub, SubscriberCursor*& cursor) {
+    assert(sub.hdr != nullptr);
+
+    size_t map_size = 0;
+    RingHeader* next = map_successor(sub, map_size);
+    if (next == nullptr) {
+        return false;
+    }
+    // The cursor lives in the old ring: move it before that is unmapped.
+    cursor = move_cursor(next, sub.hdr, cursor);
+    release_for_successor(sub, next, map_size);
+    return true;
+}
+
+ControlStatus resize_topic(const char* topic, uint32_t topic_len, uint32_t capacity) {
+    assert(topic != nullptr);
+    assert(topic_len > 0 && topic_len <= MAX_TOPIC_LEN);
+
+    SubscribeRequest req{};
+    req.topic_len = topic_len;
+    req.capacity  = capacity;
+    req.op        = ControlOp::Resize;
+    std::memcpy(req.topic, topic, topic_len);
+    return send_request(req).status;
+}
+
+LogSubscription subscribe_log(const char* topic, uint32_t topic_len) {
+    const SubscribeResponse resp = request_topic(topic, topic_len, RingLayout::TermLog,
+                                                 OverflowPolicy::Overwrite, TopicGeometry{});
+
+    LogHeader* hdr = shm_attach_log(resp.shm_name);
+    assert(hdr != nullptr);
+
+    return LogSubscription{hdr, segment_mapped_size(log_segment_size(hdr->term_length), hdr->page_size),
+                           apply_residency(hdr)};
+}
+
+void unsubscribe(LogSubscription& sub) {
     assert(sub.hdr != nullptr);
     munmap(sub.hdr, sub.map_size);
-    sub.hdr     = nullptr;
-    sub.map_size = 0;
+    sub.hdr       = nullptr;
+    sub.map_size  = 0;
+    sub.residency = 0;
 }
 
 } // namespace aether
@@ -27,14 +27,19 @@ static void wait_for_socket() {
 struct DaemonFixture {
     pid_t pid;
 
-    DaemonFixture() {
+    // `config_path`, if given, is passed to aetherd with -c.
+    explicit DaemonFixture(const char* config_path = nullptr) {
         unlink(aether::DAEMON_SOCKET_PATH);
         pid = fork();
         if (pid == 0) {
             int devnull = open("/dev/null", O_WRONLY);
             dup2(devnull, STDERR_FILENO);
             close(devnull);
-            execl(AETHERD_PATH, "aetherd", nullptr);
+            if (config_path != nullptr) {
+                execl(AETHERD_PATH, "aetherd", "-c", config_path, nullptr);
+            } else {
+                execl(AETHERD_PATH, "aetherd", nullptr);
+            }
             _exit(1);
         }
         if (pid < 0) { perror("fork"); std::abort(); }
@@ -24,7 +24,10 @@
 // daemon's SubscribeResponse. Bypasses aether::subscribe() entirely — no shm
 // attach, no RingHeader mapping. Use this to test the control-plane protocol
 // in isolation, independent of the client library.
-static aether::SubscribeResponse raw_subscribe(const char* topic) {
+static aether::SubscribeResponse raw_subscribe(
+        const char* topic, aether::RingLayout layout = aether::RingLayout::Slots,
+        aether::OverflowPolicy policy = aether::OverflowPolicy::Overwrite,
+        uint32_t capacity = 0, uint32_t slot_size = 0) {
     int fd = socket(AF_UNIX, SOCK_STREAM, 0);
     if (fd < 0) { perror("socket"); std::abort(); }
 
@@ -37,6 +40,35 @@ static aether::SubscribeResponse raw_subscribe(const char* topic) {
 
     aether::SubscribeRequest req{};
     req.topic_len = static_cast<uint32_t>(strlen(topic));
+    req.layout    = layout;
+    req.policy    = policy;
+    req.capacity  = capacity;
+    req.slot_size = slot_size;
+    strncpy(req.topic, topic, aether::MAX_TOPIC_LEN - 1);
+    write(fd, &req, sizeof(req));
+
+    aether::SubscribeResponse resp{};
+    read(fd, &resp, sizeof(resp));
+    close(fd);
+    return resp;
+}
+
+// A Resize request for `topic`, sent the same way.
+static aether::SubscribeResponse raw_resize(const char* topic, uint32_t capacity) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) { perror("socket"); std::abort(); }
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, aether::DAEMON_SOCKET_PATH, sizeof(addr.sun_path) - 1);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        perror("connect"); std::abort();
+    }
+
+    aether::SubscribeRequest req{};
+    req.topic_len = static_cast<uint32_t>(strlen(topic));
+    req.capacity  = capacity;
+    req.op        = aether::ControlOp::Resize;
     strncpy(req.topic, topic, aether::MAX_TOPIC_LEN - 1);
     write(fd, &req, sizeof(req));
 
@@ -54,6 +86,7 @@ TEST_CASE_FIXTURE(DaemonFixture, "subscribe returns Ok for new topic") {
     auto resp = raw_subscribe("prices");
     CHECK(resp.status == aether::ControlStatus::Ok);
     CHECK(resp.capacity == 1024);
+    CHECK(resp.slot_size == aether::SLOT_DATA_SIZE);
     CHECK(strcmp(resp.shm_name, "/aether_prices") == 0);
 }
 
@@ -82,3 +115,237 @@ TEST_CASE_FIXTURE(DaemonFixture, "shm_attach succeeds with returned shm_name") {
     CHECK(hdr->capacity == 1024);
     aether::shm_detach(hdr);
 }
+
+TEST_CASE_FIXTURE(DaemonFixture, "term-log topic reports layout and term length") {
+    auto resp = raw_subscribe("ticks", aether::RingLayout::TermLog);
+    REQUIRE(resp.status == aether::ControlStatus::Ok);
+    CHECK(resp.layout == aether::RingLayout::TermLog);
+    CHECK(resp.capacity == aether::LOG_DEFAULT_TERM_LENGTH);
+
+    aether::LogHeader* log = aether::shm_attach_log(resp.shm_name);
+    REQUIRE(log != nullptr);
+    CHECK(log->term_length == aether::LOG_DEFAULT_TERM_LENGTH);
+    aether::shm_detach(log);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "subscribing with a different layout is rejected") {
+    auto resp1 = raw_subscribe("prices", aether::RingLayout::Slots);
+    auto resp2 = raw_subscribe("prices", aether::RingLayout::TermLog);
+    CHECK(resp1.status == aether::ControlStatus::Ok);
+    CHECK(resp2.status == aether::ControlStatus::LayoutMismatch);
+    CHECK(resp2.layout == aether::RingLayout::Slots);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "back-pressure topic reports its policy") {
+    auto resp = raw_subscribe("orders", aether::RingLayout::Slots, aether::OverflowPolicy::BackPressure);
+    REQUIRE(resp.status == aether::ControlStatus::Ok);
+    CHECK(resp.policy == aether::OverflowPolicy::BackPressure);
+
+    aether::RingHeader* hdr = aether::shm_attach(resp.shm_name);
+    REQUIRE(hdr != nullptr);
+    CHECK(hdr->policy == aether::OverflowPolicy::BackPressure);
+    aether::shm_detach(hdr);
+
+    // The first subscriber decides; later ones are told what the topic uses.
+    auto resp2 = raw_subscribe("orders");
+    CHECK(resp2.status == aether::ControlStatus::Ok);
+    CHECK(resp2.policy == aether::OverflowPolicy::BackPressure);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "back-pressure is rejected for term-log topics") {
+    auto resp = raw_subscribe("ticks", aether::RingLayout::TermLog, aether::OverflowPolicy::BackPressure);
+    CHECK(resp.status == aether::ControlStatus::InternalError);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "channel/name topics share the channel's ring") {
+    auto a = raw_subscribe("md/AAPL");
+    auto b = raw_subscribe("md/MSFT");
+    auto again = raw_subscribe("md/AAPL");
+    auto channel = raw_subscribe("md");
+    REQUIRE(a.status == aether::ControlStatus::Ok);
+    REQUIRE(b.status == aether::ControlStatus::Ok);
+    CHECK(strcmp(a.shm_name, "/aether_md") == 0);
+    CHECK(strcmp(b.shm_name, a.shm_name) == 0);
+    CHECK(strcmp(channel.shm_name, a.shm_name) == 0);
+    CHECK(a.topic_id == 1);
+    CHECK(b.topic_id == 2);
+    CHECK(again.topic_id == 1);
+    CHECK(channel.topic_id == 0);
+
+    // A term log cannot be multiplexed.
+    CHECK(raw_subscribe("md/IBM", aether::RingLayout::TermLog).status ==
+          aether::ControlStatus::InternalError);
+    raw_subscribe("ticks", aether::RingLayout::TermLog);
+    CHECK(raw_subscribe("ticks/IBM").status == aether::ControlStatus::InternalError);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "topic is created with the requested geometry") {
+    auto resp = raw_subscribe("ticks", aether::RingLayout::Slots, aether::OverflowPolicy::Overwrite,
+                              65536, 16);
+    REQUIRE(resp.status == aether::ControlStatus::Ok);
+    CHECK(resp.capacity == 65536);
+    CHECK(resp.slot_size == 16);
+
+    aether::RingHeader* hdr = aether::shm_attach(resp.shm_name);
+    REQUIRE(hdr != nullptr);
+    CHECK(hdr->capacity == 65536);
+    CHECK(hdr->index_mask == 65535);
+    CHECK(hdr->slot_size == 16);
+    aether::shm_detach(hdr);
+
+    // The first subscriber decides; later ones get the topic's geometry.
+    auto resp2 = raw_subscribe("ticks", aether::RingLayout::Slots, aether::OverflowPolicy::Overwrite,
+                               128, 4096);
+    CHECK(resp2.status == aether::ControlStatus::Ok);
+    CHECK(resp2.capacity == 65536);
+    CHECK(resp2.slot_size == 16);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "invalid geometry is rejected") {
+    auto resp = raw_subscribe("ticks", aether::RingLayout::Slots, aether::OverflowPolicy::Overwrite, 1000);
+    CHECK(resp.status == aether::ControlStatus::InvalidGeometry);
+    resp = raw_subscribe("ticks", aether::RingLayout::Slots, aether::OverflowPolicy::Overwrite,
+                         0, aether::MAX_SLOT_DATA_SIZE + 1);
+    CHECK(resp.status == aether::ControlStatus::InvalidGeometry);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "resize moves a topic to a larger ring") {
+    REQUIRE(raw_subscribe("prices").status == aether::ControlStatus::Ok);
+
+    auto resp = raw_resize("prices", 4096);
+    REQUIRE(resp.status == aether::ControlStatus::Ok);
+    CHECK(resp.capacity == 4096);
+    CHECK(resp.slot_size == aether::SLOT_DATA_SIZE);
+    CHECK(strcmp(resp.shm_name, "/aether_prices@1") == 0);
+
+    // Subscribers get the successor from now on.
+    CHECK(strcmp(raw_subscribe("prices").shm_name, "/aether_prices@1") == 0);
+
+    aether::RingHeader* old = aether::shm_attach("/aether_prices");
+    REQUIRE(old != nullptr);
+    CHECK(old->successor_seq.load() == 1);
+    CHECK(strcmp(old->successor_name, "/aether_prices@1") == 0);
+    aether::shm_detach(old);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "invalid resize is rejected") {
+    CHECK(raw_resize("prices", 4096).status == aether::ControlStatus::TopicNotFound);
+    raw_subscribe("prices");
+    CHECK(raw_resize("prices", 512).status == aether::ControlStatus::InvalidGeometry);
+    CHECK(raw_resize("prices", 1024).status == aether::ControlStatus::InvalidGeometry);
+    CHECK(raw_resize("prices", 3000).status == aether::ControlStatus::InvalidGeometry);
+    raw_subscribe("ticks", aether::RingLayout::TermLog);
+    CHECK(raw_resize("ticks", 4096).status == aether::ControlStatus::LayoutMismatch);
+    // '@' is reserved for the names of successor rings.
+    CHECK(raw_subscribe("prices@1").status == aether::ControlStatus::InternalError);
+}
+
+// ---------------------------------------------------------------------------
+// Daemon config file
+// ---------------------------------------------------------------------------
+
+// Runs aetherd with `-c <file containing config_text>` and returns its exit
+// status if it exits within a second, or -1 if it is still running (started).
+static int run_daemon_with_config(const char* config_text) {
+    char path[] = "/tmp/aether-test-config-XXXXXX";
+    int fd = mkstemp(path);
+    REQUIRE(fd >= 0);
+    write(fd, config_text, strlen(config_text));
+    close(fd);
+
+    unlink(aether::DAEMON_SOCKET_PATH);
+    pid_t pid = fork();
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(devnull, STDERR_FILENO);
+        close(devnull);
+        execl(AETHERD_PATH, "aetherd", "-c", path, nullptr);
+        _exit(127);
+    }
+
+    int status = -1;
+    for (int i = 0; i < 20; ++i) {
+        if (waitpid(pid, &status, WNOHANG) == pid) break;
+        struct stat st{};
+        if (stat(aether::DAEMON_SOCKET_PATH, &st) == 0) {
+            kill(pid, SIGTERM);
+            waitpid(pid, nullptr, 0);
+            status = -1;
+            break;
+        }
+        usleep(50'000);
+    }
+    unlink(path);
+    return status == -1 ? -1 : WEXITSTATUS(status);
+}
+
+TEST_CASE("aetherd starts with a valid config") {
+    CHECK(run_daemon_with_config(
+        "# idle strategies per role\n"
+        "forwarder_idle = backoff\n"
+        "forwarder_idle_max_sleep_us = 200   # trailing comment\n"
+        "publisher_idle = park\n"
+        "publisher_idle_park_timeout_us = 1000\n") == -1);
+}
+
+TEST_CASE("aetherd starts with per-topic sections") {
+    CHECK(run_daemon_with_config(
+        "huge_pages = off\n"
+        "\n"
+        "prefault = on\n"
+        "\n"
+        "[topic prices]\n"
+        "huge_pages = on\n"
+        "slot_layout = split\n"
+        "capacity = 65536\n"
+        "slot_size = 64\n"
+        "message_headers = tsc\n"
+        "mlock = yes\n"
+        "dontfork = true\n"
+        "[ topic  orders ]\n"
+        "prefault = off\n") == -1);
+}
+
+TEST_CASE("aetherd starts with NUMA placement and CPU affinity") {
+    CHECK(run_daemon_with_config(
+        "acceptor_cpus = 0\n"
+        "tcp_server_cpus = 0\n"
+        "publisher_cpus = 0-1,3\n"
+        "numa_node = any\n"
+        "forwarder_cpus = any\n"
+        "[topic prices]\n"
+        "numa_node = 0\n"
+        "forwarder_cpus = 0\n") == -1);
+}
+
+TEST_CASE("aetherd starts with an arena") {
+    CHECK(run_daemon_with_config(
+        "arena_size_mb = 16\n"
+        "arena_huge_pages = off\n"
+        "arena_numa_node = any\n"
+        "[topic prices]\n"
+        "arena = off\n") == -1);
+}
+
+TEST_CASE("aetherd rejects an invalid config") {
+    CHECK(run_daemon_with_config("forwarder_idle = sleepy\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("no_such_key = 1\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("forwarder_idle_spins = -3\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("forwarder_idle\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("huge_pages = maybe\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("arena_size_mb = lots\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[topic prices]\nmlock = 2\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[queue prices]\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[topic prices]\n[topic prices]\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[topic prices]\nforwarder_idle = yield\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("acceptor_cpus = 3-1\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("publisher_cpus = 0,,2\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("numa_node = -2\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("slot_layout = soa\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("message_headers = rdtsc\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("capacity = 1000\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[topic prices]\nslot_size = 0\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("slot_size = 2097152\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[topic prices]\nforwarder_cpus = 99999\n") == EXIT_FAILURE);
+    CHECK(run_daemon_with_config("[topic prices]\nacceptor_cpus = 0\n") == EXIT_FAILURE);
+}
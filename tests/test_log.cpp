@@ -0,0 +1,247 @@
+#include "aether/shm.h"
+#include "aether/publish.h"
+#include "aether/consume.h"
+
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+// Simple test harness — no framework, just pass/fail counts.
+static int passed = 0;
+static int failed = 0;
+
+static void check(const char* name, bool condition) {
+    if (condition) {
+        printf("  PASS  %s\n", name);
+        ++passed;
+    } else {
+        printf("  FAIL  %s\n", name);
+        ++failed;
+    }
+}
+
+static constexpr const char* SHM_NAME = "/aether-test-log";
+
+// Smallest legal term, so a few hundred messages exercise several rotations.
+static constexpr uint32_t TERM_LENGTH = aether::LOG_MIN_TERM_LENGTH;
+
+// ---------------------------------------------------------------------------
+// Concurrent publishers + one consumer, many rotations.
+// Each payload is a repeating byte; any mixed payload means a torn read.
+// ---------------------------------------------------------------------------
+
+static constexpr int      N_PUBLISHERS   = 2;
+static constexpr uint32_t PAYLOAD_SIZE   = 200;  // not a multiple of 8 — exercises alignment
+static constexpr uint64_t PUBLISHES_EACH = 200'000;
+
+static void publisher(aether::LogHeader* hdr, std::atomic<bool>* start) {
+    uint8_t payload[PAYLOAD_SIZE];
+    while (!start->load(std::memory_order_acquire)) {}
+    for (uint64_t i = 0; i < PUBLISHES_EACH; ++i) {
+        std::memset(payload, static_cast<uint8_t>(i & 0xFF), PAYLOAD_SIZE);
+        aether::publish(hdr, payload, PAYLOAD_SIZE);
+    }
+}
+
+static void concurrent_integrity(aether::LogHeader* hdr) {
+    std::atomic<bool> start{false};
+    std::thread pubs[N_PUBLISHERS];
+    for (auto& t : pubs) t = std::thread(publisher, hdr, &start);
+
+    const uint64_t total_bytes =
+        N_PUBLISHERS * PUBLISHES_EACH * aether::align_frame(sizeof(aether::FrameHeader) + PAYLOAD_SIZE);
+
+    uint8_t buf[aether::log_max_payload(TERM_LENGTH)];
+    uint64_t position  = hdr->tail_position.load();
+    uint64_t consumed  = 0;
+    uint64_t corrupted = 0;
+    uint64_t wrong_len = 0;
+
+    start.store(true, std::memory_order_release);
+
+    // Publishers' tail stops at a known position once both are done.
+    const uint64_t start_tail = position;
+    while (true) {
+        uint32_t buf_len = sizeof(buf);
+        const auto r = aether::consume(hdr, buf, buf_len, position);
+        if (r == aether::ConsumeResult::Ok) {
+            ++consumed;
+            if (buf_len != PAYLOAD_SIZE) { ++wrong_len; continue; }
+            for (uint32_t i = 1; i < buf_len; ++i) {
+                if (buf[i] != buf[0]) { ++corrupted; break; }
+            }
+        } else if (r == aether::ConsumeResult::Empty) {
+            if (hdr->tail_position.load() - start_tail >= total_bytes && position >= hdr->tail_position.load())
+                break;
+        }
+    }
+
+    for (auto& t : pubs) t.join();
+
+    printf("  (consumed %llu of %llu, corrupted %llu)\n",
+           static_cast<unsigned long long>(consumed),
+           static_cast<unsigned long long>(N_PUBLISHERS * PUBLISHES_EACH),
+           static_cast<unsigned long long>(corrupted));
+    check("concurrent: no torn payloads", corrupted == 0);
+    check("concurrent: every frame has the published length", wrong_len == 0);
+    check("concurrent: consumer received messages", consumed > 0);
+}
+
+int main() {
+    printf("=== test_log ===\n");
+
+    shm_unlink(SHM_NAME);
+
+    // ------------------------------------------------------------------
+    // 1. Reject bad term lengths
+    // ------------------------------------------------------------------
+    errno = 0;
+    check("non-power-of-two term length rejected",
+          aether::shm_create_log(SHM_NAME, TERM_LENGTH + 8) == nullptr && errno == EINVAL);
+    check("too-small term length rejected",
+          aether::shm_create_log(SHM_NAME, aether::LOG_MIN_TERM_LENGTH / 2) == nullptr);
+
+    // ------------------------------------------------------------------
+    // 2. Create the log
+    // ------------------------------------------------------------------
+    aether::LogHeader* hdr = aether::shm_create_log(SHM_NAME, TERM_LENGTH);
+    check("shm_create_log returns non-null", hdr != nullptr);
+    if (hdr == nullptr) {
+        printf("Cannot continue — shm_create_log failed.\n");
+        return 1;
+    }
+
+    check("magic is set correctly",     hdr->magic       == aether::LOG_MAGIC);
+    check("version is set correctly",   hdr->version     == aether::LOG_VERSION);
+    check("term_length is set",         hdr->term_length == TERM_LENGTH);
+    check("term_shift matches length",  (1u << hdr->term_shift) == TERM_LENGTH);
+    check("tail starts at 0",           hdr->tail_position.load() == 0);
+    check("page_size is the system's",  hdr->page_size == static_cast<uint32_t>(sysconf(_SC_PAGESIZE)));
+
+    aether::LogHeader* attached = aether::shm_attach_log(SHM_NAME);
+    check("shm_attach_log validates and maps", attached != nullptr);
+    check("slot-ring attach rejects a term log", aether::shm_attach(SHM_NAME) == nullptr);
+    if (attached) aether::shm_detach(attached);
+
+    // ------------------------------------------------------------------
+    // 3. Publish / consume one small message
+    // ------------------------------------------------------------------
+    const uint64_t small = 0x1122334455667788ULL;
+    check("publish returns Ok", aether::publish(hdr, &small, sizeof(small)) == aether::PublishResult::Ok);
+    check("8-byte message takes 16 bytes of log", hdr->tail_position.load() == 16);
+
+    uint8_t buf[aether::log_max_payload(TERM_LENGTH)];
+    uint64_t position = 0;
+    uint32_t buf_len = sizeof(small) - 1;
+    aether::ConsumeResult result = aether::consume(hdr, buf, buf_len, position);
+    check("consume into a short buffer is TooLarge",
+          result == aether::ConsumeResult::TooLarge && buf_len == sizeof(small) && position == 0);
+
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, position);
+    check("consume returns Ok",        result == aether::ConsumeResult::Ok);
+    check("buf_len matches",           buf_len == sizeof(small));
+    check("payload content matches",   memcmp(buf, &small, sizeof(small)) == 0);
+    check("position advanced by frame", position == 16);
+
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, position);
+    check("second consume returns Empty", result == aether::ConsumeResult::Empty);
+    check("position unchanged after Empty", position == 16);
+
+    // ------------------------------------------------------------------
+    // 4. Oversized payload rejected
+    // ------------------------------------------------------------------
+    const uint32_t max_payload = aether::log_max_payload(TERM_LENGTH);
+    uint8_t big[aether::log_max_payload(TERM_LENGTH) + 1];
+    memset(big, 'x', sizeof(big));
+    check("max-size payload accepted",
+          aether::publish(hdr, big, max_payload) == aether::PublishResult::Ok);
+    check("oversized payload rejected",
+          aether::publish(hdr, big, max_payload + 1) == aether::PublishResult::TooLarge);
+    buf_len = sizeof(buf);
+    aether::consume(hdr, buf, buf_len, position);
+
+    // ------------------------------------------------------------------
+    // 5. In-order delivery across several term rotations
+    // ------------------------------------------------------------------
+    // 100-byte messages don't divide the term evenly, so every rotation
+    // produces padding that consume() must skip.
+    bool in_order = true;
+    uint32_t delivered = 0;
+    for (uint32_t i = 0; i < 500; ++i) {
+        uint8_t msg[100];
+        memset(msg, 0, sizeof(msg));
+        memcpy(msg, &i, sizeof(i));
+        aether::publish(hdr, msg, sizeof(msg));
+
+        buf_len = sizeof(buf);
+        result = aether::consume(hdr, buf, buf_len, position);
+        uint32_t got = 0;
+        memcpy(&got, buf, sizeof(got));
+        if (result != aether::ConsumeResult::Ok || buf_len != sizeof(msg) || got != i) {
+            in_order = false;
+        } else {
+            ++delivered;
+        }
+    }
+    check("rotated through several terms", hdr->active_term_id.load() >= 3);
+    check("every message delivered in order across rotations", in_order && delivered == 500);
+
+    // ------------------------------------------------------------------
+    // 6. Lapped detection
+    // ------------------------------------------------------------------
+    // Write three full terms without reading: our term's partition gets cleaned.
+    const uint64_t stale_position = position;
+    for (uint32_t i = 0; i < 3 * TERM_LENGTH / 128; ++i) {
+        uint8_t msg[120] = {};
+        aether::publish(hdr, msg, sizeof(msg));
+    }
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, position);
+    check("lapped consumer gets Lapped result", result == aether::ConsumeResult::Lapped);
+    check("position moved forward past the lap", position > stale_position);
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, position);
+    check("consume after Lapped returns Ok", result == aether::ConsumeResult::Ok);
+
+    // ------------------------------------------------------------------
+    // 7. Concurrent publishers
+    // ------------------------------------------------------------------
+    concurrent_integrity(hdr);
+
+    // ------------------------------------------------------------------
+    // 8. Blocking wait
+    // ------------------------------------------------------------------
+    position = hdr->tail_position.load();
+    buf_len  = sizeof(buf);
+    check("consume_wait times out on an idle log",
+          aether::consume_wait(hdr, buf, buf_len, position, std::chrono::milliseconds(10)) ==
+              aether::ConsumeResult::Empty);
+
+    const uint64_t woken = 99;
+    std::thread waker([&] {
+        while (hdr->wakeup.waiters.load() == 0) std::this_thread::yield();  // until parked
+        aether::publish(hdr, &woken, sizeof(woken));
+    });
+    buf_len = sizeof(buf);
+    result  = aether::consume_wait(hdr, buf, buf_len, position, std::chrono::seconds(5));
+    waker.join();
+    check("consume_wait wakes on publish",
+          result == aether::ConsumeResult::Ok && buf_len == sizeof(woken) &&
+          memcmp(buf, &woken, sizeof(woken)) == 0);
+
+    // ------------------------------------------------------------------
+    // Cleanup
+    // ------------------------------------------------------------------
+    aether::shm_detach(hdr);
+    aether::shm_destroy(SHM_NAME);
+
+    printf("\n%d passed, %d failed\n", passed, failed);
+    return failed == 0 ? 0 : 1;
+}
@@ -5,16 +5,55 @@
 #include "aether/subscribe.h"
 #include "aether/publish.h"
 #include "aether/consume.h"
+#include "aether/shm.h"
 
 #include <sys/wait.h>
+#include <signal.h>
 #include <unistd.h>
 
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <optional>
+#include <string>
 
 #include "daemon_fixture.h"
 
+// aetherd creating its slot topics in an arena.
+static const char* arena_config() {
+    static constexpr const char* path = "/tmp/aether-test-arena.conf";
+    FILE* f = fopen(path, "w");
+    if (f == nullptr) { perror("fopen"); std::abort(); }
+    fputs("arena_size_mb = 64\n", f);
+    fclose(f);
+    return path;
+}
+
+struct ArenaDaemonFixture : DaemonFixture {
+    ArenaDaemonFixture() : DaemonFixture(arena_config()) {}
+};
+
+// aetherd keeping its topics across restarts, with or without an arena.
+static const char* warm_config(bool arena) {
+    static constexpr const char* path = "/tmp/aether-test-warm.conf";
+    FILE* f = fopen(path, "w");
+    if (f == nullptr) { perror("fopen"); std::abort(); }
+    fputs("warm_restart = on\n", f);
+    fputs("warm_restart_state = /tmp/aether-test-warm.topics\n", f);
+    if (arena) fputs("arena_size_mb = 64\n", f);
+    fclose(f);
+    return path;
+}
+
+// What a warm-restart daemon leaves behind, for the next test's daemon.
+static void destroy_warm_leftovers() {
+    aether::shm_destroy("/aether_prices");
+    aether::shm_destroy("/aether_prices@1");
+    aether::shm_destroy("/aether_md");
+    aether::shm_destroy(aether::DAEMON_ARENA_NAME);
+    unlink("/tmp/aether-test-warm.topics");
+}
+
 // ---------------------------------------------------------------------------
 // Tests
 // ---------------------------------------------------------------------------
@@ -24,8 +63,7 @@ TEST_CASE_FIXTURE(DaemonFixture, "end-to-end: publish and consume a message") {
     REQUIRE(sub.hdr != nullptr);
 
     const char msg[] = "hello aether";
-    bool ok = aether::publish(sub.hdr, msg, sizeof(msg));
-    REQUIRE(ok);
+    REQUIRE(aether::publish(sub.hdr, msg, sizeof(msg)) == aether::PublishResult::Ok);
 
     char buf[64]{};
     uint32_t buf_len = sizeof(buf);
@@ -143,6 +181,234 @@ TEST_CASE_FIXTURE(DaemonFixture, "subscriber on different topic does not receive
     aether::unsubscribe(sub);
 }
 
+TEST_CASE_FIXTURE(DaemonFixture, "multiplexed topics share one mapping and see only their messages") {
+    aether::Subscription aapl = aether::subscribe("md/AAPL", 7);
+    aether::Subscription msft = aether::subscribe("md/MSFT", 7);
+    REQUIRE(aapl.hdr != nullptr);
+    CHECK(msft.hdr == aapl.hdr);
+    CHECK(aapl.topic_id != msft.topic_id);
+
+    aether::MessageMeta meta{};
+    meta.topic_id = aapl.topic_id;
+    REQUIRE(aether::publish(aapl.hdr, meta, "aapl", 4) == aether::PublishResult::Ok);
+    meta.topic_id = msft.topic_id;
+    REQUIRE(aether::publish(msft.hdr, meta, "msft", 4) == aether::PublishResult::Ok);
+
+    uint64_t read_seq = 1;
+    std::string seen;
+    const aether::PollResult r = aether::poll(msft.hdr, read_seq, msft.topic_id,
+        [&](const aether::MessageView& v) { seen.assign(v.payload.begin(), v.payload.end()); }, 16);
+    CHECK(r.delivered == 1);
+    CHECK(seen == "msft");
+
+    // The mapping outlives the first unsubscribe.
+    aether::unsubscribe(aapl);
+    CHECK(msft.hdr->write_seq.load() == 3);
+    aether::unsubscribe(msft);
+}
+
+TEST_CASE_FIXTURE(ArenaDaemonFixture, "arena topics share one mapping") {
+    aether::Subscription prices = aether::subscribe("prices", 6);
+    aether::Subscription orders = aether::subscribe("orders", 6);
+    REQUIRE(prices.hdr != nullptr);
+    REQUIRE(orders.hdr != nullptr);
+    CHECK(prices.hdr != orders.hdr);
+    CHECK(prices.map_size == orders.map_size);
+    const auto distance = reinterpret_cast<uint8_t*>(orders.hdr) - reinterpret_cast<uint8_t*>(prices.hdr);
+    CHECK(static_cast<size_t>(distance < 0 ? -distance : distance) < prices.map_size);
+
+    REQUIRE(aether::publish(orders.hdr, "buy", 3) == aether::PublishResult::Ok);
+
+    // A topic already in the mapped arena resolves without the daemon: it
+    // could not answer while stopped.
+    kill(pid, SIGSTOP);
+    aether::Subscription again = aether::subscribe("orders", 6);
+    kill(pid, SIGCONT);
+    CHECK(again.hdr == orders.hdr);
+
+    char buf[16];
+    uint32_t buf_len = sizeof(buf);
+    uint64_t read_seq = 1;
+    CHECK(aether::consume(again.hdr, buf, buf_len, read_seq) == aether::ConsumeResult::Ok);
+    CHECK(buf_len == 3);
+
+    aether::unsubscribe(prices);
+    aether::unsubscribe(orders);
+    CHECK(again.hdr->write_seq.load() == 2);  // the arena is still mapped
+    aether::unsubscribe(again);
+}
+
+TEST_CASE_FIXTURE(DaemonFixture, "resized topic: publishers and subscribers migrate without loss") {
+    aether::Subscription sub = aether::subscribe("prices", 6);
+    aether::Subscription pub = aether::subscribe("prices", 6);
+    REQUIRE(sub.hdr != nullptr);
+    REQUIRE(pub.hdr != nullptr);
+
+    for (int i = 0; i < 10; ++i) {
+        REQUIRE(aether::publish(pub.hdr, &i, sizeof(i)) == aether::PublishResult::Ok);
+    }
+    REQUIRE(aether::resize_topic("prices", 6, 2048) == aether::ControlStatus::Ok);
+    CHECK(aether::resize_topic("prices", 6, 2048) == aether::ControlStatus::InvalidGeometry);
+
+    // The publisher is told, moves over and publishes again.
+    int next = 10;
+    CHECK(aether::publish(pub.hdr, &next, sizeof(next)) == aether::PublishResult::Superseded);
+    CHECK(aether::migrate(pub));
+    CHECK(pub.hdr->capacity == 2048);
+    for (int i = 10; i < 20; ++i) {
+        REQUIRE(aether::publish(pub.hdr, &i, sizeof(i)) == aether::PublishResult::Ok);
+    }
+
+    // The subscriber drains the old ring first, then follows.
+    uint64_t read_seq = 1;
+    int expected = 0;
+    int migrations = 0;
+    while (true) {
+        int val = -1;
+        uint32_t buf_len = sizeof(val);
+        const aether::ConsumeResult r = aether::consume(sub.hdr, &val, buf_len, read_seq);
+        if (r == aether::ConsumeResult::Superseded) {
+            REQUIRE(aether::migrate(sub));
+            ++migrations;
+            continue;
+        }
+        if (r != aether::ConsumeResult::Ok) break;
+        CHECK(val == expected);
+        ++expected;
+    }
+    CHECK(expected == 20);
+    CHECK(migrations == 1);
+    CHECK(sub.hdr->capacity == 2048);
+    CHECK_FALSE(aether::migrate(sub));
+
+    // New subscribers get the current ring.
+    aether::Subscription late = aether::subscribe("prices", 6);
+    CHECK(late.hdr->capacity == 2048);
+
+    aether::unsubscribe(late);
+    aether::unsubscribe(pub);
+    aether::unsubscribe(sub);
+}
+
+TEST_CASE_FIXTURE(ArenaDaemonFixture, "resized arena topic is followed from its first ring") {
+    aether::Subscription first = aether::subscribe("prices", 6);
+    REQUIRE(first.hdr != nullptr);
+    REQUIRE(aether::resize_topic("prices", 6, 2048) == aether::ControlStatus::Ok);
+    REQUIRE(aether::resize_topic("prices", 6, 4096) == aether::ControlStatus::Ok);
+
+    // Resolved in the mapped arena by name, which finds the first ring.
+    aether::Subscription again = aether::subscribe("prices", 6);
+    CHECK(again.hdr->capacity == 4096);
+    CHECK(again.hdr->epoch == 2);
+    CHECK(again.map_size == first.map_size);
+
+    aether::unsubscribe(again);
+    aether::unsubscribe(first);
+}
+
+TEST_CASE("warm restart: topics and their messages survive the daemon") {
+    destroy_warm_leftovers();
+    std::optional<DaemonFixture> daemon(std::in_place, warm_config(false));
+
+    aether::Subscription sub  = aether::subscribe("prices", 6);
+    aether::Subscription pub  = aether::subscribe("prices", 6);
+    aether::Subscription aapl = aether::subscribe("md/AAPL", 7);
+    REQUIRE(sub.hdr != nullptr);
+    for (int i = 0; i < 5; ++i) {
+        REQUIRE(aether::publish(pub.hdr, &i, sizeof(i)) == aether::PublishResult::Ok);
+    }
+    REQUIRE(aether::resize_topic("prices", 6, 2048) == aether::ControlStatus::Ok);
+    REQUIRE(aether::migrate(pub));
+
+    // Publishing goes on while no daemon runs.
+    daemon.reset();
+    for (int i = 5; i < 10; ++i) {
+        REQUIRE(aether::publish(pub.hdr, &i, sizeof(i)) == aether::PublishResult::Ok);
+    }
+
+    // A segment the new daemon cannot validate is removed.
+    aether::SegmentOptions small;
+    small.slot_size = 64;
+    aether::RingHeader* junk = aether::shm_create("/aether_junk@x", 4, aether::OverflowPolicy::Overwrite, small);
+    REQUIRE(junk != nullptr);
+    aether::shm_detach(junk);
+
+    // Neither is an id claimed twice on one channel.
+    FILE* state = fopen("/tmp/aether-test-warm.topics", "a");
+    REQUIRE(state != nullptr);
+    fprintf(state, "md/EVIL %u\n", aapl.topic_id);
+    fclose(state);
+
+    daemon.emplace(warm_config(false));
+    CHECK(aether::shm_attach("/aether_junk@x") == nullptr);
+
+    // The daemon hands out the ring it found, not a new one.
+    aether::Subscription late = aether::subscribe("prices", 6);
+    CHECK(late.hdr->epoch == 1);
+    CHECK(aether::ring_head(late.hdr) == 11);
+    aether::Subscription aapl_again = aether::subscribe("md/AAPL", 7);
+    aether::Subscription msft = aether::subscribe("md/MSFT", 7);
+    CHECK(aapl_again.topic_id == aapl.topic_id);
+    CHECK(msft.topic_id != aapl.topic_id);
+    aether::Subscription evil = aether::subscribe("md/EVIL", 7);
+    CHECK(evil.topic_id != aapl.topic_id);
+    CHECK(evil.topic_id != msft.topic_id);
+
+    // The subscriber from before the restart reads everything, in order.
+    uint64_t read_seq = 1;
+    int expected = 0;
+    while (true) {
+        int val = -1;
+        uint32_t buf_len = sizeof(val);
+        const aether::ConsumeResult r = aether::consume(sub.hdr, &val, buf_len, read_seq);
+        if (r == aether::ConsumeResult::Superseded) {
+            REQUIRE(aether::migrate(sub));
+            continue;
+        }
+        if (r != aether::ConsumeResult::Ok) break;
+        CHECK(val == expected);
+        ++expected;
+    }
+    CHECK(expected == 10);
+
+    for (aether::Subscription* s : {&sub, &pub, &aapl, &late, &aapl_again, &msft, &evil}) {
+        aether::unsubscribe(*s);
+    }
+    daemon.reset();
+    destroy_warm_leftovers();
+}
+
+TEST_CASE("warm restart: the arena and its rings are taken over") {
+    destroy_warm_leftovers();
+    std::optional<DaemonFixture> daemon(std::in_place, warm_config(true));
+
+    aether::Subscription prices = aether::subscribe("prices", 6);
+    REQUIRE(prices.hdr != nullptr);
+    REQUIRE(aether::publish(prices.hdr, "bid", 3) == aether::PublishResult::Ok);
+
+    daemon.reset();
+    daemon.emplace(warm_config(true));
+
+    // The new daemon knows the topic, and carves new rings out of the same
+    // arena rather than a fresh one.
+    CHECK(aether::resize_topic("prices", 6, 2048) == aether::ControlStatus::Ok);
+    aether::ArenaHeader* arena = aether::shm_attach_arena(aether::DAEMON_ARENA_NAME);
+    REQUIRE(arena != nullptr);
+    CHECK(aether::arena_find_ring(arena, "prices", 6) != nullptr);
+    CHECK(aether::arena_find_ring(arena, "prices@1", 8) != nullptr);
+    aether::shm_detach(arena);
+
+    char buf[16];
+    uint32_t buf_len = sizeof(buf);
+    uint64_t read_seq = 1;
+    CHECK(aether::consume(prices.hdr, buf, buf_len, read_seq) == aether::ConsumeResult::Ok);
+    CHECK(aether::consume(prices.hdr, buf, buf_len, read_seq) == aether::ConsumeResult::Superseded);
+
+    aether::unsubscribe(prices);
+    daemon.reset();
+    destroy_warm_leftovers();
+}
+
 TEST_CASE_FIXTURE(DaemonFixture, "late subscriber can read messages still in ring") {
     aether::Subscription pub = aether::subscribe("prices", 6);
 
@@ -165,3 +431,36 @@ TEST_CASE_FIXTURE(DaemonFixture, "late subscriber can read messages still in rin
     aether::unsubscribe(pub);
     aether::unsubscribe(sub);
 }
+
+TEST_CASE_FIXTURE(DaemonFixture, "term-log topic: publish and consume across processes") {
+    aether::LogSubscription sub = aether::subscribe_log("ticks", 5);
+    REQUIRE(sub.hdr != nullptr);
+
+    pid_t child = fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        aether::LogSubscription pub = aether::subscribe_log("ticks", 5);
+        for (uint64_t i = 0; i < 100; ++i) {
+            aether::publish(pub.hdr, &i, sizeof(i));
+        }
+        aether::unsubscribe(pub);
+        _exit(0);
+    }
+    waitpid(child, nullptr, 0);
+
+    uint64_t position = 0;
+    uint64_t expected = 0;
+    uint8_t buf[aether::log_max_payload(aether::LOG_DEFAULT_TERM_LENGTH)];
+    while (true) {
+        uint32_t buf_len = sizeof(buf);
+        if (aether::consume(sub.hdr, buf, buf_len, position) != aether::ConsumeResult::Ok) break;
+        uint64_t val = 0;
+        std::memcpy(&val, buf, sizeof(val));
+        CHECK(buf_len == sizeof(val));
+        CHECK(val == expected);
+        ++expected;
+    }
+    CHECK(expected == 100);
+
+    aether::unsubscribe(sub);
+}
@@ -1,10 +1,23 @@
 #include "aether/shm.h"
 #include "aether/publish.h"
 #include "aether/consume.h"
+#include "aether/idle.h"
+#include "aether/ring_view.h"
+#include "aether/hot_path.h"
+#include "aether/slot_protocol.h"
+#include "aether/subscribe.h"
 
-#include <cstring>    // memcmp, memset
+#include <chrono>     // steady_clock, milliseconds
+#include <cerrno>     // errno, EEXIST
+#include <csignal>    // SIGSEGV
+#include <cstring>    // memcmp, memset, strcmp
 #include <cstdio>     // printf
+#include <fcntl.h>    // O_RDWR
 #include <sys/mman.h> // shm_unlink (for pre-test cleanup)
+#include <sys/wait.h> // waitpid
+#include <unistd.h>   // fork, getpid
+#include <atomic>
+#include <thread>
 
 // Simple test harness — no framework, just pass/fail counts.
 static int passed = 0;
@@ -23,6 +36,23 @@ static void check(const char* name, bool condition) {
 // The shm segment name used by this test.
 // Must start with '/'. Cleaned up at the end of the test.
 static constexpr const char* SHM_NAME = "/aether-test-ring";
+static constexpr const char* BP_SHM_NAME = "/aether-test-ring-bp";
+static constexpr const char* HUGE_SHM_NAME = "/aether-test-ring-huge";
+static constexpr const char* RESIDENT_SHM_NAME = "/aether-test-ring-resident";
+static constexpr const char* NUMA_SHM_NAME = "/aether-test-ring-numa";
+static constexpr const char* SPLIT_SHM_NAME = "/aether-test-ring-split";
+static constexpr const char* GEOMETRY_SHM_NAME = "/aether-test-ring-geometry";
+static constexpr const char* FRAGMENT_SHM_NAME = "/aether-test-ring-fragment";
+static constexpr const char* HEADER_SHM_NAME = "/aether-test-ring-header";
+static constexpr const char* PACKED_SHM_NAME = "/aether-test-ring-packed";
+static constexpr const char* MULTIPLEX_SHM_NAME = "/aether-test-ring-multiplex";
+static constexpr const char* ARENA_SHM_NAME = "/aether-test-ring-arena";
+static constexpr const char* MIGRATE_SHM_NAME = "/aether-test-ring-migrate";
+static constexpr const char* SUCCESSOR_SHM_NAME = "/aether-test-ring-migrate@1";
+static constexpr const char* SMALLER_SHM_NAME = "/aether-test-ring-migrate-small";
+static constexpr const char* STRANDED_SHM_NAME = "/aether-test-ring-migrate-stranded";
+static constexpr const char* CURSOR_SHM_NAME = "/aether-test-ring-migrate-cursor";
+static constexpr const char* CURSOR_NEXT_SHM_NAME = "/aether-test-ring-migrate-cursor@1";
 
 int main() {
     printf("=== test_ring ===\n");
@@ -55,8 +85,8 @@ int main() {
     const char* msg = "hello aether";
     const uint32_t msg_len = static_cast<uint32_t>(strlen(msg));
 
-    bool pub_ok = aether::publish(hdr, msg, msg_len);
-    check("publish returns true", pub_ok);
+    const aether::PublishResult pub_result = aether::publish(hdr, msg, msg_len);
+    check("publish returns Ok", pub_result == aether::PublishResult::Ok);
     check("write_seq incremented to 2", hdr->write_seq.load() == 2);
 
     // ------------------------------------------------------------------
@@ -85,10 +115,11 @@ int main() {
     // ------------------------------------------------------------------
     // 5. Publish oversized message — should be rejected
     // ------------------------------------------------------------------
-    char big[aether::SLOT_DATA_SIZE + 1];
+    // Longer than a slot is fragmented; longer than the whole ring is refused.
+    static char big[CAPACITY * aether::SLOT_DATA_SIZE + 1];
     memset(big, 'x', sizeof(big));
-    bool big_ok = aether::publish(hdr, big, sizeof(big));
-    check("oversized publish returns false", !big_ok);
+    const aether::PublishResult big_result = aether::publish(hdr, big, sizeof(big));
+    check("oversized publish returns TooLarge", big_result == aether::PublishResult::TooLarge);
     check("write_seq not incremented after failed publish", hdr->write_seq.load() == 2);
 
     // ------------------------------------------------------------------
@@ -105,6 +136,1520 @@ int main() {
     check("lapped consumer gets Lapped result", result == aether::ConsumeResult::Lapped);
     check("read_seq advanced past old position", read_seq > 2);
 
+    // ------------------------------------------------------------------
+    // 7. Zero-copy claim / commit
+    // ------------------------------------------------------------------
+    read_seq = hdr->write_seq.load();
+
+    aether::Claim claim{};
+    check("try_claim oversized returns false",
+          aether::try_claim(hdr, aether::SLOT_DATA_SIZE + 1, claim) == aether::PublishResult::TooLarge);
+    check("try_claim returns Ok", aether::try_claim(hdr, msg_len, claim) == aether::PublishResult::Ok);
+    check("claim buffer spans the whole slot", claim.buffer.size() == aether::SLOT_DATA_SIZE);
+
+    // Nothing visible until commit.
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, read_seq);
+    check("claimed but uncommitted slot reads Empty", result == aether::ConsumeResult::Empty);
+
+    memcpy(claim.buffer.data(), msg, msg_len);
+    aether::commit(claim, msg_len);
+
+    const uint64_t short_seq = read_seq;
+    buf_len = msg_len - 1;
+    result = aether::consume(hdr, buf, buf_len, read_seq);
+    check("consume into a short buffer is TooLarge",
+          result == aether::ConsumeResult::TooLarge && buf_len == msg_len && read_seq == short_seq);
+
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, read_seq);
+    check("committed claim consumed Ok",  result  == aether::ConsumeResult::Ok);
+    check("committed payload matches",    buf_len == msg_len && memcmp(buf, msg, msg_len) == 0);
+
+    // ------------------------------------------------------------------
+    // 8. Aborted claim is skipped, not delivered
+    // ------------------------------------------------------------------
+    check("second try_claim returns Ok", aether::try_claim(hdr, 16, claim) == aether::PublishResult::Ok);
+    aether::abort(claim);
+    aether::publish(hdr, msg, msg_len);
+
+    buf_len = sizeof(buf);
+    const uint64_t before_abort = read_seq;
+    result = aether::consume(hdr, buf, buf_len, read_seq);
+    check("consume skips aborted slot to next message", result == aether::ConsumeResult::Ok);
+    check("read_seq advanced past both slots",          read_seq == before_abort + 2);
+
+    // ------------------------------------------------------------------
+    // 9. Zero-copy view consume
+    // ------------------------------------------------------------------
+    aether::publish(hdr, msg, msg_len);
+
+    bool     view_matches = false;
+    uint64_t view_seq     = 0;
+    result = aether::consume_view(hdr, read_seq, [&](const aether::MessageView& v) {
+        view_matches = v.payload.size() == msg_len &&
+                       memcmp(v.payload.data(), msg, msg_len) == 0;
+        view_seq = v.seq;
+    });
+    check("consume_view returns Ok",            result == aether::ConsumeResult::Ok);
+    check("view sees the payload in place",     view_matches);
+    check("view carries the message sequence",  view_seq == read_seq - 1);
+
+    int calls = 0;
+    result = aether::consume_view(hdr, read_seq, [&](const aether::MessageView&) { ++calls; });
+    check("consume_view on empty ring returns Empty", result == aether::ConsumeResult::Empty);
+    check("handler not called when Empty",            calls == 0);
+
+    // Torn: the handler itself laps the ring while holding the view.
+    aether::publish(hdr, msg, msg_len);
+    result = aether::consume_view(hdr, read_seq, [&](const aether::MessageView&) {
+        for (uint32_t i = 0; i < CAPACITY; ++i) aether::publish(hdr, &i, sizeof(i));
+    });
+    check("overwrite during handler reports Torn", result == aether::ConsumeResult::Torn);
+
+    // ------------------------------------------------------------------
+    // 10. Batched poll
+    // ------------------------------------------------------------------
+    read_seq = hdr->write_seq.load();
+    for (uint32_t i = 0; i < 5; ++i) aether::publish(hdr, &i, sizeof(i));
+
+    uint32_t next_expected = 0;
+    bool     poll_in_order = true;
+    auto expect_in_order = [&](const aether::MessageView& v) {
+        uint32_t val = 0;
+        memcpy(&val, v.payload.data(), sizeof(val));
+        if (val != next_expected++) poll_in_order = false;
+    };
+
+    aether::PollResult pr = aether::poll(hdr, read_seq, expect_in_order, 3);
+    check("poll stops at max_messages",       pr.delivered == 3 && pr.lapped == 0);
+    pr = aether::poll(hdr, read_seq, expect_in_order, 100);
+    check("poll drains the rest then stops",  pr.delivered == 2 && pr.lapped == 0);
+    check("poll delivers in order",           poll_in_order);
+    check("poll on empty ring delivers none", aether::poll(hdr, read_seq, expect_in_order, 100).delivered == 0);
+
+    // Lap by exactly 5 messages: poll reports the lap and the precise loss,
+    // then keeps draining what is still in the ring.
+    for (uint32_t i = 0; i < CAPACITY + 5; ++i) aether::publish(hdr, &i, sizeof(i));
+    pr = aether::poll(hdr, read_seq, [](const aether::MessageView&) {}, 2 * CAPACITY);
+    check("poll reports one lap",              pr.lapped == 1);
+    check("poll reports exact messages lost",  pr.lost == 5);
+    check("poll drains the live ring after lap", pr.delivered == CAPACITY);
+    check("poll leaves read_seq at write_seq", read_seq == hdr->write_seq.load());
+
+    // ------------------------------------------------------------------
+    // 11. Batch publish
+    // ------------------------------------------------------------------
+    read_seq = hdr->write_seq.load();
+    const char* burst[] = {"one", "two!", "three"};
+    aether::PublishVec vecs[3];
+    for (int i = 0; i < 3; ++i) {
+        vecs[i] = aether::PublishVec{burst[i], static_cast<uint32_t>(strlen(burst[i]))};
+    }
+    check("publish_batch returns Ok", aether::publish_batch(hdr, vecs) == aether::PublishResult::Ok);
+    check("publish_batch claims one sequence per message",
+          hdr->write_seq.load() == read_seq + 3);
+
+    bool burst_in_order = true;
+    for (int i = 0; i < 3; ++i) {
+        buf_len = sizeof(buf);
+        result = aether::consume(hdr, buf, buf_len, read_seq);
+        if (result != aether::ConsumeResult::Ok || buf_len != vecs[i].len ||
+            memcmp(buf, burst[i], buf_len) != 0) {
+            burst_in_order = false;
+        }
+    }
+    check("batch delivered in order with its lengths", burst_in_order);
+
+    static uint8_t too_big[aether::SLOT_DATA_SIZE + 1];
+    const aether::PublishVec bad[] = {{burst[0], 3}, {too_big, sizeof(too_big)}};
+    const uint64_t seq_before_bad = hdr->write_seq.load();
+    check("batch with an oversized message rejected",
+          aether::publish_batch(hdr, bad) == aether::PublishResult::TooLarge);
+    check("rejected batch claims nothing",            hdr->write_seq.load() == seq_before_bad);
+    check("empty batch is a no-op",
+          aether::publish_batch(hdr, {}) == aether::PublishResult::Ok &&
+          hdr->write_seq.load() == seq_before_bad);
+
+    // ------------------------------------------------------------------
+    // 12. Exclusive publication
+    // ------------------------------------------------------------------
+    const uint64_t small_msg = 42;
+    aether::ExclusivePublication excl{};
+    check("acquire_exclusive succeeds on a shared ring", aether::acquire_exclusive(hdr, excl));
+    check("owner pid recorded in header",
+          hdr->exclusive_pid.load() == static_cast<uint32_t>(getpid()));
+    check("ownership bit set in write_seq", (hdr->write_seq.load() & aether::RING_EXCLUSIVE) != 0);
+
+    aether::ExclusivePublication second{};
+    check("second acquire_exclusive rejected", !aether::acquire_exclusive(hdr, second));
+    check("shared publish refused while held",
+          aether::publish(hdr, &small_msg, sizeof(small_msg)) == aether::PublishResult::Unavailable);
+    aether::Claim refused{};
+    check("try_claim refused while held",
+          aether::try_claim(hdr, 8, refused) == aether::PublishResult::Unavailable);
+
+    read_seq = aether::ring_head(hdr);
+    bool excl_ok = true;
+    for (uint32_t i = 0; i < CAPACITY + 3; ++i) {
+        excl_ok = aether::publish(excl, &i, sizeof(i)) == aether::PublishResult::Ok && excl_ok;
+    }
+    check("exclusive publish returns Ok", excl_ok);
+    check("exclusive publish advances write_seq",
+          aether::ring_head(hdr) == read_seq + CAPACITY + 3);
+
+    // Wrapped the ring: the subscriber sees the usual lap, then the newest
+    // CAPACITY messages in order.
+    buf_len = sizeof(buf);
+    check("exclusive: wrapped ring laps the subscriber",
+          aether::consume(hdr, buf, buf_len, read_seq) == aether::ConsumeResult::Lapped);
+    buf_len = sizeof(buf);
+    result = aether::consume(hdr, buf, buf_len, read_seq);
+    uint32_t first_excl = 0;
+    memcpy(&first_excl, buf, sizeof(first_excl));
+    check("exclusive: lapped subscriber resumes at oldest", result == aether::ConsumeResult::Ok && first_excl == 3);
+
+    aether::release_exclusive(excl);
+    check("release clears the owner",
+          hdr->exclusive_pid.load() == 0 && (hdr->write_seq.load() & aether::RING_EXCLUSIVE) == 0);
+    check("shared publish works after release",
+          aether::publish(hdr, &small_msg, sizeof(small_msg)) == aether::PublishResult::Ok);
+
+    // A claim left by a dead process is taken over.
+    pid_t child = fork();
+    if (child == 0) {
+        aether::ExclusivePublication orphan{};
+        _exit(aether::acquire_exclusive(hdr, orphan) ? 0 : 1);
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    check("child acquired and died holding the ring",
+          WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+          hdr->exclusive_pid.load() == static_cast<uint32_t>(child));
+    check("stale exclusive claim is taken over", aether::acquire_exclusive(hdr, excl));
+    aether::release_exclusive(excl);
+
+    // A shared claim taken before the ring was acquired is waited out, not
+    // written over.
+    aether::Claim in_flight{};
+    check("shared claim before acquire",
+          aether::try_claim(hdr, 8, in_flight) == aether::PublishResult::Ok);
+    std::atomic<bool> acquired{false};
+    std::thread owner([&] {
+        acquired = aether::acquire_exclusive(hdr, excl);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    check("acquire_exclusive waits for an uncommitted claim", !acquired.load());
+    check("shared claims refused while acquiring",
+          aether::publish(hdr, &small_msg, sizeof(small_msg)) == aether::PublishResult::Unavailable);
+    const uint64_t in_flight_seq = in_flight.seq;
+    memcpy(in_flight.buffer.data(), &small_msg, sizeof(small_msg));
+    aether::commit(in_flight, sizeof(small_msg));
+    owner.join();
+    check("acquire_exclusive completes once it commits", acquired.load());
+    check("owner continues after the waited-out claim", excl.next_seq == in_flight_seq + 1);
+    aether::release_exclusive(excl);
+
+    // ------------------------------------------------------------------
+    // 13. Back-pressure
+    // ------------------------------------------------------------------
+    check("attach_cursor refused on an Overwrite topic",
+          aether::attach_cursor(hdr, hdr->write_seq.load()) == nullptr);
+
+    shm_unlink(BP_SHM_NAME);
+    aether::RingHeader* bp = aether::shm_create(BP_SHM_NAME, CAPACITY,
+                                                aether::OverflowPolicy::BackPressure);
+    check("shm_create with BackPressure", bp != nullptr && bp->policy == aether::OverflowPolicy::BackPressure);
+
+    // No cursor attached — nobody to wait for, so the ring wraps freely.
+    bool bp_ok = true;
+    for (uint32_t i = 0; i < 2 * CAPACITY; ++i) {
+        bp_ok = aether::publish(bp, &i, sizeof(i)) == aether::PublishResult::Ok && bp_ok;
+    }
+    check("BackPressure ring without cursors wraps", bp_ok);
+
+    uint64_t bp_seq = bp->write_seq.load();
+    aether::SubscriberCursor* cursor = aether::attach_cursor(bp, bp_seq);
+    check("attach_cursor succeeds", cursor != nullptr &&
+          cursor->pid.load() == static_cast<uint32_t>(getpid()) && cursor->read_seq.load() == bp_seq);
+
+    bp_ok = true;
+    for (uint32_t i = 0; i < CAPACITY; ++i) {
+        bp_ok = aether::publish(bp, &i, sizeof(i)) == aether::PublishResult::Ok && bp_ok;
+    }
+    check("a full ring of messages is accepted", bp_ok);
+    const uint64_t full_seq = bp->write_seq.load();
+    check("publish past the slowest cursor is back-pressured",
+          aether::publish(bp, &small_msg, sizeof(small_msg)) == aether::PublishResult::BackPressured &&
+          bp->write_seq.load() == full_seq);
+    aether::Claim bp_claim{};
+    check("try_claim is back-pressured too",
+          aether::try_claim(bp, 8, bp_claim) == aether::PublishResult::BackPressured);
+
+    // Read two messages and publish the new position: exactly two more fit.
+    for (int i = 0; i < 2; ++i) {
+        buf_len = sizeof(buf);
+        aether::consume(bp, buf, buf_len, bp_seq);
+    }
+    aether::update_cursor(cursor, bp_seq);
+
+    uint32_t batch_vals[3] = {100, 101, 102};
+    aether::PublishVec bp_vecs[3] = {
+        {&batch_vals[0], sizeof(uint32_t)},
+        {&batch_vals[1], sizeof(uint32_t)},
+        {&batch_vals[2], sizeof(uint32_t)},
+    };
+    check("batch that does not fit is refused whole",
+          aether::publish_batch(bp, bp_vecs) == aether::PublishResult::BackPressured &&
+          bp->write_seq.load() == full_seq);
+    check("batch that fits is accepted",
+          aether::publish_batch(bp, std::span(bp_vecs, 2)) == aether::PublishResult::Ok);
+    check("ring full again after the batch",
+          aether::publish(bp, &small_msg, sizeof(small_msg)) == aether::PublishResult::BackPressured);
+
+    // The subscriber was never lapped: it reads every remaining message in order.
+    uint32_t expected = 2;
+    bool in_order = true;
+    for (uint32_t i = 0; i < CAPACITY; ++i) {
+        buf_len = sizeof(buf);
+        uint32_t v = 0;
+        in_order = aether::consume(bp, buf, buf_len, bp_seq) == aether::ConsumeResult::Ok && in_order;
+        memcpy(&v, buf, sizeof(v));
+        in_order = v == (i < CAPACITY - 2 ? expected++ : batch_vals[i - (CAPACITY - 2)]) && in_order;
+    }
+    check("back-pressured subscriber loses nothing", in_order);
+
+    // Detaching frees the entry and releases the publishers.
+    aether::detach_cursor(cursor);
+    check("detach_cursor frees the entry", cursor->pid.load() == 0);
+    check("publish resumes after detach",
+          aether::publish(bp, &small_msg, sizeof(small_msg)) == aether::PublishResult::Ok);
+
+    // The cursor table is bounded.
+    aether::SubscriberCursor* cursors[aether::RING_MAX_CURSORS] = {};
+    bool all_attached = true;
+    for (auto& c : cursors) {
+        c = aether::attach_cursor(bp, bp->write_seq.load());
+        all_attached = c != nullptr && all_attached;
+    }
+    check("RING_MAX_CURSORS cursors attach", all_attached);
+    check("attach fails when the table is full",
+          aether::attach_cursor(bp, bp->write_seq.load()) == nullptr);
+    for (auto* c : cursors) aether::detach_cursor(c);
+
+    aether::shm_detach(bp);
+    aether::shm_destroy(BP_SHM_NAME);
+
+    // ------------------------------------------------------------------
+    // 14. Blocking wait
+    // ------------------------------------------------------------------
+    using std::chrono::milliseconds;
+    using std::chrono::steady_clock;
+
+    read_seq = hdr->write_seq.load();
+    auto t0 = steady_clock::now();
+    check("wait_for_message times out on an empty ring",
+          !aether::wait_for_message(hdr, read_seq, milliseconds(20)) &&
+          steady_clock::now() - t0 >= milliseconds(20));
+    buf_len = sizeof(buf);
+    check("consume_wait returns Empty on timeout",
+          aether::consume_wait(hdr, buf, buf_len, read_seq, milliseconds(5)) == aether::ConsumeResult::Empty);
+    check("no waiter left registered", hdr->wakeup.waiters.load() == 0);
+
+    // Nobody parked: publishing must not touch the futex word.
+    const uint32_t futex_before = hdr->wakeup.futex.load();
+    aether::publish(hdr, &small_msg, sizeof(small_msg));
+    check("publish without waiters skips the wake", hdr->wakeup.futex.load() == futex_before);
+    buf_len = sizeof(buf);
+    check("consume_wait returns a ready message at once",
+          aether::consume_wait(hdr, buf, buf_len, read_seq, milliseconds(0)) == aether::ConsumeResult::Ok);
+
+    // A publisher in another process wakes the parked subscriber.
+    const uint64_t wake_msg = 7;
+    pid_t waker = fork();
+    if (waker == 0) {
+        while (hdr->wakeup.waiters.load() == 0) usleep(1000);  // until the parent parks
+        aether::publish(hdr, &wake_msg, sizeof(wake_msg));
+        _exit(0);
+    }
+    t0 = steady_clock::now();
+    buf_len = sizeof(buf);
+    result = aether::consume_wait(hdr, buf, buf_len, read_seq, std::chrono::seconds(5));
+    const auto waited = steady_clock::now() - t0;
+    waitpid(waker, nullptr, 0);
+    check("consume_wait wakes on publish",
+          result == aether::ConsumeResult::Ok && memcmp(buf, &wake_msg, sizeof(wake_msg)) == 0 &&
+          waited < std::chrono::seconds(5));
+    check("publisher bumped the futex word", hdr->wakeup.futex.load() != futex_before);
+
+    // ------------------------------------------------------------------
+    // 15. Idle strategies
+    // ------------------------------------------------------------------
+    bool names_round_trip = true;
+    for (aether::IdleMode m : {aether::IdleMode::BusySpin, aether::IdleMode::Yield,
+                               aether::IdleMode::Backoff, aether::IdleMode::Park}) {
+        aether::IdleMode parsed{};
+        names_round_trip = aether::parse_idle_mode(aether::idle_mode_name(m), parsed) &&
+                           parsed == m && names_round_trip;
+    }
+    aether::IdleMode unchanged = aether::IdleMode::Yield;
+    check("idle mode names round-trip", names_round_trip);
+    check("unknown idle mode rejected",
+          !aether::parse_idle_mode("sleepy", unchanged) && unchanged == aether::IdleMode::Yield);
+
+    // Backoff walks spin → yield → sleep and stays capped at max_sleep.
+    aether::IdleStrategy backoff = aether::IdleStrategy::backoff();
+    backoff.max_sleep = std::chrono::microseconds(50);
+    read_seq = hdr->write_seq.load();
+    t0 = steady_clock::now();
+    for (uint32_t i = 0; i < backoff.max_spins + backoff.max_yields + 20; ++i) {
+        backoff.idle(0, hdr, read_seq);
+    }
+    const auto backoff_time = steady_clock::now() - t0;
+    check("backoff sleeps once spins and yields run out", backoff_time >= std::chrono::microseconds(20));
+    check("backoff sleep is capped", backoff_time < std::chrono::seconds(1));
+
+    // Park waits on the topic's futex, up to park_timeout.
+    aether::IdleStrategy park = aether::IdleStrategy::park(milliseconds(20));
+    t0 = steady_clock::now();
+    park.idle(0, hdr, read_seq);
+    check("park times out on an idle ring", steady_clock::now() - t0 >= milliseconds(20));
+
+    waker = fork();
+    if (waker == 0) {
+        while (hdr->wakeup.waiters.load() == 0) usleep(1000);
+        aether::publish(hdr, &wake_msg, sizeof(wake_msg));
+        _exit(0);
+    }
+    park.park_timeout = std::chrono::seconds(5);
+    t0 = steady_clock::now();
+    park.idle(0, hdr, read_seq);
+    waitpid(waker, nullptr, 0);
+    check("park returns when a message arrives",
+          steady_clock::now() - t0 < std::chrono::seconds(5) && hdr->write_seq.load() > read_seq);
+
+    // ------------------------------------------------------------------
+    // 16. Huge-page segments
+    // ------------------------------------------------------------------
+    // With no hugetlbfs mount or no free huge pages the segment falls back to
+    // ordinary pages. Either way it must work and be attachable by name.
+    const auto system_page = static_cast<uint32_t>(sysconf(_SC_PAGESIZE));
+    check("ordinary segment records the system page size", hdr->page_size == system_page);
+
+    aether::shm_destroy(HUGE_SHM_NAME);
+    aether::SegmentOptions huge_pages;
+    huge_pages.huge_pages = true;
+    aether::RingHeader* huge = aether::shm_create(HUGE_SHM_NAME, CAPACITY,
+                                                  aether::OverflowPolicy::Overwrite, huge_pages);
+    check("huge-page shm_create returns non-null", huge != nullptr);
+    if (huge != nullptr) {
+        printf("  (huge-page segment got %u-byte pages)\n", huge->page_size);
+        check("huge-page segment records a power-of-two page size",
+              huge->page_size >= system_page && (huge->page_size & (huge->page_size - 1)) == 0);
+
+        errno = 0;
+        check("huge-page shm_create rejects an existing name",
+              aether::shm_create(HUGE_SHM_NAME, CAPACITY, aether::OverflowPolicy::Overwrite,
+                                 huge_pages) == nullptr && errno == EEXIST);
+
+        const uint64_t huge_msg = 0x4855474550414745ULL;
+        aether::publish(huge, &huge_msg, sizeof(huge_msg));
+        aether::RingHeader* huge_attached = aether::shm_attach(HUGE_SHM_NAME);
+        check("shm_attach maps a huge-page segment", huge_attached != nullptr &&
+                                                    huge_attached->page_size == huge->page_size);
+        if (huge_attached != nullptr) {
+            uint64_t huge_seq = 1;
+            buf_len = sizeof(buf);
+            result  = aether::consume(huge_attached, buf, buf_len, huge_seq);
+            check("huge-page segment delivers through the attached mapping",
+                  result == aether::ConsumeResult::Ok && buf_len == sizeof(huge_msg) &&
+                  memcmp(buf, &huge_msg, sizeof(huge_msg)) == 0);
+            aether::shm_detach(huge_attached);
+        }
+        aether::shm_detach(huge);
+    }
+    aether::shm_destroy(HUGE_SHM_NAME);
+    check("shm_destroy removes a huge-page segment", aether::shm_attach(HUGE_SHM_NAME) == nullptr);
+
+    // ------------------------------------------------------------------
+    // 17. Residency policy
+    // ------------------------------------------------------------------
+    check("segments default to no residency policy",
+          hdr->residency == 0 && aether::apply_residency(hdr) == 0);
+
+    aether::SegmentOptions resident;
+    resident.prefault  = true;
+    resident.lock      = true;
+    resident.dont_fork = true;
+    aether::shm_destroy(RESIDENT_SHM_NAME);
+    aether::RingHeader* pinned = aether::shm_create(RESIDENT_SHM_NAME, CAPACITY,
+                                                    aether::OverflowPolicy::Overwrite, resident);
+    check("residency shm_create returns non-null", pinned != nullptr);
+    if (pinned != nullptr) {
+        check("residency policy is recorded in the header",
+              pinned->residency == (aether::RESIDENCY_PREFAULT | aether::RESIDENCY_LOCK |
+                                    aether::RESIDENCY_DONTFORK));
+
+        aether::RingHeader* pinned_attached = aether::shm_attach(RESIDENT_SHM_NAME);
+        const uint32_t applied = aether::apply_residency(pinned_attached);
+        // mlock may be refused by RLIMIT_MEMLOCK; the other two always apply.
+        check("apply_residency prefaults and marks DONTFORK",
+              (applied & (aether::RESIDENCY_PREFAULT | aether::RESIDENCY_DONTFORK)) ==
+                  (aether::RESIDENCY_PREFAULT | aether::RESIDENCY_DONTFORK));
+
+        // The child does not inherit a DONTFORK mapping: touching it faults.
+        pid_t child = fork();
+        if (child == 0) {
+            (void)*reinterpret_cast<volatile uint64_t*>(&pinned_attached->magic);
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(child, &status, 0);
+        check("a DONTFORK mapping is not inherited by fork()",
+              WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+
+        aether::shm_detach(pinned_attached);
+        aether::shm_detach(pinned);
+    }
+    aether::shm_destroy(RESIDENT_SHM_NAME);
+
+    char residency_name[32];
+    aether::format_residency(aether::RESIDENCY_PREFAULT | aether::RESIDENCY_DONTFORK, residency_name);
+    check("format_residency joins the policy names", strcmp(residency_name, "prefault+dontfork") == 0);
+    aether::format_residency(0, residency_name);
+    check("format_residency names an empty policy", strcmp(residency_name, "none") == 0);
+
+    // ------------------------------------------------------------------
+    // 18. NUMA placement
+    // ------------------------------------------------------------------
+    check("segments default to first-touch placement", hdr->numa_node == -1);
+
+    // Every machine has node 0, so binding to it always succeeds.
+    aether::SegmentOptions node0;
+    node0.numa_node = 0;
+    aether::shm_destroy(NUMA_SHM_NAME);
+    aether::RingHeader* bound = aether::shm_create(NUMA_SHM_NAME, CAPACITY,
+                                                   aether::OverflowPolicy::Overwrite, node0);
+    check("NUMA-bound shm_create returns non-null", bound != nullptr);
+    if (bound != nullptr) {
+        check("NUMA node is recorded in the header", bound->numa_node == 0);
+        aether::publish(bound, msg, msg_len);
+        const int node = aether::numa_node_of(bound + 1);
+        check("NUMA-bound slots live on the requested node", node == 0 || node == -1);
+        aether::shm_detach(bound);
+    }
+    aether::shm_destroy(NUMA_SHM_NAME);
+
+    aether::SegmentOptions missing_node;
+    missing_node.numa_node = 1023;
+    errno = 0;
+    check("binding to a missing NUMA node fails with EINVAL",
+          aether::shm_create(NUMA_SHM_NAME, CAPACITY, aether::OverflowPolicy::Overwrite,
+                             missing_node) == nullptr && errno == EINVAL);
+    check("a failed NUMA bind leaves no segment behind", aether::shm_attach(NUMA_SHM_NAME) == nullptr);
+
+    // ------------------------------------------------------------------
+    // 19. Split slot layout
+    // ------------------------------------------------------------------
+    check("segments default to interleaved slots", hdr->slot_layout == aether::SlotLayout::Interleaved);
+
+    aether::SegmentOptions split_options;
+    split_options.slot_layout = aether::SlotLayout::Split;
+    aether::shm_destroy(SPLIT_SHM_NAME);
+    aether::RingHeader* split = aether::shm_create(SPLIT_SHM_NAME, CAPACITY,
+                                                   aether::OverflowPolicy::Overwrite, split_options);
+    check("split shm_create returns non-null", split != nullptr);
+    if (split != nullptr) {
+        check("slot layout is recorded in the header", split->slot_layout == aether::SlotLayout::Split);
+
+        const aether::SlotGeometry geo = aether::slot_geometry(split);
+        check("split descriptors are packed back to back",
+              reinterpret_cast<uint8_t*>(&geo.descriptor(1)) -
+                  reinterpret_cast<uint8_t*>(&geo.descriptor(0)) == sizeof(aether::SlotDescriptor));
+        check("split payloads each start on a page",
+              (geo.payload(0) - reinterpret_cast<uint8_t*>(split)) % aether::SLOT_DATA_SIZE == 0 &&
+              geo.payload(1) - geo.payload(0) == aether::SLOT_DATA_SIZE);
+        check("split payloads sit after every descriptor",
+              geo.payload(0) >= reinterpret_cast<uint8_t*>(&geo.descriptor(CAPACITY)));
+
+        // Every publish and consume path goes through the geometry.
+        uint64_t split_seq = split->write_seq.load();
+        aether::publish(split, msg, msg_len);
+        buf_len = sizeof(buf);
+        check("split publish / consume round-trips",
+              aether::consume(split, buf, buf_len, split_seq) == aether::ConsumeResult::Ok &&
+              buf_len == msg_len && memcmp(buf, msg, msg_len) == 0);
+        check("split payload lands in the payload pool", memcmp(geo.payload(1), msg, msg_len) == 0);
+
+        aether::Claim split_claim{};
+        aether::try_claim(split, msg_len, split_claim);
+        check("split claim buffer is the slot's payload", split_claim.buffer.data() == geo.payload(2));
+        memcpy(split_claim.buffer.data(), msg, msg_len);
+        aether::commit(split_claim, msg_len);
+        check("split publish_batch returns Ok", aether::publish_batch(split, vecs) == aether::PublishResult::Ok);
+
+        uint32_t split_seen = 0;
+        aether::PollResult split_pr = aether::poll(split, split_seq, [&](const aether::MessageView& v) {
+            const char* expected = split_seen == 0 ? msg : burst[split_seen - 1];
+            if (v.payload.size() == strlen(expected) &&
+                memcmp(v.payload.data(), expected, v.payload.size()) == 0) {
+                ++split_seen;
+            }
+        }, 100);
+        check("split poll drains claim and batch in order", split_pr.delivered == 4 && split_seen == 4);
+
+        aether::ExclusivePublication split_excl{};
+        check("split acquire_exclusive succeeds", aether::acquire_exclusive(split, split_excl));
+        for (uint32_t i = 0; i <= CAPACITY; ++i) aether::publish(split_excl, &i, sizeof(i));
+        aether::release_exclusive(split_excl);
+        buf_len = sizeof(buf);
+        check("split ring reports a lap",
+              aether::consume(split, buf, buf_len, split_seq) == aether::ConsumeResult::Lapped);
+        buf_len = sizeof(buf);
+        result = aether::consume(split, buf, buf_len, split_seq);
+        uint32_t oldest = 0;
+        memcpy(&oldest, buf, sizeof(oldest));
+        check("split ring reads on from the oldest message",
+              result == aether::ConsumeResult::Ok && oldest == 1);
+
+        aether::RingHeader* split_attached = aether::shm_attach(SPLIT_SHM_NAME);
+        check("split ring attaches", split_attached != nullptr &&
+                                     split_attached->slot_layout == aether::SlotLayout::Split);
+        if (split_attached != nullptr) aether::shm_detach(split_attached);
+        aether::shm_detach(split);
+    }
+    aether::shm_destroy(SPLIT_SHM_NAME);
+    check("split segment adds only the descriptor array, page-padded",
+          aether::shm_segment_size(1024, aether::SLOT_DATA_SIZE, aether::SlotLayout::Split) ==
+              (sizeof(aether::RingHeader) + 1024 * sizeof(aether::SlotDescriptor) +
+               aether::SLOT_DATA_SIZE - 1) / aether::SLOT_DATA_SIZE * aether::SLOT_DATA_SIZE +
+              1024 * aether::SLOT_DATA_SIZE);
+
+    // ------------------------------------------------------------------
+    // 20. Per-ring geometry
+    // ------------------------------------------------------------------
+    check("default geometry is recorded in the header",
+          hdr->slot_size == aether::SLOT_DATA_SIZE && hdr->index_mask == CAPACITY - 1);
+
+    aether::shm_destroy(GEOMETRY_SHM_NAME);
+    errno = 0;
+    check("a capacity that is not a power of two is rejected with EINVAL",
+          aether::shm_create(GEOMETRY_SHM_NAME, 24) == nullptr && errno == EINVAL);
+    aether::SegmentOptions oversized;
+    oversized.slot_size = aether::MAX_SLOT_DATA_SIZE + 1;
+    errno = 0;
+    check("a slot size above MAX_SLOT_DATA_SIZE is rejected with EINVAL",
+          aether::shm_create(GEOMETRY_SHM_NAME, CAPACITY, aether::OverflowPolicy::Overwrite,
+                             oversized) == nullptr && errno == EINVAL);
+
+    for (aether::SlotLayout layout : {aether::SlotLayout::Interleaved, aether::SlotLayout::Split}) {
+        const bool split_layout = layout == aether::SlotLayout::Split;
+        aether::SegmentOptions small;
+        small.slot_size   = 24;
+        small.slot_layout = layout;
+        aether::RingHeader* tick = aether::shm_create(GEOMETRY_SHM_NAME, 4,
+                                                      aether::OverflowPolicy::Overwrite, small);
+        check(split_layout ? "small-slot split shm_create returns non-null"
+                           : "small-slot shm_create returns non-null", tick != nullptr);
+        if (tick == nullptr) continue;
+
+        check("slot size is recorded in the header", tick->slot_size == 24 && tick->index_mask == 3);
+        const aether::SlotGeometry geo = aether::slot_geometry(tick);
+        check("small slots are padded to a cache line, not a page",
+              geo.payload(1) - geo.payload(0) == static_cast<std::ptrdiff_t>(aether::SLOT_ALIGN));
+
+        uint8_t tick_msg[4 * 24 + 1] = {};
+        check("payload above the ring's capacity is TooLarge",
+              aether::publish(tick, tick_msg, sizeof(tick_msg)) == aether::PublishResult::TooLarge);
+        aether::Claim tick_claim{};
+        check("claim buffer is the ring's slot size",
+              aether::try_claim(tick, 24, tick_claim) == aether::PublishResult::Ok &&
+              tick_claim.buffer.size() == 24);
+        aether::abort(tick_claim);
+
+        // Wrap the mask twice; every slot must keep its own payload.
+        uint64_t tick_seq = tick->write_seq.load();
+        uint32_t tick_ok = 0;
+        for (uint32_t i = 0; i < 10; ++i) {
+            memset(tick_msg, static_cast<int>(i), 24);
+            aether::publish(tick, tick_msg, 24);
+            buf_len = sizeof(buf);
+            if (aether::consume(tick, buf, buf_len, tick_seq) == aether::ConsumeResult::Ok &&
+                buf_len == 24 && buf[0] == static_cast<char>(i) && buf[23] == static_cast<char>(i)) {
+                ++tick_ok;
+            }
+        }
+        check("small-slot ring wraps with the index mask", tick_ok == 10);
+
+        aether::RingHeader* tick_attached = aether::shm_attach(GEOMETRY_SHM_NAME);
+        check("small-slot ring attaches", tick_attached != nullptr && tick_attached->slot_size == 24);
+        if (tick_attached != nullptr) aether::shm_detach(tick_attached);
+        aether::shm_detach(tick);
+        aether::shm_destroy(GEOMETRY_SHM_NAME);
+    }
+
+    aether::SegmentOptions large;
+    large.slot_size = 64 * 1024;
+    aether::RingHeader* snapshot = aether::shm_create(GEOMETRY_SHM_NAME, 2,
+                                                      aether::OverflowPolicy::Overwrite, large);
+    check("large-slot shm_create returns non-null", snapshot != nullptr);
+    if (snapshot != nullptr) {
+        static uint8_t image[64 * 1024];
+        static uint8_t image_copy[64 * 1024];
+        for (size_t i = 0; i < sizeof(image); ++i) image[i] = static_cast<uint8_t>(i * 7);
+        uint64_t snapshot_seq = snapshot->write_seq.load();
+        uint32_t image_len = sizeof(image_copy);
+        check("a 64 KB payload round-trips through a large-slot ring",
+              aether::publish(snapshot, image, sizeof(image)) == aether::PublishResult::Ok &&
+              aether::consume(snapshot, image_copy, image_len, snapshot_seq) == aether::ConsumeResult::Ok &&
+              image_len == sizeof(image) && memcmp(image, image_copy, sizeof(image)) == 0);
+        aether::shm_detach(snapshot);
+
+        // A segment cut short by a crash is refused, not indexed past its end.
+        const int cut_fd = shm_open(GEOMETRY_SHM_NAME, O_RDWR, 0);
+        const bool cut = cut_fd != -1 && ftruncate(cut_fd, 64 * 1024) == 0;
+        if (cut_fd != -1) close(cut_fd);
+        errno = 0;
+        check("a truncated segment does not attach",
+              cut && aether::shm_attach(GEOMETRY_SHM_NAME) == nullptr && errno == EINVAL);
+    }
+    aether::shm_destroy(GEOMETRY_SHM_NAME);
+
+    aether::RingHeader* corrupt = aether::shm_create(GEOMETRY_SHM_NAME, 4);
+    check("corrupt-geometry shm_create returns non-null", corrupt != nullptr);
+    if (corrupt != nullptr) {
+        corrupt->capacity = 3;
+        errno = 0;
+        check("a segment whose geometry shm_create would refuse does not attach",
+              aether::shm_attach(GEOMETRY_SHM_NAME) == nullptr && errno == EINVAL);
+        corrupt->capacity = 4;  // so shm_detach() unmaps what was mapped
+        aether::shm_detach(corrupt);
+    }
+    aether::shm_destroy(GEOMETRY_SHM_NAME);
+    check("segment size follows the slot size",
+          aether::shm_segment_size(1024, 16) ==
+              sizeof(aether::RingHeader) + 1024 * aether::SLOT_ALIGN);
+
+    // ------------------------------------------------------------------
+    // 21. Compile-time ring views
+    // ------------------------------------------------------------------
+    struct Tick {
+        uint64_t price;
+        uint64_t qty;
+    };
+    using TickView  = aether::RingView<8, sizeof(Tick)>;
+    using SplitView = aether::RingView<8, sizeof(Tick), aether::SlotLayout::Split>;
+
+    TickView wrong_geometry;
+    check("attach_view rejects a ring of another geometry", !aether::attach_view(hdr, wrong_geometry) &&
+                                                            wrong_geometry.hdr == nullptr);
+
+    aether::SegmentOptions tick_options;
+    tick_options.slot_size = sizeof(Tick);
+    aether::RingHeader* ticks = aether::shm_create(GEOMETRY_SHM_NAME, 8,
+                                                   aether::OverflowPolicy::Overwrite, tick_options);
+    check("tick ring shm_create returns non-null", ticks != nullptr);
+    if (ticks != nullptr) {
+        TickView view;
+        SplitView split_view;
+        check("attach_view accepts a ring of its geometry", aether::attach_view(ticks, view));
+        check("attach_view checks the slot layout", !aether::attach_view(ticks, split_view));
+
+        const aether::SlotGeometry geo = aether::slot_geometry(ticks);
+        check("view constants match the runtime geometry",
+              &view.descriptor(3) == &geo.descriptor(3) && view.payload(5) == geo.payload(5));
+
+        // A view publisher and a generic subscriber share the ring, and
+        // the other way round.
+        uint64_t view_seq = ticks->write_seq.load();
+        const Tick t1{100, 1};
+        check("typed view publish returns Ok", aether::publish(view, t1) == aether::PublishResult::Ok);
+        Tick out{};
+        uint32_t out_len = sizeof(out);
+        check("generic consume reads a view publish",
+              aether::consume(ticks, &out, out_len, view_seq) == aether::ConsumeResult::Ok &&
+              out_len == sizeof(Tick) && out.price == 100 && out.qty == 1);
+
+        const Tick t2{200, 2};
+        aether::publish(ticks, &t2, sizeof(t2));
+        out = {};
+        check("typed view consume reads a generic publish",
+              aether::consume(view, out, view_seq) == aether::ConsumeResult::Ok &&
+              out.price == 200 && out.qty == 2);
+
+        uint8_t too_long[sizeof(Tick) + 1] = {};
+        check("view publish of more than the slot size is TooLarge",
+              aether::publish(view, too_long, sizeof(too_long)) == aether::PublishResult::TooLarge);
+
+        uint8_t partial[4] = {1, 2, 3, 4};
+        aether::publish(view, partial, sizeof(partial));
+        uint8_t partial_out[sizeof(Tick)] = {};
+        out_len = sizeof(partial) - 1;
+        check("byte view consume into a short buffer is TooLarge",
+              aether::consume(view, partial_out, out_len, view_seq) == aether::ConsumeResult::TooLarge &&
+              out_len == sizeof(partial));
+        out_len = sizeof(partial_out);
+        const uint64_t partial_seq = view_seq;
+        check("typed view consume of a message of another size is TooLarge",
+              aether::consume(view, out, view_seq) == aether::ConsumeResult::TooLarge &&
+              view_seq == partial_seq);
+        check("byte view consume returns the message length",
+              aether::consume(view, partial_out, out_len, view_seq) == aether::ConsumeResult::Ok &&
+              out_len == sizeof(partial) && memcmp(partial_out, partial, sizeof(partial)) == 0);
+
+        check("view consume on a caught-up ring is Empty",
+              aether::consume(view, out, view_seq) == aether::ConsumeResult::Empty);
+
+        for (uint64_t i = 0; i < 2 * TickView::capacity; ++i) aether::publish(view, Tick{i, i});
+        check("view consume reports a lap", aether::consume(view, out, view_seq) == aether::ConsumeResult::Lapped);
+        check("view consume reads on from the oldest message",
+              aether::consume(view, out, view_seq) == aether::ConsumeResult::Ok &&
+              out.price == TickView::capacity);
+
+        aether::ExclusivePublication view_excl{};
+        aether::acquire_exclusive(ticks, view_excl);
+        check("view publish honours an exclusive owner",
+              aether::publish(view, t1) == aether::PublishResult::Unavailable);
+        aether::release_exclusive(view_excl);
+
+        aether::shm_detach(ticks);
+    }
+    aether::shm_destroy(GEOMETRY_SHM_NAME);
+
+    // ------------------------------------------------------------------
+    // 22. Header-only hot path
+    // ------------------------------------------------------------------
+    {
+        // Inline and library calls interleave on one ring.
+        uint64_t hot_seq = hdr->write_seq.load();
+        check("hot::publish returns Ok", aether::hot::publish(hdr, msg, msg_len) == aether::PublishResult::Ok);
+        aether::publish(hdr, burst[0], static_cast<uint32_t>(strlen(burst[0])));
+        check("hot::publish_batch returns Ok", aether::hot::publish_batch(hdr, vecs) == aether::PublishResult::Ok);
+
+        buf_len = sizeof(buf);
+        check("library consume reads a hot::publish",
+              aether::consume(hdr, buf, buf_len, hot_seq) == aether::ConsumeResult::Ok &&
+              buf_len == msg_len && memcmp(buf, msg, msg_len) == 0);
+        buf_len = sizeof(buf);
+        check("hot::consume reads a library publish",
+              aether::hot::consume(hdr, buf, buf_len, hot_seq) == aether::ConsumeResult::Ok &&
+              buf_len == strlen(burst[0]) && memcmp(buf, burst[0], buf_len) == 0);
+
+        uint32_t hot_seen = 0;
+        const aether::PollResult hot_pr = aether::hot::poll(hdr, hot_seq, [&](const aether::MessageView& v) {
+            if (v.payload.size() == strlen(burst[hot_seen]) &&
+                memcmp(v.payload.data(), burst[hot_seen], v.payload.size()) == 0) {
+                ++hot_seen;
+            }
+        }, 100);
+        check("hot::poll drains the batch in order", hot_pr.delivered == 3 && hot_seen == 3);
+        check("hot::consume_view on a caught-up ring is Empty",
+              aether::hot::consume_view(hdr, hot_seq, [](const aether::MessageView&) {}) ==
+                  aether::ConsumeResult::Empty);
+
+        static uint8_t hot_too_big[CAPACITY * aether::SLOT_DATA_SIZE + 1];
+        check("hot::publish of an oversized payload is TooLarge",
+              aether::hot::publish(hdr, hot_too_big, sizeof(hot_too_big)) == aether::PublishResult::TooLarge);
+    }
+
+    // ------------------------------------------------------------------
+    // 23. Fragmentation and reassembly
+    // ------------------------------------------------------------------
+    {
+        // Three full pieces and a half one.
+        static uint8_t large[3 * aether::SLOT_DATA_SIZE + aether::SLOT_DATA_SIZE / 2];
+        static uint8_t large_out[sizeof(large)];
+        for (size_t i = 0; i < sizeof(large); ++i) large[i] = static_cast<uint8_t>(i * 7);
+
+        uint64_t frag_seq = hdr->write_seq.load();
+        check("publish of a message longer than a slot returns Ok",
+              aether::publish(hdr, large, sizeof(large)) == aether::PublishResult::Ok);
+        check("a fragmented message takes consecutive sequences", hdr->write_seq.load() == frag_seq + 4);
+
+        // Plain poll() hands out the pieces as they sit in the ring.
+        uint64_t raw_seq = frag_seq;
+        uint32_t piece_flags[4] = {};
+        uint32_t pieces = 0;
+        aether::poll(hdr, raw_seq, [&](const aether::MessageView& v) {
+            if (pieces < 4) piece_flags[pieces] = v.flags;
+            ++pieces;
+        }, 16);
+        check("poll delivers each piece with its fragment flags",
+              pieces == 4 &&
+              piece_flags[0] == (aether::SLOT_FLAG_FRAGMENT | aether::SLOT_FLAG_BEGIN) &&
+              piece_flags[1] == aether::SLOT_FLAG_FRAGMENT &&
+              piece_flags[3] == (aether::SLOT_FLAG_FRAGMENT | aether::SLOT_FLAG_END));
+
+        uint32_t large_len = aether::SLOT_DATA_SIZE;
+        uint64_t copy_seq  = frag_seq;
+        check("consume into a short buffer is TooLarge with the length needed",
+              aether::consume(hdr, large_out, large_len, copy_seq) == aether::ConsumeResult::TooLarge &&
+              large_len == sizeof(large) && copy_seq == frag_seq);
+        large_len = sizeof(large_out);
+        check("consume reassembles the message",
+              aether::consume(hdr, large_out, large_len, copy_seq) == aether::ConsumeResult::Ok &&
+              large_len == sizeof(large) && memcmp(large_out, large, sizeof(large)) == 0 &&
+              copy_seq == frag_seq + 4);
+
+        // Interleaved payloads are never back to back: the assembler copies.
+        aether::FragmentAssembler assembler;
+        uint64_t asm_seq = frag_seq;
+        bool whole  = false;
+        bool copied = false;
+        const aether::PollResult asm_pr = aether::poll(hdr, asm_seq, assembler, [&](const aether::MessageView& v) {
+            whole  = v.payload.size() == sizeof(large) && memcmp(v.payload.data(), large, sizeof(large)) == 0 &&
+                     v.seq == frag_seq && v.flags == 0;
+            copied = v.payload.data() == assembler.buffer.data();
+        }, 16);
+        check("assembler poll delivers the message whole",
+              asm_pr.delivered == 1 && whole && asm_seq == frag_seq + 4);
+        check("interleaved pieces are reassembled in the assembler's buffer", copied);
+
+        // A piece that is still being written holds the whole message back.
+        frag_seq = hdr->write_seq.load();
+        aether::publish(hdr, large, sizeof(large));
+        aether::SlotDescriptor& last = aether::slot_geometry(hdr).descriptor((frag_seq + 3) & hdr->index_mask);
+        last.sequence.store((frag_seq + 3) | aether::SLOT_WRITING);
+        copy_seq  = frag_seq;
+        asm_seq   = frag_seq;
+        large_len = sizeof(large_out);
+        check("a message with a piece still being written is Empty",
+              aether::consume(hdr, large_out, large_len, copy_seq) == aether::ConsumeResult::Empty &&
+              copy_seq == frag_seq);
+        check("assembler poll waits for the last piece",
+              aether::poll(hdr, asm_seq, assembler, [](const aether::MessageView&) {}, 16).delivered == 0 &&
+              asm_seq == frag_seq);
+        last.sequence.store(frag_seq + 3);
+        check("the message is delivered once its last piece commits",
+              aether::poll(hdr, asm_seq, assembler, [](const aether::MessageView&) {}, 16).delivered == 1 &&
+              asm_seq == frag_seq + 4);
+
+        // Lapped into the middle of a message: the orphaned pieces are skipped.
+        frag_seq = hdr->write_seq.load();
+        aether::publish(hdr, large, sizeof(large));
+        for (uint32_t i = 0; i < CAPACITY - 3; ++i) aether::publish(hdr, &i, sizeof(i));
+        copy_seq  = frag_seq;
+        large_len = sizeof(large_out);
+        check("a lapped fragmented message reports Lapped",
+              aether::consume(hdr, large_out, large_len, copy_seq) == aether::ConsumeResult::Lapped &&
+              copy_seq == frag_seq + 1);
+        uint32_t after_lap = 0;
+        large_len = sizeof(large_out);
+        check("consume skips the pieces left of the lapped message",
+              aether::consume(hdr, large_out, large_len, copy_seq) == aether::ConsumeResult::Ok &&
+              large_len == sizeof(after_lap) && memcmp(large_out, &after_lap, sizeof(after_lap)) == 0);
+
+        aether::ExclusivePublication frag_excl{};
+        aether::acquire_exclusive(hdr, frag_excl);
+        frag_seq = aether::ring_head(hdr);
+        check("exclusive publish fragments a long message",
+              aether::publish(frag_excl, large, sizeof(large)) == aether::PublishResult::Ok &&
+              aether::ring_head(hdr) == frag_seq + 4);
+        aether::release_exclusive(frag_excl);
+        copy_seq  = frag_seq;
+        large_len = sizeof(large_out);
+        check("consume reassembles an exclusive publication's message",
+              aether::consume(hdr, large_out, large_len, copy_seq) == aether::ConsumeResult::Ok &&
+              large_len == sizeof(large) && memcmp(large_out, large, sizeof(large)) == 0);
+
+        // Split layout with page-sized payloads: pieces lie back to back.
+        shm_unlink(FRAGMENT_SHM_NAME);
+        aether::SegmentOptions split;
+        split.slot_layout = aether::SlotLayout::Split;
+        aether::RingHeader* frag = aether::shm_create(FRAGMENT_SHM_NAME, 8,
+                                                      aether::OverflowPolicy::Overwrite, split);
+        check("split fragment ring shm_create returns non-null", frag != nullptr);
+        if (frag != nullptr) {
+            const aether::SlotGeometry frag_geo = aether::slot_geometry(frag);
+            uint64_t split_seq = frag->write_seq.load();
+            aether::publish(frag, large, sizeof(large));
+
+            const uint8_t* seen = nullptr;
+            whole = false;
+            aether::poll(frag, split_seq, assembler, [&](const aether::MessageView& v) {
+                seen  = v.payload.data();
+                whole = v.payload.size() == sizeof(large) && memcmp(v.payload.data(), large, sizeof(large)) == 0;
+            }, 16);
+            check("contiguous pieces are delivered in place, zero-copy",
+                  whole && seen == frag_geo.payload(1) && split_seq == 5);
+
+            // Sequences 5..8 wrap from the last slot back to the first.
+            aether::publish(frag, large, sizeof(large));
+            aether::poll(frag, split_seq, assembler, [&](const aether::MessageView& v) {
+                seen  = v.payload.data();
+                whole = v.payload.size() == sizeof(large) && memcmp(v.payload.data(), large, sizeof(large)) == 0;
+            }, 16);
+            check("a message wrapping the ring is copied",
+                  whole && seen == assembler.buffer.data() && split_seq == 9);
+
+            aether::shm_detach(frag);
+        }
+        aether::shm_destroy(FRAGMENT_SHM_NAME);
+    }
+
+    // ------------------------------------------------------------------
+    // 24. Per-message headers
+    // ------------------------------------------------------------------
+    {
+        check("segment size grows by one header per slot",
+              aether::shm_segment_size(8, aether::SLOT_DATA_SIZE, aether::SlotLayout::Interleaved,
+                                       aether::MessageHeaders::Monotonic) ==
+                  aether::shm_segment_size(8) + 8 * sizeof(aether::MessageHeader));
+
+        // A ring without headers hands out none.
+        uint64_t plain_seq = hdr->write_seq.load();
+        aether::publish(hdr, msg, msg_len);
+        aether::MessageHeader plain_header{};
+        plain_header.key = 42;
+        buf_len = sizeof(buf);
+        check("consume on a header-less ring zeroes the header",
+              aether::consume(hdr, buf, buf_len, plain_seq, plain_header) == aether::ConsumeResult::Ok &&
+              plain_header.key == 0 && plain_header.timestamp == 0);
+        check("header-less ring has no header array", aether::slot_geometry(hdr).headers == nullptr);
+
+        shm_unlink(HEADER_SHM_NAME);
+        aether::SegmentOptions bad_clock;
+        bad_clock.message_headers = static_cast<aether::MessageHeaders>(7);
+        errno = 0;
+        check("unknown header clock is rejected with EINVAL",
+              aether::shm_create(HEADER_SHM_NAME, 8, aether::OverflowPolicy::Overwrite, bad_clock) == nullptr &&
+              errno == EINVAL);
+
+        aether::SegmentOptions with_headers;
+        with_headers.message_headers = aether::MessageHeaders::Monotonic;
+        aether::RingHeader* hr = aether::shm_create(HEADER_SHM_NAME, 8, aether::OverflowPolicy::Overwrite,
+                                                    with_headers);
+        check("header ring shm_create returns non-null", hr != nullptr);
+        if (hr != nullptr) {
+            const aether::SlotGeometry hgeo = aether::slot_geometry(hr);
+            check("header array follows the slots",
+                  reinterpret_cast<uint8_t*>(hgeo.headers) ==
+                      reinterpret_cast<uint8_t*>(hr) +
+                          aether::message_header_offset(8, aether::SLOT_DATA_SIZE, aether::SlotLayout::Interleaved));
+
+            uint64_t hseq = hr->write_seq.load();
+            const uint64_t before = aether::header_timestamp(aether::MessageHeaders::Monotonic);
+            aether::publish(hr, msg, msg_len);
+            const uint64_t after = aether::header_timestamp(aether::MessageHeaders::Monotonic);
+            aether::MessageHeader got{};
+            buf_len = sizeof(buf);
+            check("plain publish stamps the time and zero metadata",
+                  aether::consume(hr, buf, buf_len, hseq, got) == aether::ConsumeResult::Ok &&
+                  got.timestamp >= before && got.timestamp <= after &&
+                  got.key == 0 && got.type_id == 0 && got.session_id == 0);
+            check("the payload is the message alone", buf_len == msg_len && memcmp(buf, msg, msg_len) == 0);
+
+            const aether::MessageMeta meta{.session_id = 7, .type_id = 3, .key = 0xABCDEF};
+            aether::publish(hr, meta, msg, msg_len);
+            buf_len = sizeof(buf);
+            check("publish with metadata fills the header",
+                  aether::consume(hr, buf, buf_len, hseq, got) == aether::ConsumeResult::Ok &&
+                  got.session_id == 7 && got.type_id == 3 && got.key == 0xABCDEF);
+
+            aether::Claim hclaim{};
+            aether::try_claim(hr, msg_len, hclaim);
+            memcpy(hclaim.buffer.data(), msg, msg_len);
+            aether::commit(hclaim, msg_len, aether::MessageMeta{.session_id = 8, .type_id = 4, .key = 5});
+            aether::ExclusivePublication hexcl{};
+            aether::acquire_exclusive(hr, hexcl);
+            aether::publish(hexcl, aether::MessageMeta{.session_id = 9, .type_id = 6, .key = 11}, msg, msg_len);
+            aether::release_exclusive(hexcl);
+
+            uint32_t sessions = 0;
+            uint64_t keys = 0;
+            const aether::PollResult hpr = aether::poll(hr, hseq, [&](const aether::MessageView& v) {
+                if (v.header != nullptr) {
+                    sessions = sessions * 10 + v.header->session_id;
+                    keys += v.header->key;
+                }
+            }, 16);
+            check("views carry the header of commit() and exclusive publish",
+                  hpr.delivered == 2 && sessions == 89 && keys == 16);
+
+            // Fragmented messages carry the header on every piece.
+            static uint8_t hlarge[2 * aether::SLOT_DATA_SIZE + 10];
+            memset(hlarge, 'h', sizeof(hlarge));
+            aether::publish(hr, aether::MessageMeta{.session_id = 1, .type_id = 2, .key = 99}, hlarge,
+                            sizeof(hlarge));
+            aether::FragmentAssembler hassembler;
+            uint64_t hkey = 0;
+            aether::poll(hr, hseq, hassembler, [&](const aether::MessageView& v) {
+                if (v.header != nullptr && v.payload.size() == sizeof(hlarge)) hkey = v.header->key;
+            }, 16);
+            check("a reassembled message carries its header", hkey == 99);
+
+            aether::RingView<8, aether::SLOT_DATA_SIZE> hview;  // matches all but the headers
+            check("ring views refuse a ring with headers", !aether::attach_view(hr, hview));
+
+            aether::shm_detach(hr);
+        }
+        aether::shm_destroy(HEADER_SHM_NAME);
+    }
+
+    // ------------------------------------------------------------------
+    // 25. Packed publication
+    // ------------------------------------------------------------------
+    {
+        check("an 8-byte record takes 12 bytes", aether::packed_record_size(8) == 12);
+        check("a 64-byte slot holds one record of up to 44 bytes", aether::packed_max_record(64) == 44);
+
+        // 64-byte slots: the PackedSlotHeader and four 8-byte records fill one.
+        shm_unlink(PACKED_SHM_NAME);
+        aether::SegmentOptions small;
+        small.slot_size = 64;
+        aether::RingHeader* pr = aether::shm_create(PACKED_SHM_NAME, 8, aether::OverflowPolicy::Overwrite,
+                                                    small);
+        check("packed ring shm_create returns non-null", pr != nullptr);
+        if (pr != nullptr) {
+            aether::PackedPublication pub = aether::packed_publication(pr, std::chrono::hours(1));
+            uint64_t pseq = pr->write_seq.load();
+            uint64_t values[3] = {11, 22, 33};
+            for (uint64_t& v : values) {
+                aether::pack(pub, &v, sizeof(v));
+            }
+            const aether::PollResult open = aether::poll(pr, pseq, [](const aether::MessageView&) {}, 16);
+            check("an open packed slot is not visible", open.delivered == 0 && pub.claim.slot != nullptr);
+
+            aether::flush(pub);
+            uint32_t views = 0;
+            uint32_t view_flags = 0;
+            uint64_t sum = 0;
+            uint32_t count = 0;
+            uint64_t first_record = 0;
+            aether::poll(pr, pseq, [&](const aether::MessageView& v) {
+                ++views;
+                view_flags = v.flags;
+                const aether::PackedRecords records = aether::packed_records(v.payload);
+                first_record = records.header.first_record;
+                for (std::span<const uint8_t> record : records) {
+                    uint64_t value;
+                    memcpy(&value, record.data(), sizeof(value));
+                    sum = sum * 100 + value;
+                    count += record.size() == sizeof(value) ? 1 : 0;
+                }
+            }, 16);
+            check("flush commits one slot flagged PACKED",
+                  views == 1 && view_flags == aether::SLOT_FLAG_PACKED && pub.claim.slot == nullptr);
+            check("its records iterate in order", count == 3 && sum == 112233);
+            check("records are numbered from 1", first_record == 1);
+
+            // The fourth 8-byte record fills the slot: committed without a flush.
+            const uint64_t before_fill = pr->write_seq.load();
+            for (uint64_t i = 0; i < 4; ++i) {
+                aether::pack(pub, &i, sizeof(i));
+            }
+            check("a full slot is committed without flush()",
+                  pub.claim.slot == nullptr && pr->write_seq.load() == before_fill + 1);
+
+            // A record that does not fit what is left starts a new slot.
+            uint8_t big[44] = {};
+            aether::pack(pub, &values[0], sizeof(values[0]));
+            check("a record that does not fit the open slot commits it first",
+                  aether::pack(pub, big, sizeof(big)) == aether::PublishResult::Ok &&
+                  pr->write_seq.load() == before_fill + 3 && pub.claim.slot == nullptr);
+            check("a record longer than a slot holds is TooLarge",
+                  aether::pack(pub, big, sizeof(big) + 1) == aether::PublishResult::TooLarge);
+
+            // Through a PackedReader every record is one view, plain messages too.
+            aether::publish(pr, msg, msg_len);
+            aether::PackedReader reader{};
+            uint32_t record_views = 0;
+            uint32_t plain_views  = 0;
+            uint32_t any_flags    = 0;
+            const aether::PollResult rr = aether::poll(pr, pseq, reader, [&](const aether::MessageView& v) {
+                ++record_views;
+                plain_views += v.payload.size() == msg_len ? 1 : 0;
+                any_flags |= v.flags;
+            }, 16);
+            check("a PackedReader delivers one view per record",
+                  rr.delivered == 4 + 1 + 1 + 1 && record_views == 7 && plain_views == 1 && rr.lost == 0);
+            check("record views carry flags 0", any_flags == 0);
+            check("the reader expects the record after the last one",
+                  reader.next_record == 1 + 3 + 4 + 1 + 1);
+
+            // Ten full slots on an 8-slot ring: two slots — eight records — lapped.
+            for (uint64_t i = 0; i < 40; ++i) {
+                aether::pack(pub, &i, sizeof(i));
+            }
+            uint64_t next_value = 0;
+            bool in_order = true;
+            const aether::PollResult lr = aether::poll(pr, pseq, reader, [&](const aether::MessageView& v) {
+                uint64_t value;
+                memcpy(&value, v.payload.data(), sizeof(value));
+                in_order = in_order && (next_value == 0 || value == next_value);
+                next_value = value + 1;
+            }, 16);
+            check("loss is counted in records", lr.lapped == 1 && lr.delivered == 32 && lr.lost == 8 &&
+                                                reader.lost_records == 8);
+            check("the records after the lap arrive in order", in_order && next_value == 40);
+
+            // Linger: only a slot open at least that long is flushed.
+            aether::pack(pub, &values[0], sizeof(values[0]));
+            check("flush_lingering leaves a fresh slot open",
+                  !aether::flush_lingering(pub) && pub.claim.slot != nullptr);
+            aether::flush(pub);
+            aether::PackedPublication eager = aether::packed_publication(pr, std::chrono::nanoseconds(0));
+            check("flush_lingering with nothing open does nothing", !aether::flush_lingering(eager));
+            aether::pack(eager, &values[1], sizeof(values[1]));
+            check("flush_lingering commits a slot past its linger time",
+                  aether::flush_lingering(eager) && eager.claim.slot == nullptr);
+
+            // The inline copies pack the same way.
+            aether::hot::pack(eager, &values[2], sizeof(values[2]));
+            aether::hot::flush(eager);
+            uint64_t last_value = 0;
+            const aether::PollResult hr = aether::hot::poll(pr, pseq, reader, [&](const aether::MessageView& v) {
+                memcpy(&last_value, v.payload.data(), sizeof(last_value));
+            }, 16);
+            check("hot::pack / hot::flush / hot::poll round-trip",
+                  hr.delivered == 3 && hr.lost == 0 && last_value == 33);
+
+            aether::ExclusivePublication pexcl{};
+            aether::acquire_exclusive(pr, pexcl);
+            check("packing into an exclusively held ring is Unavailable",
+                  aether::pack(eager, &values[0], sizeof(values[0])) == aether::PublishResult::Unavailable);
+            aether::release_exclusive(pexcl);
+
+            aether::shm_detach(pr);
+        }
+        aether::shm_destroy(PACKED_SHM_NAME);
+
+        // A length prefix running past the payload ends the walk.
+        uint8_t bogus[sizeof(aether::PackedSlotHeader) + 12] = {};
+        const uint32_t ok_len = 4;
+        const uint32_t bad_len = 1000;
+        memcpy(bogus + sizeof(aether::PackedSlotHeader), &ok_len, sizeof(ok_len));
+        memcpy(bogus + sizeof(aether::PackedSlotHeader) + 8, &bad_len, sizeof(bad_len));
+        uint32_t walked = 0;
+        for (std::span<const uint8_t> record : aether::packed_records(bogus)) {
+            walked += record.size() == ok_len ? 1 : 100;
+        }
+        check("the record walk stops at a length past the payload", walked == 1);
+        check("a payload too short for the header has no records",
+              aether::packed_records(std::span<const uint8_t>(bogus, 8)).begin() ==
+                  aether::packed_records(std::span<const uint8_t>(bogus, 8)).end());
+    }
+
+    // ------------------------------------------------------------------
+    // 26. Multiplexed rings
+    // ------------------------------------------------------------------
+    {
+        check("a topic id round-trips through the slot flags",
+              aether::slot_topic_id(aether::slot_topic_flags(0xBEEF) | aether::SLOT_FLAG_END) == 0xBEEF &&
+              ((aether::slot_topic_flags(0xBEEF) & aether::SLOT_FLAG_MASK) == 0));
+
+        shm_unlink(MULTIPLEX_SHM_NAME);
+        aether::SegmentOptions small;
+        small.slot_size = 64;
+        aether::RingHeader* mr = aether::shm_create(MULTIPLEX_SHM_NAME, 8, aether::OverflowPolicy::Overwrite,
+                                                    small);
+        check("multiplexed ring shm_create returns non-null", mr != nullptr);
+        if (mr != nullptr) {
+            aether::MessageMeta a{};
+            a.topic_id = 1;
+            aether::MessageMeta b{};
+            b.topic_id = 2;
+            const uint64_t start = mr->write_seq.load();
+
+            // Every publish path tags the slot.
+            aether::publish(mr, a, "a1", 2);
+            aether::publish(mr, b, "b1", 2);
+            const aether::PublishVec burst[2] = {{"a2", 2}, {"a3", 2}};
+            aether::publish_batch(mr, a, burst);
+            aether::Claim mc;
+            aether::try_claim(mr, 2, mc);
+            memcpy(mc.buffer.data(), "b2", 2);
+            aether::commit(mc, 2, b);
+            aether::ExclusivePublication mexcl{};
+            aether::acquire_exclusive(mr, mexcl);
+            aether::publish(mexcl, a, "a4", 2);
+            aether::release_exclusive(mexcl);
+
+            uint64_t aseq = start;
+            uint32_t a_views = 0;
+            bool only_a = true;
+            const aether::PollResult ar = aether::poll(mr, aseq, a.topic_id, [&](const aether::MessageView& v) {
+                ++a_views;
+                only_a = only_a && v.payload[0] == 'a' && aether::slot_topic_id(v.flags) == 1;
+            }, 16);
+            check("a filtered poll delivers only its topic",
+                  ar.delivered == 4 && a_views == 4 && only_a && ar.lost == 0);
+            check("it moves read_seq past the other topics' slots", aseq == mr->write_seq.load());
+
+            uint64_t bseq = start;
+            bool only_b = true;
+            const aether::PollResult br = aether::hot::poll(mr, bseq, b.topic_id, [&](const aether::MessageView& v) {
+                only_b = only_b && v.payload[0] == 'b';
+            }, 16);
+            check("hot::poll filters the same way", br.delivered == 2 && only_b);
+
+            uint64_t allseq = start;
+            check("an unfiltered poll delivers every topic",
+                  aether::poll(mr, allseq, [](const aether::MessageView&) {}, 16).delivered == 6);
+
+            // A fragmented message carries its topic in every piece.
+            uint8_t long_msg[100];
+            memset(long_msg, 'b', sizeof(long_msg));
+            const uint64_t frag_start = mr->write_seq.load();
+            aether::publish(mr, b, long_msg, sizeof(long_msg));
+            aether::publish(mr, a, "a5", 2);
+            aether::FragmentAssembler massembler;
+            uint64_t fseq = frag_start;
+            uint32_t whole_len = 0;
+            const aether::PollResult fr = aether::poll(mr, fseq, b.topic_id, massembler,
+                [&](const aether::MessageView& v) { whole_len = static_cast<uint32_t>(v.payload.size()); }, 16);
+            check("a filtered assembler poll reassembles its topic's messages",
+                  fr.delivered == 1 && whole_len == sizeof(long_msg) && fseq == mr->write_seq.load());
+            fseq = frag_start;
+            uint32_t small_views = 0;
+            aether::poll(mr, fseq, a.topic_id, massembler,
+                [&](const aether::MessageView& v) { small_views += v.payload.size() == 2 ? 1 : 0; }, 16);
+            check("and steps over other topics' pieces", small_views == 1);
+
+            // A ring full of other topics' slots ends the call, not the budget.
+            uint64_t idle_seq = mr->write_seq.load();
+            for (int i = 0; i < 8; ++i) {
+                aether::publish(mr, a, "a6", 2);
+            }
+            const aether::PollResult ir = aether::poll(mr, idle_seq, b.topic_id, [](const aether::MessageView&) {}, 1);
+            check("a ring of other topics is stepped over in one call",
+                  ir.delivered == 0 && ir.lapped == 0 && idle_seq == mr->write_seq.load());
+
+            // Laps are detected while stepping over other topics, as on any ring.
+            uint64_t lap_seq = mr->write_seq.load();
+            for (int i = 0; i < 20; ++i) {
+                aether::publish(mr, a, "a7", 2);
+            }
+            const aether::PollResult lr = aether::poll(mr, lap_seq, b.topic_id, [](const aether::MessageView&) {}, 16);
+            check("a filtered poll that was lapped counts the loss",
+                  lr.lapped == 1 && lr.lost == 12 && lr.delivered == 0);
+
+            aether::shm_detach(mr);
+        }
+        aether::shm_destroy(MULTIPLEX_SHM_NAME);
+    }
+
+    // ------------------------------------------------------------------
+    // 27. Arena
+    // ------------------------------------------------------------------
+    {
+        shm_unlink(ARENA_SHM_NAME);
+        errno = 0;
+        check("an arena too small for its directory is EINVAL",
+              aether::shm_create_arena(ARENA_SHM_NAME, 4096) == nullptr && errno == EINVAL);
+
+        aether::ArenaHeader* arena = aether::shm_create_arena(ARENA_SHM_NAME, 1u << 20);
+        check("shm_create_arena returns non-null", arena != nullptr);
+        if (arena != nullptr) {
+            check("a new arena is empty and starts past its directory",
+                  arena->ring_count.load() == 0 && arena->size == (1u << 20) &&
+                  arena->used >= sizeof(aether::ArenaHeader) && arena->used % arena->page_size == 0);
+
+            aether::SegmentOptions small;
+            small.slot_size = 64;
+            aether::RingHeader* ra = aether::arena_create_ring(arena, "a", 1, 8,
+                                                               aether::OverflowPolicy::Overwrite, small);
+            aether::RingHeader* rb = aether::arena_create_ring(arena, "b", 1, 16,
+                                                               aether::OverflowPolicy::Overwrite, small);
+            check("arena_create_ring carves two rings", ra != nullptr && rb != nullptr && ra != rb);
+            if (ra != nullptr && rb != nullptr) {
+                const uint64_t offset_a = static_cast<uint64_t>(reinterpret_cast<uint8_t*>(ra) -
+                                                                reinterpret_cast<uint8_t*>(arena));
+                check("rings start on a page boundary",
+                      offset_a % arena->page_size == 0 &&
+                      (reinterpret_cast<uint8_t*>(rb) - reinterpret_cast<uint8_t*>(arena)) % arena->page_size == 0);
+                check("an arena ring is an ordinary ring",
+                      ra->magic == aether::RING_MAGIC && ra->capacity == 8 && ra->slot_size == 64 &&
+                      ra->write_seq.load() == 1 && rb->capacity == 16);
+                check("the directory finds rings by name and by offset",
+                      aether::arena_find_ring(arena, "a", 1) == ra && aether::arena_find_ring(arena, "b", 1) == rb &&
+                      aether::arena_find_ring(arena, "c", 1) == nullptr &&
+                      aether::arena_ring(arena, offset_a) == ra && aether::arena_ring(arena, offset_a + 64) == nullptr);
+
+                aether::publish(ra, "in a", 4);
+                aether::publish(rb, "in b", 4);
+
+                errno = 0;
+                check("a second ring of the same name is EEXIST",
+                      aether::arena_create_ring(arena, "a", 1, 8) == nullptr && errno == EEXIST);
+                errno = 0;
+                check("a bad geometry is EINVAL",
+                      aether::arena_create_ring(arena, "c", 1, 24) == nullptr && errno == EINVAL);
+                errno = 0;
+                check("a ring larger than what is left is ENOSPC",
+                      aether::arena_create_ring(arena, "c", 1, 1024) == nullptr && errno == ENOSPC);
+
+                // Another mapping sees the rings and their messages.
+                aether::ArenaHeader* attached = aether::shm_attach_arena(ARENA_SHM_NAME);
+                check("shm_attach_arena returns non-null", attached != nullptr);
+                if (attached != nullptr) {
+                    aether::RingHeader* other = aether::arena_find_ring(attached, "b", 1);
+                    char abuf[64];
+                    uint32_t abuf_len = sizeof(abuf);
+                    uint64_t aseq = 1;
+                    check("a ring found through another mapping holds its messages",
+                          other != nullptr &&
+                          aether::consume(other, abuf, abuf_len, aseq) == aether::ConsumeResult::Ok &&
+                          abuf_len == 4 && memcmp(abuf, "in b", 4) == 0);
+                    aether::shm_detach(attached);
+                }
+                check("an arena is not a ring", aether::shm_attach(ARENA_SHM_NAME) == nullptr);
+            }
+            aether::shm_detach(arena);
+        }
+        aether::shm_destroy(ARENA_SHM_NAME);
+        check("a destroyed arena cannot be attached", aether::shm_attach_arena(ARENA_SHM_NAME) == nullptr);
+    }
+
+    // ------------------------------------------------------------------
+    // 28. Ring migration
+    // ------------------------------------------------------------------
+    {
+        shm_unlink(MIGRATE_SHM_NAME);
+        shm_unlink(SUCCESSOR_SHM_NAME);
+        shm_unlink(SMALLER_SHM_NAME);
+        aether::SegmentOptions small;
+        small.slot_size = 64;
+        aether::RingHeader* old = aether::shm_create(MIGRATE_SHM_NAME, 4,
+                                                     aether::OverflowPolicy::BackPressure, small);
+        aether::RingHeader* next = aether::shm_create(SUCCESSOR_SHM_NAME, 16,
+                                                      aether::OverflowPolicy::BackPressure, small);
+        check("migration rings created", old != nullptr && next != nullptr);
+        if (old != nullptr && next != nullptr) {
+            aether::SubscriberCursor* cursor = aether::attach_cursor(old, 1);
+            const ptrdiff_t cursor_index = cursor - old->cursors;
+            for (uint32_t i = 0; i < 3; ++i) {
+                aether::publish(old, &i, sizeof(i));
+            }
+
+            aether::RingHeader* smaller = aether::shm_create(SMALLER_SHM_NAME, 2,
+                                                             aether::OverflowPolicy::BackPressure, small);
+            errno = 0;
+            check("a smaller successor is EINVAL",
+                  !aether::shm_supersede(old, smaller, SMALLER_SHM_NAME) && errno == EINVAL);
+            aether::shm_detach(smaller);
+            aether::shm_destroy(SMALLER_SHM_NAME);
+
+            aether::ExclusivePublication xpub;
+            aether::acquire_exclusive(old, xpub);
+            errno = 0;
+            check("a ring held by an ExclusivePublication is EBUSY",
+                  !aether::shm_supersede(old, next, SUCCESSOR_SHM_NAME) && errno == EBUSY &&
+                  !aether::ring_sealed(old));
+            aether::release_exclusive(xpub);
+
+            check("shm_supersede succeeds", aether::shm_supersede(old, next, SUCCESSOR_SHM_NAME));
+            check("the old ring forwards to its successor",
+                  old->successor_seq.load() == 4 && strcmp(old->successor_name, SUCCESSOR_SHM_NAME) == 0 &&
+                  old->successor_offset == 0 && aether::ring_head(old) == 4);
+            check("the successor continues the sequence",
+                  next->write_seq.load() == 4 && next->epoch == 1 && next->capacity == 16);
+            check("the successor has a copy of the cursor",
+                  next->cursors[cursor_index].pid.load() == static_cast<uint32_t>(getpid()) &&
+                  next->cursors[cursor_index].read_seq.load() == 1);
+
+            const uint32_t late = 99;
+            check("publish to a sealed ring is Superseded",
+                  aether::publish(old, &late, sizeof(late)) == aether::PublishResult::Superseded);
+            aether::Claim mclaim;
+            check("try_claim on a sealed ring is Superseded",
+                  aether::try_claim(old, sizeof(late), mclaim) == aether::PublishResult::Superseded);
+            check("acquire_exclusive fails on a sealed ring", !aether::acquire_exclusive(old, xpub));
+            errno = 0;
+            check("a sealed ring cannot be superseded again",
+                  !aether::shm_supersede(old, next, SUCCESSOR_SHM_NAME) && errno == EINVAL);
+
+            // Drain the old ring, then carry on in the successor from the
+            // same sequence: nothing lost, nothing twice.
+            uint64_t mseq = 1;
+            uint32_t got[5] = {};
+            uint32_t count = 0;
+            uint32_t value = 0;
+            uint32_t value_len = sizeof(value);
+            while (aether::consume(old, &value, value_len, mseq) == aether::ConsumeResult::Ok) {
+                got[count++] = value;
+                value_len = sizeof(value);
+            }
+            check("a drained sealed ring reports Superseded",
+                  aether::consume(old, &value, value_len, mseq) == aether::ConsumeResult::Superseded &&
+                  aether::ring_drained(old, mseq) && count == 3 && mseq == 4);
+            check("poll on a drained sealed ring sets superseded",
+                  aether::poll(old, mseq, [](const aether::MessageView&) {}, 8).superseded);
+
+            cursor = aether::move_cursor(next, old, cursor);
+            aether::update_cursor(cursor, mseq);
+            check("move_cursor takes the copied entry",
+                  cursor == &next->cursors[cursor_index] && cursor->read_seq.load() == 4);
+            for (uint32_t i = 3; i < 5; ++i) {
+                aether::publish(next, &i, sizeof(i));
+            }
+            value_len = sizeof(value);
+            while (aether::consume(next, &value, value_len, mseq) == aether::ConsumeResult::Ok) {
+                got[count++] = value;
+                value_len = sizeof(value);
+            }
+            check("messages continue in order in the successor",
+                  count == 5 && got[0] == 0 && got[1] == 1 && got[2] == 2 && got[3] == 3 && got[4] == 4);
+            aether::detach_cursor(cursor);
+        }
+        if (old != nullptr) aether::shm_detach(old);
+        if (next != nullptr) aether::shm_detach(next);
+        aether::shm_destroy(MIGRATE_SHM_NAME);
+        aether::shm_destroy(SUCCESSOR_SHM_NAME);
+
+        // A seal whose forwarding pointer never comes, or names nothing:
+        // migrate() gives up and leaves the subscription where it was.
+        shm_unlink(STRANDED_SHM_NAME);
+        aether::RingHeader* stranded = aether::shm_create(STRANDED_SHM_NAME, 4,
+                                                          aether::OverflowPolicy::Overwrite, small);
+        check("stranded ring created", stranded != nullptr);
+        if (stranded != nullptr) {
+            stranded->write_seq.fetch_or(aether::RING_SEALED);
+            aether::Subscription stuck{stranded, 0, 0, 0};
+            const auto wait_start = steady_clock::now();
+            check("migrate gives up on a seal with no successor",
+                  !aether::migrate(stuck) && stuck.hdr == stranded &&
+                  steady_clock::now() - wait_start < std::chrono::seconds(5));
+
+            strcpy(stranded->successor_name, "/aether-test-ring-migrate-missing");
+            stranded->successor_seq.store(1);
+            check("migrate to a successor that cannot be mapped fails",
+                  !aether::migrate(stuck) && stuck.hdr == stranded);
+            aether::shm_detach(stranded);
+        }
+        aether::shm_destroy(STRANDED_SHM_NAME);
+
+        // migrate(sub, cursor) on a segment of its own: the cursor is read
+        // out of the old mapping before migrate() unmaps it.
+        shm_unlink(CURSOR_SHM_NAME);
+        shm_unlink(CURSOR_NEXT_SHM_NAME);
+        aether::RingHeader* bp_old = aether::shm_create(CURSOR_SHM_NAME, 4,
+                                                        aether::OverflowPolicy::BackPressure, small);
+        aether::RingHeader* bp_next = aether::shm_create(CURSOR_NEXT_SHM_NAME, 16,
+                                                         aether::OverflowPolicy::BackPressure, small);
+        check("cursor migration rings created", bp_old != nullptr && bp_next != nullptr);
+        if (bp_old != nullptr && bp_next != nullptr) {
+            aether::SubscriberCursor* bp_cursor = aether::attach_cursor(bp_old, 1);
+            const ptrdiff_t bp_index = bp_cursor - bp_old->cursors;
+            for (uint32_t i = 0; i < 2; ++i) {
+                aether::publish(bp_old, &i, sizeof(i));
+            }
+            aether::update_cursor(bp_cursor, 3);
+            check("cursor ring superseded", aether::shm_supersede(bp_old, bp_next, CURSOR_NEXT_SHM_NAME));
+            aether::shm_detach(bp_next);  // migrate() maps its own
+
+            aether::Subscription bp_sub{bp_old, aether::segment_mapped_size(aether::shm_segment_size(bp_old),
+                                                                            bp_old->page_size), 0, 0};
+            check("migrate(sub, cursor) moves a standalone ring's cursor",
+                  aether::migrate(bp_sub, bp_cursor) && bp_sub.hdr != bp_old &&
+                  bp_cursor == &bp_sub.hdr->cursors[bp_index] && bp_cursor->read_seq.load() == 3);
+            aether::detach_cursor(bp_cursor);
+            aether::unsubscribe(bp_sub);
+        }
+        aether::shm_destroy(CURSOR_SHM_NAME);
+        aether::shm_destroy(CURSOR_NEXT_SHM_NAME);
+    }
+
     // ------------------------------------------------------------------
     // Cleanup
     // ------------------------------------------------------------------
@@ -5,7 +5,9 @@
 #include "aether/subscribe.h"
 #include "aether/publish.h"
 #include "aether/consume.h"
+#include "aether/shm.h"
 
+#include <sys/mman.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -117,3 +119,123 @@ TEST_CASE_FIXTURE(DaemonFixture, "stress: N concurrent publishers, 1 subscriber,
         waitpid(child, nullptr, 0);
     }
 }
+
+// ---------------------------------------------------------------------------
+// Wrap stress: many publishers lapping each other on a small ring
+//
+// Each publisher writes 10x the ring's capacity, so slots are reused while
+// other publishers are still writing them. The subscriber reads concurrently
+// and checks every delivered payload: the body is filled with a byte derived
+// from (publisher_id, msg_seq), so two producers writing one slot show up as
+// a mixed body. Lapping is expected; torn payloads and reordering are not.
+// ---------------------------------------------------------------------------
+
+constexpr const char* WRAP_SHM_NAME      = "/aether-test-stress-wrap";
+constexpr uint32_t    WRAP_CAPACITY      = 64;
+constexpr int         WRAP_PUBLISHERS    = 8;
+constexpr uint32_t    WRAP_MSGS_EACH     = 10 * WRAP_CAPACITY;
+constexpr uint32_t    WRAP_BODY_SIZE     = 256;
+
+struct WrapMsg {
+    uint32_t publisher_id;
+    uint32_t msg_seq;
+    uint8_t  body[WRAP_BODY_SIZE];
+};
+
+static uint8_t wrap_fill(uint32_t publisher_id, uint32_t msg_seq) {
+    return static_cast<uint8_t>(publisher_id * 31 + msg_seq);
+}
+
+TEST_CASE("stress: 8 publishers wrap the ring 10x, no torn payloads") {
+    shm_unlink(WRAP_SHM_NAME);
+    aether::RingHeader* hdr = aether::shm_create(WRAP_SHM_NAME, WRAP_CAPACITY);
+    REQUIRE(hdr != nullptr);
+
+    int done_pipe[2];
+    REQUIRE(pipe(done_pipe) == 0);
+
+    std::array<pid_t, WRAP_PUBLISHERS> children{};
+    for (int p = 0; p < WRAP_PUBLISHERS; ++p) {
+        pid_t child = fork();
+        REQUIRE(child >= 0);
+
+        if (child == 0) {
+            close(done_pipe[0]);
+
+            aether::RingHeader* pub = aether::shm_attach(WRAP_SHM_NAME);
+            if (pub == nullptr) _exit(1);
+            WrapMsg msg{};
+            msg.publisher_id = static_cast<uint32_t>(p);
+            for (uint32_t seq = 0; seq < WRAP_MSGS_EACH; ++seq) {
+                msg.msg_seq = seq;
+                memset(msg.body, wrap_fill(msg.publisher_id, seq), sizeof(msg.body));
+                aether::publish(pub, &msg, sizeof(msg));
+            }
+            aether::shm_detach(pub);
+
+            char done = 1;
+            write(done_pipe[1], &done, 1);
+            close(done_pipe[1]);
+            _exit(0);
+        }
+
+        children[p] = child;
+    }
+    close(done_pipe[1]);
+    fcntl(done_pipe[0], F_SETFL, fcntl(done_pipe[0], F_GETFL, 0) | O_NONBLOCK);
+
+    std::array<uint32_t, WRAP_PUBLISHERS> last_seq{};
+    last_seq.fill(UINT32_MAX);
+
+    uint64_t read_seq  = 1;
+    uint64_t received  = 0;
+    uint64_t lapped    = 0;
+    uint64_t torn      = 0;
+    uint64_t reordered = 0;
+    int      finished  = 0;
+
+    // Drain while publishers run, then once more after the last one is done.
+    while (true) {
+        WrapMsg buf{};
+        uint32_t buf_len = sizeof(buf);
+        const auto result = aether::consume(hdr, &buf, buf_len, read_seq);
+
+        if (result == aether::ConsumeResult::Ok) {
+            ++received;
+            REQUIRE(buf_len == sizeof(WrapMsg));
+            REQUIRE(buf.publisher_id < static_cast<uint32_t>(WRAP_PUBLISHERS));
+
+            const uint8_t fill = wrap_fill(buf.publisher_id, buf.msg_seq);
+            for (uint8_t b : buf.body) {
+                if (b != fill) { ++torn; break; }
+            }
+            // Laps may drop messages, never reorder one publisher's stream.
+            uint32_t& last = last_seq[buf.publisher_id];
+            if (last != UINT32_MAX && buf.msg_seq <= last) ++reordered;
+            last = buf.msg_seq;
+        } else if (result == aether::ConsumeResult::Lapped) {
+            ++lapped;
+        } else if (finished == WRAP_PUBLISHERS) {
+            break;
+        } else {
+            char done = 0;
+            if (read(done_pipe[0], &done, 1) == 1) ++finished;
+        }
+    }
+    close(done_pipe[0]);
+
+    MESSAGE("received " << received << " of " << WRAP_PUBLISHERS * WRAP_MSGS_EACH
+            << ", lapped " << lapped);
+    CHECK(torn == 0);
+    CHECK(reordered == 0);
+    CHECK(received > 0);
+
+    for (pid_t child : children) {
+        int status = 0;
+        waitpid(child, &status, 0);
+        CHECK((WIFEXITED(status) && WEXITSTATUS(status) == 0));
+    }
+
+    aether::shm_detach(hdr);
+    aether::shm_destroy(WRAP_SHM_NAME);
+}
@@ -4,11 +4,14 @@
 #include "aether/remote_publisher.h"
 #include "aether/remote_subscriber.h"
 #include "aether/ring.h"
+#include "aether/publish.h"
+#include "aether/subscribe.h"
 
 #include <csignal>
 #include <cstring>
 #include <sys/wait.h>
 #include <thread>
+#include <vector>
 #include <unistd.h>
 
 // ---------------------------------------------------------------------------
@@ -88,6 +91,137 @@ TEST_CASE("tcp sub receives multiple messages") {
     stop_daemon();
 }
 
+TEST_CASE("tcp publisher interleaving topics keeps each topic in order") {
+    start_daemon();
+
+    auto sub_a = aether::remote_subscriber("127.0.0.1", "left", 4);
+    auto sub_b = aether::remote_subscriber("127.0.0.1", "right", 5);
+    usleep(50'000);
+
+    // Runs of one topic are batched by the daemon; alternating topics
+    // exercises the run boundaries.
+    auto pub = aether::remote_publisher("127.0.0.1");
+    for (int i = 0; i < 20; ++i) {
+        char msg[32];
+        int len = snprintf(msg, sizeof(msg), "msg-%d", i);
+        if (i % 3 == 0) {
+            REQUIRE(aether::remote_publish(pub, "right", 5, msg, len));
+        } else {
+            REQUIRE(aether::remote_publish(pub, "left", 4, msg, len));
+        }
+    }
+    aether::remote_disconnect(pub);
+
+    for (int i = 0; i < 20; ++i) {
+        char expected[32];
+        int exp_len = snprintf(expected, sizeof(expected), "msg-%d", i);
+
+        char buf[aether::SLOT_DATA_SIZE];
+        int n = aether::remote_consume(i % 3 == 0 ? sub_b : sub_a, buf, sizeof(buf), 2000);
+
+        CHECK(n == exp_len);
+        CHECK(memcmp(buf, expected, exp_len) == 0);
+    }
+
+    aether::remote_disconnect(sub_a);
+    aether::remote_disconnect(sub_b);
+    stop_daemon();
+}
+
+TEST_CASE("tcp subscriber follows a resized topic") {
+    start_daemon();
+
+    auto sub = aether::remote_subscriber("127.0.0.1", "grow", 4);
+    usleep(50'000);
+
+    // Half the messages land in the first ring, half in the last; the
+    // forwarder walks the chain of rings in between.
+    auto pub = aether::remote_publisher("127.0.0.1");
+    for (int i = 0; i < 10; ++i) {
+        if (i == 5) {
+            usleep(100'000);  // let the daemon publish the first half
+            REQUIRE(aether::resize_topic("grow", 4, 2048) == aether::ControlStatus::Ok);
+            REQUIRE(aether::resize_topic("grow", 4, 4096) == aether::ControlStatus::Ok);
+        }
+        char msg[32];
+        int len = snprintf(msg, sizeof(msg), "msg-%d", i);
+        REQUIRE(aether::remote_publish(pub, "grow", 4, msg, len));
+    }
+    aether::remote_disconnect(pub);
+
+    for (int i = 0; i < 10; ++i) {
+        char expected[32];
+        int exp_len = snprintf(expected, sizeof(expected), "msg-%d", i);
+
+        char buf[aether::SLOT_DATA_SIZE];
+        int n = aether::remote_consume(sub, buf, sizeof(buf), 2000);
+
+        CHECK(n == exp_len);
+        CHECK(memcmp(buf, expected, exp_len) == 0);
+    }
+
+    aether::remote_disconnect(sub);
+    stop_daemon();
+}
+
+TEST_CASE("tcp message longer than a slot and a frame arrives whole") {
+    start_daemon();
+
+    auto sub = aether::remote_subscriber("127.0.0.1", "large", 5);
+    usleep(50'000);
+
+    // Fragmented on the wire by remote_publish(), across slots by the
+    // daemon's publish(), and forwarded piece by piece.
+    std::vector<uint8_t> msg(3 * aether::WIRE_MAX_FRAGMENT + 123);
+    for (size_t i = 0; i < msg.size(); ++i) msg[i] = static_cast<uint8_t>(i * 31);
+
+    auto pub = aether::remote_publisher("127.0.0.1");
+    REQUIRE(aether::remote_publish(pub, "large", 5, msg.data(), static_cast<uint32_t>(msg.size())));
+    const char* tail = "after";
+    REQUIRE(aether::remote_publish(pub, "large", 5, tail, strlen(tail)));
+    aether::remote_disconnect(pub);
+
+    std::vector<uint8_t> buf(msg.size());
+    int n = aether::remote_consume(sub, buf.data(), static_cast<uint32_t>(buf.size()), 2000);
+    CHECK(n == static_cast<int>(msg.size()));
+    CHECK(buf == msg);
+
+    n = aether::remote_consume(sub, buf.data(), static_cast<uint32_t>(buf.size()), 2000);
+    CHECK(n == static_cast<int>(strlen(tail)));
+    CHECK(memcmp(buf.data(), tail, strlen(tail)) == 0);
+
+    aether::remote_disconnect(sub);
+    stop_daemon();
+}
+
+TEST_CASE("tcp packed records arrive as separate messages") {
+    start_daemon();
+
+    auto sub = aether::remote_subscriber("127.0.0.1", "packed", 6);
+    usleep(50'000);
+
+    // Packed locally into the daemon's ring, unpacked by the forwarder.
+    aether::Subscription local = aether::subscribe("packed", 6);
+    REQUIRE(local.hdr != nullptr);
+    aether::PackedPublication pub = aether::packed_publication(local.hdr, std::chrono::milliseconds(1));
+    const char* records[] = {"one", "two", "three"};
+    for (const char* r : records) {
+        REQUIRE(aether::pack(pub, r, strlen(r)) == aether::PublishResult::Ok);
+    }
+    aether::flush(pub);
+
+    char buf[aether::SLOT_DATA_SIZE];
+    for (const char* r : records) {
+        const int n = aether::remote_consume(sub, buf, sizeof(buf), 2000);
+        CHECK(n == static_cast<int>(strlen(r)));
+        CHECK(memcmp(buf, r, strlen(r)) == 0);
+    }
+
+    aether::unsubscribe(local);
+    aether::remote_disconnect(sub);
+    stop_daemon();
+}
+
 TEST_CASE("tcp remote_consume times out when no messages") {
     start_daemon();
 